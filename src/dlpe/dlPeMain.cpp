@@ -245,7 +245,7 @@ bool dlPeMain::LoadImports(ObjFile* file)
 bool dlPeMain::ReadSections(const std::string& path)
 {
     ObjIeeeIndexManager iml;
-    factory = std::make_unique<ObjFactory>(&iml);
+    factory = std::make_unique<ObjFactory>(&iml, true);
     ObjIeee ieee("");
     FILE* in = fopen(path.c_str(), "rb");
     if (!in)
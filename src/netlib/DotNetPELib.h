@@ -1563,6 +1563,9 @@ namespace DotNetPELib
         void AddExternalAssembly(const std::string& assemblyName, Byte *publicKeyToken = nullptr);
         ///** Load data out of an assembly
         int LoadAssembly(const std::string& assemblyName, int major = 0, int minor = 0, int build = 0, int revision = 0);
+        ///** Set a directory where decoded metadata of referenced assemblies is cached
+        // between runs.   An empty string (the default) disables the cache
+        void MetadataCache(const std::string& directory) { metadataCache_ = directory; }
         ///* Load data out of an unmanaged DLL
         int LoadUnmanaged(const std::string& dllName);
         ///** Load an object file
@@ -1623,6 +1626,8 @@ namespace DotNetPELib
         std::iostream &Out() const { return *outputStream_; }
         void Swap(std::unique_ptr<std::iostream>& stream) { outputStream_.swap(stream); }
         PEWriter &PEOut() const { return *peWriter_; }
+        // how many bytes merging duplicate strings and blobs kept out of the last PE file
+        size_t HeapBytesSaved() const { return heapBytesSaved_; }
         std::map<size_t, size_t> moduleRefs;
         void PushContainer(DataContainer *container) { containerStack_.push_back(container); }
         DataContainer *GetContainer() { if (containerStack_.size()) return containerStack_.back(); else return nullptr; }
@@ -1645,9 +1650,11 @@ namespace DotNetPELib
     	std::map<std::string, std::string> unmanagedRoutines_;
         int corFlags_;
         PEWriter *peWriter_;
+        size_t heapBytesSaved_;
         std::vector<Namespace *> usingList_;
         std::deque<DataContainer *> containerStack_;
         CodeContainer *codeContainer_;
+        std::string metadataCache_;
         const char *objInputBuf_;
         int objInputSize_;
         int objInputPos_;
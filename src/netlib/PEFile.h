@@ -25,6 +25,8 @@
 #include <vector>
 #include <string>
 #include <set>
+#include <memory>
+#include <unordered_map>
 #include "RSAEncoder.h"
 #include "sha1.h"
 // this is an internal header used to define the various aspects of a PE file
@@ -316,7 +318,7 @@ namespace DotNetPELib {
             systemIndex_(0), entryPoint_(0), paramAttributeType_(0), paramAttributeData_(0),
             fileAlign_(0x200), objectAlign_(0x2000), imageBase_(0x400000), language_(0x4b0),
             peHeader_(nullptr), peObjects_(nullptr), cor20Header_(nullptr), tablesHeader_(nullptr),
-            snkFile_(snkFile), snkLen_(0), outputFile_(nullptr), peBase_(0), corBase_(0), snkBase_(0) { }
+            snkFile_(snkFile), snkLen_(0), outputFile_(nullptr), peBase_(0), corBase_(0), snkBase_(0), heapBytesSaved_(0) { }
         virtual ~PEWriter();
         // add an entry to one of the tables
         // note the data for the table will be a class inherited from TableEntryBase,
@@ -332,6 +334,8 @@ namespace DotNetPELib {
         // this is the 'cildata' contents.   Again we emit into the cildata and it returns the offset in
         // the cildata to use.  It does NOT return the rva immediately, that is calculated later
         size_t RVABytes(Byte *bytes, size_t data);
+        // how much smaller the metadata streams are because duplicates were merged
+        size_t HeapBytesSaved() const { return heapBytesSaved_; }
 
         // Set the indexes of the various classes which can be extended to make new classes
         // these are typically in the typeref table
@@ -407,17 +411,31 @@ namespace DotNetPELib {
     private:
         std::iostream *outputFile_;
         std::string snkFile_;
-        // a reflection of the String stream so that we can keep from doing duplicates.
-        // right now we don't check duplicates on any of the other streams...
-        std::map<std::string, size_t> stringMap_;
-        struct pool
+        // reflections of the String, US and Blob streams so that we can keep from doing duplicates.
+        std::unordered_map<std::string, size_t> stringMap_;
+        std::unordered_map<std::string, size_t> usMap_;
+        std::unordered_map<std::string, size_t> blobMap_;
+        // number of bytes that didn't go in the streams because they were duplicates
+        size_t heapBytesSaved_;
+        // the streams are built in chunks which double in size as the stream grows, so that
+        // adding to a stream never has to copy what is already there
+        class pool
         {
-            pool() : size(0), maxSize(200), base(nullptr) { base = (Byte *)calloc(1, maxSize); }
-            ~pool() { free(base); }
+        public:
+            pool() : size(0), chunkSize(256) { }
             size_t size;
-            size_t maxSize;
-            Byte *base;
-            void Ensure(size_t newSize);
+            void Append(const void *data, size_t len);
+            void Append(Byte data) { Append(&data, 1); }
+            void Put(std::iostream &out) const;
+        private:
+            struct chunk
+            {
+                std::unique_ptr<Byte[]> data;
+                size_t used;
+                size_t max;
+            };
+            std::vector<chunk> chunks;
+            size_t chunkSize;
         };
         DNLTable tables_[MaxTables];
         size_t entryPoint_;
@@ -472,7 +490,10 @@ namespace DotNetPELib {
         static const int ERR_INVALID_ASSEMBLY = 3;
         static const int ERR_UNKNOWN_TABLE = 5;
 
-        PEReader() : inputFile_(nullptr), corRVA_(0), num_objects_(0), objects_(0), blobPos_(0), stringPos_(0), GUIDPos_(0), stringData_(nullptr), blobData_(nullptr) { }
+        // bump this whenever the layout of the metadata cache files changes
+        static const int CacheVersion = 1;
+
+        PEReader() : inputFile_(nullptr), corRVA_(0), num_objects_(0), objects_(0), blobPos_(0), stringPos_(0), GUIDPos_(0), stringData_(nullptr), blobData_(nullptr), GUIDData_(nullptr), cached_(false) { }
         virtual ~PEReader();
 
         int ManagedLoad(std::string assemblyName, int major, int minor, int build, int revision);
@@ -482,6 +503,8 @@ namespace DotNetPELib {
         size_t RVAToFileLocation(size_t rva);
         const DNLTable &Table(int i) const { return tables_[i]; }
         void LibPath(const std::string& libPath) { libPath_ = libPath;  }
+        void MetadataCache(const std::string& directory) { cacheDirectory_ = directory; }
+        bool Cached() const { return cached_; }
 
     protected:
         std::string SearchOnPath(const std::string& assemblyName);
@@ -492,6 +515,10 @@ namespace DotNetPELib {
         size_t Cor20Location(size_t PEHeader);
         void GetStream(size_t Cor20, const char *streamName, DWord pos[2]);
         int ReadTables(size_t Cor20);
+        int ParseTables(Byte* tableMem);
+        std::string CacheName(const std::string& key);
+        bool ReadCache(const std::string& key);
+        void WriteCache(const std::string& key, const std::string& fileName, bool inGAC);
 
     private:
         std::fstream *inputFile_;
@@ -501,11 +528,14 @@ namespace DotNetPELib {
         size_t stringPos_;
         Byte *stringData_;
         Byte *blobData_;
+        Byte *GUIDData_;
         size_t GUIDPos_;
         PEObject *objects_;
         DNLTable tables_[MaxTables];
         size_t sizes_[MaxTables + ExtraIndexes];
         std::string libPath_;
+        std::string cacheDirectory_;
+        bool cached_;
     };
     // this class is the base class for index rendering
     // it defines a tag type (which indicates which table the index belongs with) and an index value
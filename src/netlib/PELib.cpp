@@ -35,6 +35,7 @@ extern std::string DIR_SEP;
 PELib::PELib(const std::string& AssemblyName, int CoreFlags) :
     corFlags_(CoreFlags),
     peWriter_(nullptr),
+    heapBytesSaved_(0),
     inputStream_(nullptr),
     outputStream_(nullptr),
     codeContainer_(nullptr),
@@ -792,6 +793,7 @@ bool PELib::DumpPEFile(std::string file, bool isexe, bool isgui)
     bool rv = WorkingAssembly()->PEDump(*this);
     WorkingAssembly()->Compile(*this);
     peWriter_->WriteFile(*this, *outputStream_);
+    heapBytesSaved_ = peWriter_->HeapBytesSaved();
     delete peWriter_;
     return rv;
 }
@@ -811,6 +813,7 @@ int PELib::LoadAssembly(const std::string& assemblyName, int major, int minor, i
     if (assembly == nullptr || !assembly->IsLoaded())
     {
         PEReader r;
+        r.MetadataCache(metadataCache_);
         int n = r.ManagedLoad(assemblyName, major, minor, build, revision);
         if (!n)
         {
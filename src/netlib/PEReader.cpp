@@ -30,6 +30,8 @@
 #include "MZHeader.h"
 #include "PEHeader.h"
 #include "DLLExportReader.h"
+#include <sys/types.h>
+#include <sys/stat.h>
 #include <time.h>
 #include <stdio.h>
 namespace DotNetPELib
@@ -118,6 +120,7 @@ PEReader::~PEReader()
     delete[] objects_;
     delete[] stringData_;
     delete[] blobData_;
+    delete[] GUIDData_;
     for (int i = 0; i < MaxTables; i++)
     {
         for (int j = 0; j < tables_[i].size(); j++)
@@ -232,7 +235,22 @@ std::string PEReader::SearchForManagedFile(const std::string& assemblyName, int
 int PEReader::ManagedLoad(std::string assemblyName, int major, int minor, int build, int revision)
 
 {
+    // files found locally are cached by their path, GAC lookups by the name and version
+    // that was asked for so that a hit doesn't have to search the GAC again
+    std::string key;
     std::string t = SearchOnPath(assemblyName + ".dll");
+    if (t.size())
+    {
+        key = t;
+    }
+    else
+    {
+        char buf[256];
+        sprintf(buf, "|%d.%d.%d.%d", major, minor, build, revision);
+        key = assemblyName + buf;
+    }
+    if (cacheDirectory_.size() && ReadCache(key))
+        return 0;
     if (t.size())
         assemblyName = t;
     else
@@ -247,6 +265,8 @@ int PEReader::ManagedLoad(std::string assemblyName, int major, int minor, int bu
         if (!corRVA_)
             return ERR_NOT_ASSEMBLY;
         int rv = ReadTables(corRVA_);
+        if (!rv && cacheDirectory_.size())
+            WriteCache(key, assemblyName, !t.size());
         return rv;
     }
     else
@@ -354,7 +374,7 @@ void PEReader::GetStream(size_t Cor20, const char* streamName, DWord pos[2])
 }
 int PEReader::ReadFromString(Byte* buf, size_t len, size_t offset)
 {
-    if (!stringPos_)
+    if (!stringData_)
     {
         DWord pos[2];
         GetStream(corRVA_, "#Strings", pos);
@@ -372,7 +392,7 @@ int PEReader::ReadFromString(Byte* buf, size_t len, size_t offset)
 }
 int PEReader::ReadFromBlob(Byte* buf, size_t len, size_t offset)
 {
-    if (!blobPos_)
+    if (!blobData_)
     {
         DWord pos[2];
         GetStream(corRVA_, "#Blob", pos);
@@ -384,7 +404,6 @@ int PEReader::ReadFromBlob(Byte* buf, size_t len, size_t offset)
     }
     Byte sizearr[4];
     memcpy(sizearr, blobData_ + offset, 4);
-    get(sizearr, blobPos_ + offset, 4);
     int offs, size;
     if (sizearr[0] < 128)
     {
@@ -407,15 +426,17 @@ int PEReader::ReadFromBlob(Byte* buf, size_t len, size_t offset)
 }
 int PEReader::ReadFromGUID(Byte* buf, size_t len, size_t offset)
 {
-    if (!GUIDPos_)
+    if (!GUIDData_)
     {
         DWord pos[2];
         GetStream(corRVA_, "#GUID", pos);
         if (!pos[0])
             return 0;
         GUIDPos_ = RVAToFileLocation(pos[0]);
+        GUIDData_ = new Byte[pos[1]];
+        get(GUIDData_, GUIDPos_, pos[1]);
     }
-    get(buf, GUIDPos_ + offset - 1, len);
+    memcpy(buf, GUIDData_ + offset - 1, len);
     return 16;
 }
 int PEReader::ReadTables(size_t Cor20)
@@ -426,13 +447,6 @@ int PEReader::ReadTables(size_t Cor20)
         return ERR_INVALID_ASSEMBLY;
     Byte* tableMem = new Byte[pos[1]];
     get(tableMem, RVAToFileLocation(pos[0]), pos[1]);
-    DotNetMetaTablesHeader* mth = (DotNetMetaTablesHeader*)tableMem;
-    ulonglong tableFlags = mth->MaskValid;
-    if (tableFlags & ~tKnownTablesMask)
-    {
-        delete[] tableMem;
-        return ERR_UNKNOWN_TABLE;
-    }
     GetStream(Cor20, "#Strings", pos);
     sizes_[tString] = pos[1];
     GetStream(Cor20, "#US", pos);
@@ -441,6 +455,16 @@ int PEReader::ReadTables(size_t Cor20)
     sizes_[tGUID] = pos[1];
     GetStream(Cor20, "#Blob", pos);
     sizes_[tBlob] = pos[1];
+    int rv = ParseTables(tableMem);
+    delete[] tableMem;
+    return rv;
+}
+int PEReader::ParseTables(Byte* tableMem)
+{
+    DotNetMetaTablesHeader* mth = (DotNetMetaTablesHeader*)tableMem;
+    ulonglong tableFlags = mth->MaskValid;
+    if (tableFlags & ~tKnownTablesMask)
+        return ERR_UNKNOWN_TABLE;
     Byte* p = tableMem + sizeof(*mth);
     for (int i = 0; i < 64; i++)
     {
@@ -457,16 +481,236 @@ int PEReader::ReadTables(size_t Cor20)
         {
             TableEntryBase* newItem = TableEntryFactory::GetEntry(i);
             if (!newItem)
-            {
-                delete[] tableMem;
                 return ERR_UNKNOWN_TABLE;
-            }
             size_t n = newItem->Get(sizes_, p);
             p += n;
             tables_[i].push_back(newItem);
         }
     }
-    delete[] tableMem;
     return 0;
 }
+// a cache file holds the raw metadata streams of one assembly, so that later loads need neither
+// the GAC search nor the walk through the PE headers.   It is laid out as:
+//
+//     'OMDC' version key path size mtime gacdir gacmtime US-size tables strings blob guid
+//
+// where strings are a length followed by the characters, and the four streams are a length
+// followed by the data.   The cache is only used when the version and key match and the assembly
+// (and for GAC lookups the directory that holds its versions) hasn't changed since it was written
+static const char CacheSignature[4] = {'O', 'M', 'D', 'C'};
+
+static bool FileStamp(const std::string& name, longlong& size, longlong& mtime)
+{
+    struct stat st;
+    if (stat(name.c_str(), &st))
+        return false;
+    size = st.st_size;
+    mtime = st.st_mtime;
+    return true;
+}
+static std::string GACDirectory(const std::string& fileName)
+{
+    // GAC\assembly\version__token\assembly.dll
+    size_t npos = fileName.find_last_of(DIR_SEP);
+    if (npos != std::string::npos)
+        npos = fileName.find_last_of(DIR_SEP, npos - 1);
+    if (npos == std::string::npos)
+        return "";
+    return fileName.substr(0, npos);
+}
+class CacheReader
+{
+  public:
+    CacheReader(std::fstream& In) : in(In)
+    {
+        in.seekg(0, std::ios::end);
+        remaining = in.tellg();
+        in.seekg(0);
+    }
+    bool Get(void* buf, size_t len)
+    {
+        if (len > remaining)
+            return false;
+        in.read((char*)buf, len);
+        remaining -= len;
+        return !in.fail();
+    }
+    bool Get(DWord& val) { return Get(&val, sizeof(val)); }
+    bool Get(longlong& val) { return Get(&val, sizeof(val)); }
+    bool Get(std::string& val)
+    {
+        DWord len;
+        if (!Get(len) || len > remaining)
+            return false;
+        val.resize(len);
+        return Get(&val[0], len);
+    }
+    Byte* GetStream(DWord& len)
+    {
+        if (!Get(len) || len > remaining)
+            return nullptr;
+        Byte* rv = new Byte[len ? len : 1];
+        if (!Get(rv, len))
+        {
+            delete[] rv;
+            return nullptr;
+        }
+        return rv;
+    }
+
+  private:
+    std::fstream& in;
+    size_t remaining;
+};
+static void PutCache(std::fstream& out, const void* buf, size_t len) { out.write((const char*)buf, len); }
+static void PutCache(std::fstream& out, DWord val) { PutCache(out, &val, sizeof(val)); }
+static void PutCache(std::fstream& out, longlong val) { PutCache(out, &val, sizeof(val)); }
+static void PutCache(std::fstream& out, const std::string& val)
+{
+    PutCache(out, (DWord)val.size());
+    PutCache(out, val.c_str(), val.size());
+}
+
+std::string PEReader::CacheName(const std::string& key)
+{
+    // FNV-1a over the format version and the key
+    char buf[256];
+    sprintf(buf, "%d|", CacheVersion);
+    std::string hashed = buf + key;
+    ulonglong hash = 14695981039346656037ULL;
+    for (auto c : hashed)
+    {
+        hash ^= (Byte)c;
+        hash *= 1099511628211ULL;
+    }
+    sprintf(buf, "netlib-%08x%08x.mdc", (unsigned)(hash >> 32), (unsigned)hash);
+    return cacheDirectory_ + DIR_SEP + buf;
+}
+bool PEReader::ReadCache(const std::string& key)
+{
+    std::fstream in(CacheName(key).c_str(), std::ios::in | std::ios::binary);
+    if (!in.is_open())
+        return false;
+    CacheReader buf(in);
+    char signature[sizeof(CacheSignature)];
+    DWord version;
+    std::string cachedKey, fileName, gacDir;
+    longlong size, mtime, gacMtime, currentSize, currentMtime;
+    if (!buf.Get(signature, sizeof(signature)) || memcmp(signature, CacheSignature, sizeof(signature)))
+        return false;
+    if (!buf.Get(version) || version != CacheVersion)
+        return false;
+    if (!buf.Get(cachedKey) || cachedKey != key)
+        return false;
+    if (!buf.Get(fileName) || !buf.Get(size) || !buf.Get(mtime) || !buf.Get(gacDir) || !buf.Get(gacMtime))
+        return false;
+    if (!FileStamp(fileName, currentSize, currentMtime) || currentSize != size || currentMtime != mtime)
+        return false;
+    if (gacDir.size() && (!FileStamp(gacDir, currentSize, currentMtime) || currentMtime != gacMtime))
+        return false;
+    DWord usSize, tableSize, stringSize, blobSize, GUIDSize;
+    if (!buf.Get(usSize))
+        return false;
+    Byte* tableMem = buf.GetStream(tableSize);
+    if (!tableMem)
+        return false;
+    Byte* strings = buf.GetStream(stringSize);
+    Byte* blob = buf.GetStream(blobSize);
+    Byte* guid = buf.GetStream(GUIDSize);
+    if (!strings || !blob || !guid || tableSize < sizeof(DotNetMetaTablesHeader))
+    {
+        delete[] tableMem;
+        delete[] strings;
+        delete[] blob;
+        delete[] guid;
+        return false;
+    }
+    sizes_[tString] = stringSize;
+    sizes_[tUS] = usSize;
+    sizes_[tGUID] = GUIDSize;
+    sizes_[tBlob] = blobSize;
+    int rv = ParseTables(tableMem);
+    delete[] tableMem;
+    if (rv)
+    {
+        // something is badly wrong with the cache, throw away what was read and go to the assembly
+        for (int i = 0; i < MaxTables; i++)
+        {
+            for (auto p : tables_[i])
+                delete p;
+            tables_[i].clear();
+        }
+        delete[] strings;
+        delete[] blob;
+        delete[] guid;
+        return false;
+    }
+    stringData_ = strings;
+    blobData_ = blob;
+    GUIDData_ = guid;
+    cached_ = true;
+    return true;
+}
+void PEReader::WriteCache(const std::string& key, const std::string& fileName, bool inGAC)
+{
+    longlong size, mtime, gacSize, gacMtime = 0;
+    if (!FileStamp(fileName, size, mtime))
+        return;
+    std::string gacDir;
+    if (inGAC)
+    {
+        gacDir = GACDirectory(fileName);
+        if (gacDir.size() && !FileStamp(gacDir, gacSize, gacMtime))
+            return;
+    }
+    DWord pos[2];
+    GetStream(corRVA_, "#~", pos);
+    std::vector<Byte> tables(pos[1]);
+    get(tables.data(), RVAToFileLocation(pos[0]), pos[1]);
+    // make sure all of the heaps are in memory
+    Byte dummy[16];
+    ReadFromString(dummy, sizeof(dummy), 0);
+    ReadFromBlob(dummy, sizeof(dummy), 0);
+    ReadFromGUID(dummy, 0, 1);
+    if (!stringData_ || !blobData_ || !GUIDData_)
+        return;
+
+    // written under a temporary name then renamed, so that a compile running in parallel never
+    // sees half a file
+    std::string name = CacheName(key);
+    char buf[256];
+    sprintf(buf, ".%p%lx", (void*)this, (long)time(0));
+    std::string tempName = name + buf;
+    {
+        std::fstream out(tempName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return;
+        PutCache(out, CacheSignature, sizeof(CacheSignature));
+        PutCache(out, (DWord)CacheVersion);
+        PutCache(out, key);
+        PutCache(out, fileName);
+        PutCache(out, size);
+        PutCache(out, mtime);
+        PutCache(out, gacDir);
+        PutCache(out, gacMtime);
+        PutCache(out, (DWord)sizes_[tUS]);
+        PutCache(out, (DWord)tables.size());
+        PutCache(out, tables.data(), tables.size());
+        PutCache(out, (DWord)sizes_[tString]);
+        PutCache(out, stringData_, sizes_[tString]);
+        PutCache(out, (DWord)sizes_[tBlob]);
+        PutCache(out, blobData_, sizes_[tBlob]);
+        PutCache(out, (DWord)sizes_[tGUID]);
+        PutCache(out, GUIDData_, sizes_[tGUID]);
+        if (out.fail())
+        {
+            out.close();
+            remove(tempName.c_str());
+            return;
+        }
+    }
+    remove(name.c_str());
+    if (rename(tempName.c_str(), name.c_str()))
+        remove(tempName.c_str());
+}
 }  // namespace DotNetPELib
\ No newline at end of file
@@ -187,17 +187,35 @@ size_t PEMethod::Write(size_t sizes[MaxTables + ExtraIndexes], std::iostream& ou
     return n;
 }
 
-void PEWriter::pool::Ensure(size_t newSize)
+void PEWriter::pool::Append(const void* data, size_t len)
 {
-    if (size + newSize > maxSize)
+    const Byte* p = (const Byte*)data;
+    size += len;
+    while (len)
     {
-        if (size + newSize < maxSize * 2)
-            maxSize = maxSize * 2;
-        else
-            maxSize = (maxSize + newSize) * 2;
-        base = (Byte*)realloc(base, maxSize);
+        if (chunks.empty() || chunks.back().used == chunks.back().max)
+        {
+            chunks.push_back(chunk());
+            chunks.back().data.reset(new Byte[chunkSize]);
+            chunks.back().used = 0;
+            chunks.back().max = chunkSize;
+            chunkSize *= 2;
+        }
+        chunk& current = chunks.back();
+        size_t n = len;
+        if (n > current.max - current.used)
+            n = current.max - current.used;
+        memcpy(current.data.get() + current.used, p, n);
+        current.used += n;
+        p += n;
+        len -= n;
     }
 }
+void PEWriter::pool::Put(std::iostream& out) const
+{
+    for (auto&& c : chunks)
+        out.write((char*)c.data.get(), c.used);
+}
 PEWriter::~PEWriter()
 {
     delete peHeader_;
@@ -238,41 +256,46 @@ size_t PEWriter::HashString(const std::string& utf8)
 {
     auto it = stringMap_.find(utf8);
     if (it != stringMap_.end())
+    {
+        heapBytesSaved_ += utf8.size() + 1;
         return it->second;
+    }
     if (strings_.size == 0)
-        strings_.size++;
-    strings_.Ensure(utf8.size() + 1);
+        strings_.Append(0);
     size_t rv = strings_.size;
-    memcpy(strings_.base + strings_.size, utf8.c_str(), utf8.size() + 1);
-    strings_.size += utf8.size() + 1;
+    strings_.Append(utf8.c_str(), utf8.size() + 1);
     stringMap_[utf8] = rv;
     return rv;
 }
-size_t PEWriter::HashUS(std::wstring str)
+// the length prefix used by the US and Blob streams
+static void BlobLength(std::string& data, size_t blobLen)
 {
-    if (us_.size == 0)
-        us_.size++;
-    int flag = 0;
-    us_.Ensure(str.size() * 2 + 5);
-    size_t rv = us_.size;
-    int blobLen = str.size() * 2 + 1;
     if (blobLen < 0x80)
     {
-        us_.base[us_.size++] = blobLen;
+        data += (char)blobLen;
     }
     else if (blobLen <= 0x3fff)
     {
-        us_.base[us_.size++] = (blobLen >> 8) | 0x80;
-        us_.base[us_.size++] = blobLen;
+        data += (char)((blobLen >> 8) | 0x80);
+        data += (char)blobLen;
     }
     else
     {
         blobLen &= 0x1fffffff;
-        us_.base[us_.size++] = (blobLen >> 24) | 0xc0;
-        us_.base[us_.size++] = (blobLen >> 16);
-        us_.base[us_.size++] = (blobLen >> 8);
-        us_.base[us_.size++] = (blobLen >> 0);
+        data += (char)((blobLen >> 24) | 0xc0);
+        data += (char)(blobLen >> 16);
+        data += (char)(blobLen >> 8);
+        data += (char)(blobLen >> 0);
     }
+}
+size_t PEWriter::HashUS(std::wstring str)
+{
+    if (us_.size == 0)
+        us_.Append(0);
+    int flag = 0;
+    std::string data;
+    data.reserve(str.size() * 2 + 5);
+    BlobLength(data, str.size() * 2 + 1);
     for (int i = 0; i < str.size(); i++)
     {
         int n = str[i];
@@ -280,55 +303,52 @@ size_t PEWriter::HashUS(std::wstring str)
             flag = 1;
         else if (n <= 8 || (n >= 0x0e && n < 0x20) || n == 0x27 || n == 0x2d || n == 0x7f)
             flag = 1;
-        us_.base[us_.size++] = n & 0xff;
-        us_.base[us_.size++] = n >> 8;
+        data += (char)(n & 0xff);
+        data += (char)(n >> 8);
     }
-    us_.base[us_.size++] = flag;
+    data += (char)flag;
+    auto it = usMap_.find(data);
+    if (it != usMap_.end())
+    {
+        heapBytesSaved_ += data.size();
+        return it->second;
+    }
+    size_t rv = us_.size;
+    us_.Append(data.c_str(), data.size());
+    usMap_[data] = rv;
     return rv;
 }
 size_t PEWriter::HashGUID(Byte* Guid)
 {
-    guid_.Ensure(128 / 8);
     size_t rv = guid_.size;
-    memcpy(guid_.base + rv, Guid, 128 / 8);
-    guid_.size += 128 / 8;
+    guid_.Append(Guid, 128 / 8);
     return (rv / (128 / 8) + 1);
 }
 size_t PEWriter::HashBlob(Byte* blobData, size_t blobLen)
 {
     if (blob_.size == 0)
-        blob_.size++;
-    int xcount = 0;
-    blob_.Ensure(blobLen + 4);
-    size_t rv = blob_.size;
-    if (blobLen < 0x80)
-    {
-        blob_.base[blob_.size++] = blobLen;
-    }
-    else if (blobLen <= 0x3fff)
-    {
-        blob_.base[blob_.size++] = (blobLen >> 8) | 0x80;
-        blob_.base[blob_.size++] = blobLen;
-    }
-    else
-    {
+        blob_.Append(0);
+    std::string data;
+    data.reserve(blobLen + 4);
+    BlobLength(data, blobLen);
+    if (blobLen > 0x3fff)
         blobLen &= 0x1fffffff;
-        blob_.base[blob_.size++] = (blobLen >> 24) | 0xc0;
-        blob_.base[blob_.size++] = (blobLen >> 16);
-        blob_.base[blob_.size++] = (blobLen >> 8);
-        blob_.base[blob_.size++] = (blobLen >> 0);
+    data.append((char*)blobData, blobLen);
+    auto it = blobMap_.find(data);
+    if (it != blobMap_.end())
+    {
+        heapBytesSaved_ += data.size();
+        return it->second;
     }
-    memcpy(blob_.base + blob_.size, blobData, blobLen);
-    blob_.size += blobLen;
+    size_t rv = blob_.size;
+    blob_.Append(data.c_str(), data.size());
+    blobMap_[data] = rv;
     return rv;
 }
 size_t PEWriter::RVABytes(Byte* Bytes, size_t dataLen)
 {
-    int pos = rva_.size;
-    rva_.Ensure(dataLen + pos - rva_.size);
     size_t rv = rva_.size;
-    rva_.size += pos - rva_.size + dataLen;
-    memcpy(rva_.base + rv, Bytes, dataLen);
+    rva_.Append(Bytes, dataLen);
     return rv;
 }
 
@@ -882,7 +902,7 @@ bool PEWriter::WriteTables(PELib& peLib) const
 }
 bool PEWriter::WriteStrings(PELib& peLib) const
 {
-    put(strings_.base, strings_.size);
+    strings_.Put(*outputFile_);
     align(4);
     return true;
 }
@@ -894,20 +914,20 @@ bool PEWriter::WriteUS(PELib& peLib) const
     }
     else
     {
-        put(us_.base, us_.size);
+        us_.Put(*outputFile_);
     }
     align(4);
     return true;
 }
 bool PEWriter::WriteGUID(PELib& peLib) const
 {
-    put(guid_.base, guid_.size);
+    guid_.Put(*outputFile_);
     align(4);
     return true;
 }
 bool PEWriter::WriteBlob(PELib& peLib) const
 {
-    put(blob_.base, blob_.size);
+    blob_.Put(*outputFile_);
     align(4);
     return true;
 }
@@ -953,7 +973,7 @@ bool PEWriter::WriteStaticData(PELib& peLib) const
 {
     if (rva_.size)
     {
-        put(rva_.base, rva_.size);
+        rva_.Put(*outputFile_);
         align(8);
     }
     return true;
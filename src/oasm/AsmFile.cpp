@@ -1430,7 +1430,7 @@ bool AsmFile::Write(std::string& fileName, std::string& srcName)
 {
     bool rv = true;
     ObjIeeeIndexManager im;
-    ObjFactory f(&im);
+    ObjFactory f(&im, true);
     ObjFile* fi = MakeFile(f, srcName);
     if (fi)
     {
@@ -134,5 +134,10 @@ class InstructionParser
     void SetBracketSequence(bool open, int sz, int seg);
     void SetOperandTokens(amode* operand);
     void SetTokens(ocode* ins);
+    bool EncodingKey(ocode* ins, std::string& key);
+    bool OperandKey(amode* operand, std::string& key);
+
+    // encodings of instructions which need no fixups, keyed by opcode and operands
+    std::unordered_map<std::string, std::string> encodings;
 };
 #endif
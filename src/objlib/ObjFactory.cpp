@@ -28,9 +28,38 @@ void ObjFactory::Deallocate()
 {
     for (auto it = MemoryBegin(); it != MemoryEnd(); ++it)
     {
-        delete *it;
+        if (arena)
+            (*it)->~ObjWrapper();
+        else
+            delete *it;
     }
     allocated.clear();
+    arenaBlocks.clear();
+    arenaFree = nullptr;
+    arenaLeft = 0;
+}
+// hands out arena space.  Anything too big to share a block gets a block of its own, so the
+// space left in the current block isn't wasted
+void* ObjFactory::Allocate(size_t size, size_t align)
+{
+    static const size_t blockSize = 64 * 1024;
+    if (size > blockSize / 4)
+    {
+        arenaBlocks.push_back(std::unique_ptr<char[]>(new char[size]));
+        return arenaBlocks.back().get();
+    }
+    size_t pad = (align - (size_t)arenaFree % align) % align;
+    if (!arenaFree || pad + size > arenaLeft)
+    {
+        arenaBlocks.push_back(std::unique_ptr<char[]>(new char[blockSize]));
+        arenaFree = arenaBlocks.back().get();
+        arenaLeft = blockSize;
+        pad = 0;
+    }
+    void* rv = arenaFree + pad;
+    arenaFree += pad + size;
+    arenaLeft -= pad + size;
+    return rv;
 }
 void ObjFactory::Tag(ObjWrapper* obj)
 {
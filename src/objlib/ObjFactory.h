@@ -37,196 +37,216 @@
 #include "ObjSourceFile.h"
 #include "ObjSymbol.h"
 #include "ObjType.h"
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
 
 class ObjFactory
 {
     typedef std::vector<ObjWrapper*> MemoryContainer;
 
   public:
-    ObjFactory(ObjIndexManager* IndexManager) : indexManager(IndexManager) {}
+    // in arena mode objects are carved out of large blocks which are all released together,
+    // and the contents of data records are copied there too
+    ObjFactory(ObjIndexManager* IndexManager, bool Arena = false) :
+        indexManager(IndexManager), arena(Arena), arenaFree(nullptr), arenaLeft(0)
+    {
+    }
     ~ObjFactory() { Deallocate(); }
     ObjIndexManager* GetIndexManager() { return indexManager; }
     virtual ObjBrowseInfo* MakeBrowseInfo(ObjBrowseInfo::eType Type, ObjBrowseInfo::eQual Qual, ObjLineNo* Line, ObjInt CharPos,
                                           const ObjString& Data)
     {
-        ObjBrowseInfo* b = new ObjBrowseInfo(Type, Qual, Line, CharPos, Data);
+        ObjBrowseInfo* b = New<ObjBrowseInfo>(Type, Qual, Line, CharPos, Data);
         Tag(b);
         return b;
     }
     virtual ObjDebugTag* MakeDebugTag(ObjLineNo* LineNo)
     {
-        ObjDebugTag* d = new ObjDebugTag(LineNo);
+        ObjDebugTag* d = New<ObjDebugTag>(LineNo);
         Tag(d);
         return d;
     }
     virtual ObjDebugTag* MakeDebugTag(ObjSymbol* Symbol)
     {
-        ObjDebugTag* d = new ObjDebugTag(Symbol);
+        ObjDebugTag* d = New<ObjDebugTag>(Symbol);
         Tag(d);
         return d;
     }
     virtual ObjDebugTag* MakeDebugTag(ObjSection* Section, bool Start)
     {
-        ObjDebugTag* d = new ObjDebugTag(Section, Start);
+        ObjDebugTag* d = New<ObjDebugTag>(Section, Start);
         Tag(d);
         return d;
     }
     virtual ObjDebugTag* MakeDebugTag(ObjSymbol* Function, bool Start)
     {
-        ObjDebugTag* d = new ObjDebugTag(Function, Start);
+        ObjDebugTag* d = New<ObjDebugTag>(Function, Start);
         Tag(d);
         return d;
     }
     virtual ObjDebugTag* MakeDebugTag(bool Start)
     {
-        ObjDebugTag* d = new ObjDebugTag(Start);
+        ObjDebugTag* d = New<ObjDebugTag>(Start);
         Tag(d);
         return d;
     }
     virtual ObjExpression* MakeExpression(ObjExpression::eOperator Type)
     {
-        ObjExpression* e = new ObjExpression(Type);
+        ObjExpression* e = New<ObjExpression>(Type);
         Tag(e);
         return e;
     }
     virtual ObjExpression* MakeExpression(ObjInt Left)
     {
-        ObjExpression* e = new ObjExpression(Left);
+        ObjExpression* e = New<ObjExpression>(Left);
         Tag(e);
         return e;
     }
     virtual ObjExpression* MakeExpression(ObjExpression* Left)
     {
-        ObjExpression* e = new ObjExpression(Left);
+        ObjExpression* e = New<ObjExpression>(Left);
         Tag(e);
         return e;
     }
     virtual ObjExpression* MakeExpression(ObjSymbol* Left)
     {
-        ObjExpression* e = new ObjExpression(Left);
+        ObjExpression* e = New<ObjExpression>(Left);
         Tag(e);
         return e;
     }
     virtual ObjExpression* MakeExpression(ObjSection* Left)
     {
-        ObjExpression* e = new ObjExpression(Left);
+        ObjExpression* e = New<ObjExpression>(Left);
         Tag(e);
         return e;
     }
     virtual ObjExpression* MakeExpression(ObjExpression::eOperator op, ObjExpression* Left)
     {
-        ObjExpression* e = new ObjExpression(op, Left);
+        ObjExpression* e = New<ObjExpression>(op, Left);
         Tag(e);
         return e;
     }
     virtual ObjExpression* MakeExpression(ObjExpression::eOperator op, ObjExpression* Left, ObjExpression* Right)
     {
-        ObjExpression* e = new ObjExpression(op, Left, Right);
+        ObjExpression* e = New<ObjExpression>(op, Left, Right);
         Tag(e);
         return e;
     }
     virtual ObjFile* MakeFile(const ObjString& Name)
     {
-        ObjFile* f = new ObjFile(Name);
+        ObjFile* f = New<ObjFile>(Name);
         Tag(f);
         return f;
     }
     virtual ObjFunction* MakeFunction(const ObjString& Name, ObjType* ReturnType, int index = -1)
     {
-        ObjFunction* f = new ObjFunction(Name, ReturnType, index >= 0 ? index : indexManager->NextType());
+        ObjFunction* f = New<ObjFunction>(Name, ReturnType, index >= 0 ? index : indexManager->NextType());
         Tag(f);
         return f;
     }
     virtual ObjLineNo* MakeLineNo(ObjSourceFile* File, ObjInt LineNumber)
     {
-        ObjLineNo* l = new ObjLineNo(File, LineNumber);
+        ObjLineNo* l = New<ObjLineNo>(File, LineNumber);
         Tag(l);
         return l;
     }
     virtual ObjMemory* MakeData(ObjByte* Data, ObjInt Size)
     {
-        ObjMemory* m = new ObjMemory(Data, Size);
+        ObjMemory* m;
+        if (arena)
+        {
+            ObjByte* copy = (ObjByte*)Allocate(Size, 1);
+            memcpy(copy, Data, Size);
+            m = New<ObjMemory>(copy, Size, false);
+        }
+        else
+        {
+            m = New<ObjMemory>(Data, Size);
+        }
         Tag(m);
         return m;
     }
     virtual ObjMemory* MakeData(ObjInt Size, ObjByte fill)
     {
-        ObjMemory* m = new ObjMemory(Size, fill);
+        ObjMemory* m = New<ObjMemory>(Size, fill);
         Tag(m);
         return m;
     }
     virtual ObjMemory* MakeFixup(ObjExpression* Expression, ObjInt Size)
     {
-        ObjMemory* m = new ObjMemory(Expression, Size);
+        ObjMemory* m = New<ObjMemory>(Expression, Size);
         Tag(m);
         return m;
     }
     virtual ObjSection* MakeSection(const ObjString& Name, int index = -1)
     {
-        ObjSection* s = new ObjSection(Name, index >= 0 ? index : indexManager->NextSection());
+        ObjSection* s = New<ObjSection>(Name, index >= 0 ? index : indexManager->NextSection());
         Tag(s);
         return s;
     }
     virtual ObjSourceFile* MakeSourceFile(const ObjString& Name, int index = -1)
     {
-        ObjSourceFile* s = new ObjSourceFile(Name, index >= 0 ? index : indexManager->NextFile());
+        ObjSourceFile* s = New<ObjSourceFile>(Name, index >= 0 ? index : indexManager->NextFile());
         Tag(s);
         return s;
     }
     virtual ObjSymbol* MakePublicSymbol(const ObjString& Name, int index = -1)
     {
-        ObjSymbol* p = new ObjSymbol(Name, ObjSymbol::ePublic, index >= 0 ? index : indexManager->NextPublic());
+        ObjSymbol* p = New<ObjSymbol>(Name, ObjSymbol::ePublic, index >= 0 ? index : indexManager->NextPublic());
         p->SetSectionRelative(true);
         Tag(p);
         return p;
     }
     virtual ObjSymbol* MakeExternalSymbol(const ObjString& Name, int index = -1)
     {
-        ObjSymbol* p = new ObjSymbol(Name, ObjSymbol::eExternal, index >= 0 ? index : indexManager->NextExternal());
+        ObjSymbol* p = New<ObjSymbol>(Name, ObjSymbol::eExternal, index >= 0 ? index : indexManager->NextExternal());
         Tag(p);
         return p;
     }
     virtual ObjSymbol* MakeLocalSymbol(const ObjString& Name, int index = -1)
     {
-        ObjSymbol* p = new ObjSymbol(Name, ObjSymbol::eLocal, index >= 0 ? index : indexManager->NextLocal());
+        ObjSymbol* p = New<ObjSymbol>(Name, ObjSymbol::eLocal, index >= 0 ? index : indexManager->NextLocal());
         p->SetSectionRelative(true);
         Tag(p);
         return p;
     }
     virtual ObjSymbol* MakeAutoSymbol(const ObjString& Name, int index = -1)
     {
-        ObjSymbol* p = new ObjSymbol(Name, ObjSymbol::eAuto, index >= 0 ? index : indexManager->NextAuto());
+        ObjSymbol* p = New<ObjSymbol>(Name, ObjSymbol::eAuto, index >= 0 ? index : indexManager->NextAuto());
         Tag(p);
         return p;
     }
     virtual ObjSymbol* MakeRegSymbol(const ObjString& Name, int index = -1)
     {
-        ObjSymbol* p = new ObjSymbol(Name, ObjSymbol::eReg, index >= 0 ? index : indexManager->NextReg());
+        ObjSymbol* p = New<ObjSymbol>(Name, ObjSymbol::eReg, index >= 0 ? index : indexManager->NextReg());
         Tag(p);
         return p;
     }
     virtual ObjSymbol* MakeLabelSymbol(const ObjString& Name)
     {
-        ObjSymbol* p = new ObjSymbol(Name, ObjSymbol::eLabel, 0);
+        ObjSymbol* p = New<ObjSymbol>(Name, ObjSymbol::eLabel, 0);
         p->SetSectionRelative(true);
         Tag(p);
         return p;
     }
     virtual ObjImportSymbol* MakeImportSymbol(const ObjString Name)
     {
-        ObjImportSymbol* p = new ObjImportSymbol(Name);
+        ObjImportSymbol* p = New<ObjImportSymbol>(Name);
         Tag(p);
         return p;
     }
     virtual ObjExportSymbol* MakeExportSymbol(const ObjString Name)
     {
-        ObjExportSymbol* p = new ObjExportSymbol(Name);
+        ObjExportSymbol* p = New<ObjExportSymbol>(Name);
         Tag(p);
         return p;
     }
     virtual ObjDefinitionSymbol* MakeDefinitionSymbol(const ObjString& Name)
     {
-        ObjDefinitionSymbol* p = new ObjDefinitionSymbol(Name);
+        ObjDefinitionSymbol* p = New<ObjDefinitionSymbol>(Name);
         Tag(p);
         return p;
     }
@@ -234,9 +254,9 @@ class ObjFactory
     {
         ObjType* t;
         if (Index == -1 && Type < ObjType::eVoid)
-            t = new ObjType(Type, indexManager->NextType());
+            t = New<ObjType>(Type, indexManager->NextType());
         else
-            t = new ObjType(Type, Index);
+            t = New<ObjType>(Type, Index);
         Tag(t);
         return t;
     }
@@ -244,9 +264,9 @@ class ObjFactory
     {
         ObjType* t;
         if (Index == -1 && Type < ObjType::eVoid)
-            t = new ObjType(Type, Base, indexManager->NextType());
+            t = New<ObjType>(Type, Base, indexManager->NextType());
         else
-            t = new ObjType(Type, Base, Index);
+            t = New<ObjType>(Type, Base, Index);
         Tag(t);
         return t;
     }
@@ -254,15 +274,15 @@ class ObjFactory
     {
         ObjType* t;
         if (Index == -1 && Type < ObjType::eVoid)
-            t = new ObjType(Name, Type, Base, indexManager->NextType());
+            t = New<ObjType>(Name, Type, Base, indexManager->NextType());
         else
-            t = new ObjType(Name, Type, Base, Index);
+            t = New<ObjType>(Name, Type, Base, Index);
         Tag(t);
         return t;
     }
     virtual ObjField* MakeField(const ObjString& Name, ObjType* Base, ObjInt ConstVal, ObjInt index)
     {
-        ObjField* f = new ObjField(Name, Base, ConstVal, index);
+        ObjField* f = New<ObjField>(Name, Base, ConstVal, index);
         Tag(f);
         return f;
     }
@@ -275,9 +295,21 @@ class ObjFactory
   protected:
     virtual void Deallocate();
     virtual void Tag(ObjWrapper* obj);
+    void* Allocate(size_t size, size_t align);
+    template <class T, class... Args>
+    T* New(Args&&... args)
+    {
+        if (arena)
+            return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        return new T(std::forward<Args>(args)...);
+    }
 
   private:
     ObjIndexManager* indexManager;
     MemoryContainer allocated;
+    bool arena;
+    std::vector<std::unique_ptr<char[]>> arenaBlocks;
+    char* arenaFree;
+    size_t arenaLeft;
 };
 #endif
\ No newline at end of file
@@ -31,6 +31,7 @@
 #include <cctype>
 #include <cstdio>
 #include <algorithm>
+#include <mutex>
 ObjIeeeAscii::ParseData ObjIeeeAscii::parseData[] = {
     ObjIeeeAscii::ParseData("LD", &ObjIeeeAscii::Data),
     ObjIeeeAscii::ParseData("LR", &ObjIeeeAscii::Fixup),
@@ -222,15 +223,16 @@ ObjExpression* ObjIeeeAscii::GetExpression(const char* buffer, int* pos)
 }
 bool ObjIeeeAscii::Parse(const char* buffer, eParseType ParseType)
 {
-    if (parseTree.empty())
-    {
+    // libraries are read on several threads at once, so the table is built exactly once
+    static std::once_flag parseTreeOnce;
+    std::call_once(parseTreeOnce, []() {
         ParseData* parser = &parseData[0];
         for (int i = 0; i < sizeof(parseData) / sizeof(parseData[0]); i++)
         {
             parseTree[parser->GetName()] = parser;
             parser++;
         }
-    }
+    });
     auto it = parseTree.find(buffer);
     if (it != parseTree.end())
     {
@@ -1002,6 +1004,19 @@ bool ObjIeeeAscii::Comment(const char* buffer, eParseType ParseType)
             currentTags->push_back(tag);
             break;
         }
+        case eTypeSignature: {
+            int pos = 0;
+            int index = ObjUtil::FromHex(data, &pos);
+            if (data[pos++] != ',')
+                ThrowSyntax(buffer, ParseType);
+            unsigned long long signature = (unsigned)ObjUtil::FromHex(data, &pos, 8);
+            signature = (signature << 32) + (unsigned)ObjUtil::FromHex(data, &pos, 8);
+            ObjType* type = GetType(index);
+            if (!type)
+                ThrowSyntax(buffer, ParseType);
+            type->SetSignature(signature);
+            break;
+        }
         case eFunctionStart:
         case eFunctionEnd:
             int pos = 0;
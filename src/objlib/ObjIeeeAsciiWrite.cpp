@@ -219,6 +219,12 @@ void ObjIeeeAscii::RenderType(ObjType* Type)
         RenderString("," + ToString(Type->GetName()) + ".");
         endl();
     }
+    if (Type->GetSignature())
+    {
+        ObjString data = ObjUtil::ToHex(Type->GetIndex()) + "," + ObjUtil::ToHex((ObjInt)(Type->GetSignature() >> 32), 8) +
+                         ObjUtil::ToHex((ObjInt)Type->GetSignature(), 8);
+        RenderComment(eTypeSignature, data);
+    }
 }
 void ObjIeeeAscii::RenderSymbol(ObjSymbol* Symbol)
 {
@@ -912,6 +912,16 @@ bool ObjIeeeBinary::Comment(const ObjByte* buffer, eParseType ParseType)
             ParseString(buffer, &pos);
             break;
         }
+        case eTypeSignature: {
+            int index = GetIndex(buffer, &pos);
+            unsigned long long signature = GetDWord(buffer, &pos);
+            signature = (signature << 32) + GetDWord(buffer, &pos);
+            ObjType* type = GetType(index);
+            if (!type)
+                ThrowSyntax(buffer, ParseType);
+            type->SetSignature(signature);
+            break;
+        }
         case eFunctionStart:
         case eFunctionEnd:
             int ch = GetByte(buffer, &pos);
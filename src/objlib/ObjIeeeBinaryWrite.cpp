@@ -324,6 +324,11 @@ void ObjIeeeBinary::RenderType(ObjType* Type)
     {
         RenderMessage(ecNAME, embed('T'), EINDEX, Type->GetIndex(), ESTRING, Type->GetName().c_str(), nullptr);
     }
+    if (Type->GetSignature())
+    {
+        RenderComment(eTypeSignature, EINDEX, Type->GetIndex(), EDWORD, (int)(Type->GetSignature() >> 32), EDWORD,
+                      (int)Type->GetSignature(), nullptr);
+    }
 }
 void ObjIeeeBinary::RenderSymbol(ObjSymbol* Symbol)
 {
@@ -16,6 +16,7 @@ enum eCommentType
     eBlockEnd = 403,
     eFunctionStart = 404,
     eFunctionEnd = 405,
+    eTypeSignature = 406,
     eBrowseInfo = 500
 };
 static const int IeeeBinarySig = 0x4549534c;  // LSIE
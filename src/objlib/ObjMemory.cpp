@@ -32,8 +32,16 @@
 ObjMemory::~ObjMemory() {}
 void ObjMemory::SetData(ObjByte* Data, ObjInt Size)
 {
-    data = std::make_unique<ObjByte[]>(Size);
-    memcpy(data.get(), Data, Size);
+    ownData = std::make_unique<ObjByte[]>(Size);
+    memcpy(ownData.get(), Data, Size);
+    data = ownData.get();
+    size = Size;
+    fixup = nullptr;
+}
+void ObjMemory::ShareData(ObjByte* Data, ObjInt Size)
+{
+    ownData = nullptr;
+    data = Data;
     size = Size;
     fixup = nullptr;
 }
@@ -41,10 +49,8 @@ void ObjMemory::SetData(ObjExpression* Data, ObjInt Size)
 {
     fixup = Data;
     size = Size;
-    if (data)
-    {
-        data = nullptr;
-    }
+    data = nullptr;
+    ownData = nullptr;
 }
 void ObjMemoryManager::ResolveSymbols(ObjFactory* Factory, ObjSection* Section)
 {
@@ -38,7 +38,14 @@ class ObjFactory;
 class ObjMemory : public ObjWrapper
 {
   public:
-    ObjMemory(ObjByte* Data, ObjInt Size) : fixup(nullptr), fill(0), enumerated(false), debugTags(nullptr) { SetData(Data, Size); }
+    // without Copy the data is used where it is, and has to live as long as this does
+    ObjMemory(ObjByte* Data, ObjInt Size, bool Copy = true) : fixup(nullptr), fill(0), enumerated(false), debugTags(nullptr)
+    {
+        if (Copy)
+            SetData(Data, Size);
+        else
+            ShareData(Data, Size);
+    }
     ObjMemory(ObjExpression* Expression, ObjInt Size) :
         data(nullptr), fill(0), enumerated(false), debugTags(nullptr), fixup(Expression), size(Size)
     {
@@ -52,10 +59,11 @@ class ObjMemory : public ObjWrapper
     ObjInt GetSize() { return size; }
     ObjByte GetFill() { return fill; }
     bool IsEnumerated() { return enumerated; }
-    ObjByte* GetData() { return data.get(); }
+    ObjByte* GetData() { return data; }
     ObjExpression* GetFixup() { return fixup; }
     void SetFixup(ObjExpression* f) { fixup = f; }
     void SetData(ObjByte* Data, ObjInt Size);
+    void ShareData(ObjByte* Data, ObjInt Size);
     void SetData(ObjExpression* Data, ObjInt Size);
     bool HasDebugTags() { return debugTags != nullptr; }
 
@@ -82,7 +90,8 @@ class ObjMemory : public ObjWrapper
 
   private:
     ObjInt size;
-    std::unique_ptr<ObjByte[]> data;
+    ObjByte* data;
+    std::unique_ptr<ObjByte[]> ownData;
     ObjByte fill;
     ObjExpression* fixup;
     bool enumerated;
@@ -68,7 +68,8 @@ class ObjType : public ObjWrapper
         indexType(&defaultIndexType),
         size(0),
         startBit(0),
-        bitCount(0)
+        bitCount(0),
+        signature(0)
     {
     }
     ObjType(eType Type, ObjType* BaseType, ObjInt Index) :
@@ -82,7 +83,8 @@ class ObjType : public ObjWrapper
         indexType(&defaultIndexType),
         size(0),
         startBit(0),
-        bitCount(0)
+        bitCount(0),
+        signature(0)
     {
     }
     ObjType(const ObjString& Name, eType Type, ObjType* BaseType, ObjInt Index) :
@@ -96,7 +98,8 @@ class ObjType : public ObjWrapper
         indexType(&defaultIndexType),
         size(0),
         startBit(0),
-        bitCount(0)
+        bitCount(0),
+        signature(0)
     {
     }
     virtual ~ObjType() {}
@@ -127,6 +130,10 @@ class ObjType : public ObjWrapper
     int GetStartBit() { return startBit; }
     void SetBitCount(int bc) { bitCount = bc; }
     int GetBitCount() { return bitCount; }
+    // a hash of the structure of the type which is the same in every object file the type
+    // appears in, the linker merges types with it.   zero means the type doesn't have one
+    unsigned long long GetSignature() { return signature; }
+    void SetSignature(unsigned long long Signature) { signature = Signature; }
 
     ObjInt GetFieldSize() { return fields.size(); }
     typedef FieldContainer::iterator FieldIterator;
@@ -147,6 +154,7 @@ class ObjType : public ObjWrapper
     int size;
     int startBit;
     int bitCount;
+    unsigned long long signature;
     FieldContainer fields;
     static ObjType defaultIndexType;
 };
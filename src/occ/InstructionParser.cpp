@@ -270,15 +270,29 @@ asmError InstructionParser::GetInstruction(OCODE* ins, Instruction*& newIns, std
 
                     break;
             }
+            std::string key;
+            bool cacheable = EncodingKey(ins, key);
+            if (cacheable)
+            {
+                auto it = encodings.find(key);
+                if (it != encodings.end())
+                {
+                    newIns = new Instruction((unsigned char*)it->second.c_str(), it->second.size());
+                    return AERR_NONE;
+                }
+            }
             SetTokens(ins);
             bits.Reset();
             asmError rv = DispatchOpcode(ins->opcode);
             if (rv == AERR_NONE)
             {
                 unsigned char buf[64];
-                bits.GetBytes(buf, (bits.GetBits() + 7) / 8);
-                newIns = new Instruction(buf, (bits.GetBits() + 7) / 8);
+                int len = (bits.GetBits() + 7) / 8;
+                bits.GetBytes(buf, len);
+                newIns = new Instruction(buf, len);
                 operands = this->operands;
+                if (cacheable)
+                    encodings[key] = std::string((char*)buf, len);
             }
             return rv;
         }
@@ -645,4 +659,47 @@ void InstructionParser::SetTokens(ocode* ins)
         SetOperandTokens(ins->oper3);
     }
 }
+// an instruction whose operands are all registers or resolved constants assembles to the
+// same bytes every time, so its encoding can be reused without going through the tokenizer
+bool InstructionParser::OperandKey(amode* operand, std::string& key)
+{
+    int n = 0;
+    bool zero = true;
+    switch (operand->mode)
+    {
+        case am_indisp:
+        case am_indispscale:
+        case am_direct:
+        case am_immed: {
+            int resolved = 1;
+            n = resolveoffset(operand->offset, &resolved);
+            if (!resolved)
+                return false;
+            // whether the offset is written out at all changes the token stream for indirect modes
+            zero = !operand->offset || ((operand->offset->type == Optimizer::se_ui || operand->offset->type == Optimizer::se_i) &&
+                                        operand->offset->i == 0);
+            break;
+        }
+        default:
+            break;
+    }
+    char buf[64];
+    sprintf(buf, "%d,%d,%d,%d,%d,%d,%d,%d;", operand->mode, operand->preg, operand->sreg, operand->scale, operand->length,
+            operand->seg, zero, n);
+    key += buf;
+    return true;
+}
+bool InstructionParser::EncodingKey(ocode* ins, std::string& key)
+{
+    char buf[32];
+    sprintf(buf, "%d:", ins->opcode);
+    key = buf;
+    if (ins->oper1 && !OperandKey(ins->oper1, key))
+        return false;
+    if (ins->oper2 && !OperandKey(ins->oper2, key))
+        return false;
+    if (ins->oper3 && !OperandKey(ins->oper3, key))
+        return false;
+    return true;
+}
 Instruction* InstructionParser::Parse(const std::string& args, int PC) { return nullptr; }
\ No newline at end of file
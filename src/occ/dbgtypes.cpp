@@ -31,6 +31,7 @@
 #include "dbgtypes.h"
 #include "ObjFactory.h"
 #include "ObjType.h"
+#include "ObjFunction.h"
 #include "ObjFile.h"
 #include "OptUtils.h"
 #include "memory.h"
@@ -38,6 +39,42 @@
 namespace occx86
 {
 
+/* the type signatures are FNV-1a hashes of what gets written for a type, with the
+ * types it is built from folded in by signature instead of by their object file index
+ * so that the same type has the same signature in every object file
+ */
+static unsigned long long HashInt(unsigned long long hash, int n)
+{
+    for (int i = 0; i < 4; i++, n >>= 8)
+    {
+        hash ^= n & 0xff;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+static unsigned long long HashString(unsigned long long hash, const char* str)
+{
+    do
+    {
+        hash ^= (unsigned char)*str;
+        hash *= 0x100000001b3ULL;
+    } while (*str++);
+    return hash;
+}
+static unsigned long long HashType(unsigned long long hash, ObjType* type)
+{
+    unsigned long long signature;
+    // builtin types are the same everywhere and named types are wrapped in an untyped
+    // type carrying the name
+    if (type->GetType() >= ObjType::eVoid)
+        signature = type->GetType();
+    else if (type->GetType() == ObjType::eNone && type->GetBaseType())
+        signature = type->GetBaseType()->GetSignature();
+    else
+        signature = type->GetSignature();
+    hash = HashInt(hash, (int)(signature >> 32));
+    return HashInt(hash, (int)signature);
+}
 bool dbgtypes::typecompare::operator()(const Optimizer::SimpleType* left, const Optimizer::SimpleType* right) const
 {
     if (left->istypedef)
@@ -134,6 +171,8 @@ ObjType* dbgtypes::Put(Optimizer::SimpleType* tp, bool istypedef)
             val = ExtendedType(tp);
         }
     }
+    if (val && val->GetType() != ObjType::eNone && val->GetType() < ObjType::eVoid && !val->GetSignature())
+        val->SetSignature(Signature(val));
     fi->Add(val);
 
     hash[tp] = val;
@@ -205,6 +244,11 @@ bool istype(Optimizer::SimpleSymbol* sym)
 {
     return sym->storage_class == Optimizer::scc_type || sym->storage_class == Optimizer::scc_typedef;
 }
+static bool IsField(Optimizer::SimpleSymbol* sym)
+{
+    // this bears looking at, not sure why parameters are in this list
+    return !istype(sym) && sym->tp->type != Optimizer::st_aggregate && sym->storage_class != Optimizer::scc_parameter;
+}
 void dbgtypes::StructFields(ObjType::eType sel, ObjType* val, int sz, Optimizer::SimpleSymbol* parent, Optimizer::LIST* hr)
 {
     int index = val->GetIndex();
@@ -241,8 +285,7 @@ void dbgtypes::StructFields(ObjType::eType sel, ObjType* val, int sz, Optimizer:
     while (hr)
     {
         Optimizer::SimpleSymbol* sym = (Optimizer::SimpleSymbol*)hr->data;
-        // this bears looking at, not sure why parameters are in this list
-        if (!istype(sym) && sym->tp->type != Optimizer::st_aggregate && sym->storage_class != Optimizer::scc_parameter)
+        if (IsField(sym))
         {
             ObjType* base = Put(sym->tp);
             ObjField* field = factory.MakeField(sym->name, base, sym->offset, index);
@@ -387,6 +430,8 @@ ObjType* dbgtypes::ExtendedType(Optimizer::SimpleType* tp)
             }
             val = factory.MakeType(sel);
             val->SetSize(tp->size);
+            // the signature has to be there before the fields are, since they may point back to the structure
+            val->SetSignature(StructSignature(sel, tp));
             hash[tpo] = val;  // for self-referencing
             if (tp->sp->syms)
                 StructFields(sel, val, tp->size, tp->sp, tp->sp->syms);
@@ -428,9 +473,73 @@ ObjType* dbgtypes::ExtendedType(Optimizer::SimpleType* tp)
             val = factory.MakeType(ObjType::eEnum);
             val->SetSize(tp->size);
             EnumFields(val, base, tp->size, tp->sp->syms);
+            val->SetSignature(Signature(val, tp->sp->outputName));
             val = TypeName(val, tp->sp->outputName);
         }
     }
     return val;
 }
+unsigned long long dbgtypes::Signature(ObjType* val, const char* name)
+{
+    unsigned long long hash = HashInt(0xcbf29ce484222325ULL, val->GetType());
+    hash = HashInt(hash, val->GetSize());
+    switch (val->GetType())
+    {
+        case ObjType::eFunction: {
+            ObjFunction* func = static_cast<ObjFunction*>(val);
+            hash = HashInt(hash, func->GetLinkage());
+            hash = HashType(hash, func->GetReturnType());
+            for (auto it = func->ParameterBegin(); it != func->ParameterEnd(); ++it)
+                hash = HashType(hash, *it);
+            break;
+        }
+        case ObjType::eBitField:
+            hash = HashType(hash, val->GetBaseType());
+            hash = HashInt(hash, val->GetStartBit());
+            hash = HashInt(hash, val->GetBitCount());
+            break;
+        case ObjType::eArray:
+        case ObjType::eVla:
+            hash = HashType(hash, val->GetBaseType());
+            hash = HashType(hash, val->GetIndexType());
+            hash = HashInt(hash, val->GetBase());
+            hash = HashInt(hash, val->GetTop());
+            break;
+        case ObjType::eEnum:
+            hash = HashString(hash, name);
+            for (auto it = val->FieldBegin(); it != val->FieldEnd(); ++it)
+            {
+                hash = HashString(hash, (*it)->GetName().c_str());
+                hash = HashInt(hash, (*it)->GetConstVal());
+            }
+            break;
+        default:
+            hash = HashType(hash, val->GetBaseType());
+            break;
+    }
+    return hash ? hash : 1;
+}
+unsigned long long dbgtypes::StructSignature(ObjType::eType sel, Optimizer::SimpleType* tp)
+{
+    // the field types aren't part of this, the names and offsets are enough to tell apart
+    // different structures that happen to have the same name
+    unsigned long long hash = HashInt(0xcbf29ce484222325ULL, sel);
+    hash = HashInt(hash, tp->size);
+    hash = HashString(hash, tp->sp->outputName);
+    for (Optimizer::BaseList* bc = tp->sp->baseClasses; bc; bc = bc->next)
+    {
+        hash = HashString(hash, bc->sym->name);
+        hash = HashInt(hash, bc->sym->vbase ? -1 : bc->offset);
+    }
+    for (Optimizer::LIST* hr = tp->sp->syms; hr; hr = hr->next)
+    {
+        Optimizer::SimpleSymbol* sym = (Optimizer::SimpleSymbol*)hr->data;
+        if (IsField(sym))
+        {
+            hash = HashString(hash, sym->name);
+            hash = HashInt(hash, sym->offset);
+        }
+    }
+    return hash ? hash : 1;
+}
 }  // namespace occx86
\ No newline at end of file
@@ -47,6 +47,8 @@ class dbgtypes
     void EnumFields(ObjType* val, ObjType* base, int sz, Optimizer::LIST* hr);
     ObjType* Function(Optimizer::SimpleType* tp);
     ObjType* ExtendedType(Optimizer::SimpleType* tp);
+    unsigned long long Signature(ObjType* val, const char* name = "");
+    unsigned long long StructSignature(ObjType::eType sel, Optimizer::SimpleType* tp);
 
   private:
     struct typecompare
@@ -5002,6 +5002,61 @@ void asm_cmpblock(Optimizer::QUAD* q)
         pushlevel -= 12;
     }
 }
+static e_opcode vectorop(int op, int size)
+{
+    int bytes = Optimizer::sizeFromISZ(size);
+    switch (op)
+    {
+        case Optimizer::i_add:
+            if (size == ISZ_FLOAT)
+                return op_addps;
+            if (size == ISZ_DOUBLE)
+                return op_addpd;
+            return bytes == 1 ? op_paddb : bytes == 2 ? op_paddw : bytes == 4 ? op_paddd : op_paddq;
+        case Optimizer::i_sub:
+            if (size == ISZ_FLOAT)
+                return op_subps;
+            if (size == ISZ_DOUBLE)
+                return op_subpd;
+            return bytes == 1 ? op_psubb : bytes == 4 ? op_psubd : op_psubq;
+        case Optimizer::i_mul:
+            return size == ISZ_FLOAT ? op_mulps : op_mulpd;
+        case Optimizer::i_sdiv:
+        case Optimizer::i_udiv:
+            return size == ISZ_FLOAT ? op_divps : op_divpd;
+        case Optimizer::i_and:
+            return op_pand;
+        case Optimizer::i_or:
+            return op_orps;
+        case Optimizer::i_eor:
+            return op_pxor;
+        default:
+            diag("vectorop: unknown vector operation");
+            return op_pxor;
+    }
+}
+void asm_vector(Optimizer::QUAD* q) /* packed operation on 16 bytes of each array */
+{
+    AMODE *apal, *apah, *apll, *aplh;
+    enum e_opcode opa, opl;
+    int size = q->ans->size < 0 ? -q->ans->size : q->ans->size;
+    enum e_opcode mov = size == ISZ_FLOAT ? op_movups : size == ISZ_DOUBLE ? op_movupd : op_movdqu;
+    getAmodes(q, &opa, q->ans, &apal, &apah);
+    getAmodes(q, &opl, q->dc.left, &apll, &aplh);
+    // the memory operands are 128 bits wide, and the arrays needn't be aligned
+    apal->length = apll->length = ISZ_NONE;
+    gen_code(mov, makeSSE(0), apll);
+    if (q->dc.right)
+    {
+        AMODE *aprl, *aprh;
+        enum e_opcode opr;
+        getAmodes(q, &opr, q->dc.right, &aprl, &aprh);
+        aprl->length = ISZ_NONE;
+        gen_code(mov, makeSSE(1), aprl);
+        gen_code(vectorop(q->dc.v.label, size), makeSSE(0), makeSSE(1));
+    }
+    gen_code(mov, apal, makeSSE(0));
+}
 void asm_jc(Optimizer::QUAD* q) /* branch if a U< b */ { gen_goto(q, op_jc, op_ja, op_jc, op_ja, op_jb, op_ja, op_jb); }
 void asm_ja(Optimizer::QUAD* q) /* branch if a U> b */ { gen_goto(q, op_ja, op_jc, op_ja, op_jc, op_ja, op_jb, op_ja); }
 void asm_je(Optimizer::QUAD* q) /* branch if a == b */ { gen_goto(q, op_je, op_jne, op_je, op_jne, op_je, op_jne, op_je); }
@@ -146,6 +146,7 @@ void asm_functail(Optimizer::QUAD* q, int begin, int size);
 void asm_atomic(Optimizer::QUAD* q);
 void asm_expressiontag(Optimizer::QUAD* q);
 void asm_seh(Optimizer::QUAD* q);
+void asm_vector(Optimizer::QUAD* q);
 void asm_tag(Optimizer::QUAD* q);
 
 }  // namespace occx86
\ No newline at end of file
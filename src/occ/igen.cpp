@@ -297,6 +297,7 @@ static void (*oplst[])(Optimizer::QUAD* q) = {
     asm_expressiontag,
     asm_tag,
     asm_seh,
+    asm_vector,
     iop_initblk,
     iop_cpblk,
     iop_initobj,
@@ -32,8 +32,11 @@
 #include "CmdSwitch.h"
 #include "ildata.h"
 #include "SharedMemory.h"
+#include "CompileCache.h"
+#include "Trace.h"
 #include <sstream>
 #include <iostream>
+#include <map>
 #include "../version.h"
 #include "config.h"
 #include "ildata.h"
@@ -50,6 +53,9 @@
 
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
+#else
+#    include <io.h>
+#    include <direct.h>
 #endif
 
 extern bool IsSymbolCharRoutine(const char*, bool);
@@ -82,7 +88,10 @@ char infile[260];
 static const char* occ_verbosity = nullptr;
 static Optimizer::FunctionData* lastFunc;
 
-static const int MAX_SHARED_REGION = 240 * 1024 * 1024;
+
+static CompileCache* compileCache;
+static std::map<std::string, std::string> cacheKeys;  // input file to key, for the files occparse didn't find in the cache
+static std::string traceFile;
 
 /*-------------------------------------------------------------------------*/
 
@@ -290,6 +299,7 @@ bool ProcessData(const char* name)
             Optimizer::fastcallAlias = v->funcData->fastcallAlias;
             currentFunction = v->funcData->name;
             Optimizer::SetUsesESP(currentFunction->usesEsp);
+            TraceSpan span("codegen", "function", currentFunction->name);
             generate_instructions(Optimizer::intermed_head);
             flush_peep(currentFunction, nullptr);
         }
@@ -334,6 +344,7 @@ bool LoadFile(SharedMemory* optimizerMem)
 }
 bool SaveFile(const char* name)
 {
+    TraceSpan span("codegen", "emit object", name);
     if (!Optimizer::cparams.prm_asmfile)
     {
         strcpy(infile, name);
@@ -370,8 +381,40 @@ bool SaveFile(const char* name)
     }
     return true;
 }
+// hand the parse to a running 'occparse --server' named by OCC_SERVER instead of starting a new
+// process.   Returns -1 if there is no server to talk to or it can't take the compile.
+static int InvokeServer(const char* name, int argc, char** argv, SharedMemory* parserMem)
+{
+    int pipe;
+    char cwd[4096];
+    if (!getcwd(cwd, sizeof(cwd)) || !Utils::NamedPipe(&pipe, name))
+        return -1;
+    std::string request = std::string(cwd) + "\noccparse\n-!\n--architecture\nx86;" + parserMem->Name();
+    for (int i = 1; i < argc; i++)
+        request += std::string("\n") + argv[i];
+    if (occ_verbosity)
+        printf("occparse server %s\n", name);
+    fflush(stdout);
+    fflush(stderr);
+    int handles[2] = {fileno(stdout), fileno(stderr)};
+    std::string rv;
+    if (Utils::PipeWrite(pipe, request) && Utils::PipeWriteHandles(pipe, handles, 2))
+        rv = Utils::PipeRead(pipe);
+    close(pipe);
+    if (rv.empty())
+        return -1;
+    return Utils::StringToNumber(rv);
+}
 int InvokeParser(int argc, char** argv, SharedMemory* parserMem)
 {
+    TraceSpan span("process", "occparse");
+    const char* server = getenv("OCC_SERVER");
+    if (server && server[0])
+    {
+        int rv = InvokeServer(server, argc, argv, parserMem);
+        if (rv >= 0)
+            return rv;
+    }
     std::string args;
     for (int i = 1; i < argc; i++)
     {
@@ -386,9 +429,40 @@ int InvokeParser(int argc, char** argv, SharedMemory* parserMem)
 
     return Utils::ToolInvoke("occparse", occ_verbosity, "-! --architecture \"x86;%s\" %s", parserMem->Name().c_str(), args.c_str());
 }
+// occparse hands back the keys of the files it couldn't find in the compile cache
+static void ReadCacheKeys(const std::string& name)
+{
+    FILE* fil = fopen(name.c_str(), "r");
+    if (fil)
+    {
+        char buf[4096];
+        while (fgets(buf, sizeof(buf), fil))
+        {
+            char* p = strchr(buf, '\t');
+            if (p)
+            {
+                *p++ = 0;
+                p[strcspn(p, "\r\n")] = 0;
+                cacheKeys[p] = buf;
+            }
+        }
+        fclose(fil);
+    }
+}
+static void CacheObjectFile(const char* name)
+{
+    auto it = cacheKeys.find(name);
+    if (it != cacheKeys.end())
+        compileCache->Store(it->second, Parser::outFile);
+}
 int InvokeOptimizer(SharedMemory* parserMem, SharedMemory* optimizerMem)
 {
-    return Utils::ToolInvoke("occopt", occ_verbosity, "-! -S %s %s", parserMem->Name().c_str(), optimizerMem->Name().c_str());
+    TraceSpan span("process", "occopt");
+    std::string trace;
+    if (Trace::Enabled())
+        trace = " \"--trace=" + traceFile + "\"";
+    return Utils::ToolInvoke("occopt", occ_verbosity, "-! -S %s %s%s", parserMem->Name().c_str(), optimizerMem->Name().c_str(),
+                             trace.c_str());
 }
 }  // namespace occx86
 int main(int argc, char* argv[])
@@ -418,8 +492,13 @@ int main(int argc, char* argv[])
             occ_verbosity = "";
         if (strstr(*p, "/fsyntax-only") || strstr(*p, "-fsyntax-only"))
             syntaxOnly = true;
+        // occparse gets the switch along with the rest of the command line and occopt is told about it below
+        if (!strncmp(*p, "--trace=", 8))
+            traceFile = *p + 8;
     }
-    auto optimizerMem = new SharedMemory(MAX_SHARED_REGION);
+    if (!traceFile.empty())
+        Trace::Open(traceFile, "occ", true);
+    auto optimizerMem = new SharedMemory();
     optimizerMem->Create();
     int rv = 0;
     if (argc == 2 && Utils::HasExt(argv[1], ".icf"))
@@ -437,12 +516,32 @@ int main(int argc, char* argv[])
     }
     else
     {
-        auto parserMem = new SharedMemory(MAX_SHARED_REGION);
+        std::vector<char*> args(argv, argv + argc);
+        std::string cacheKeysFile, cacheArg, cacheKeysArg;
+        const char* cacheDir = getenv("OCC_CACHE");
+        if (cacheDir && cacheDir[0])
+        {
+            const char* cacheSize = getenv("OCC_CACHE_SIZE");
+            int megabytes = cacheSize ? Utils::StringToNumber(cacheSize) : 0;
+            compileCache = new CompileCache(cacheDir, (megabytes > 0 ? megabytes : 1024) * 1024ULL * 1024);
+            fclose(Utils::TempName(cacheKeysFile));
+            cacheArg = std::string("--cache=") + cacheDir;
+            cacheKeysArg = "--cache-keys=" + cacheKeysFile;
+            args.push_back(&cacheArg[0]);
+            args.push_back(&cacheKeysArg[0]);
+        }
+        args.push_back(nullptr);
+        auto parserMem = new SharedMemory();
         parserMem->Create();
-        rv = InvokeParser(argc, argv, parserMem);
+        rv = InvokeParser(args.size() - 1, &args[0], parserMem);
         if (!rv)
             rv = InvokeOptimizer(parserMem, optimizerMem);
         delete parserMem;
+        if (compileCache)
+        {
+            ReadCacheKeys(cacheKeysFile);
+            remove(cacheKeysFile.c_str());
+        }
     }
     if (!rv && !syntaxOnly)
     {
@@ -467,6 +566,8 @@ int main(int argc, char* argv[])
         {
             if (!ProcessData(files.front().c_str()) || !SaveFile(files.front().c_str()))
                 Utils::fatal("File I/O error");
+            if (compileCache)
+                CacheObjectFile(files.front().c_str());
             files.pop_front();
         }
         for (auto p : files)
@@ -477,7 +578,11 @@ int main(int argc, char* argv[])
                 Utils::fatal("File I/O error");
             if (!SaveFile(p.c_str()))
                 Utils::fatal("Cannot open '%s' for write", Parser::outFile);
+            if (compileCache)
+                CacheObjectFile(p.c_str());
         }
+        if (compileCache)
+            compileCache->Trim();
         if (Optimizer::cparams.prm_displaytiming)
         {
             stopTime = clock();
@@ -486,6 +591,7 @@ int main(int argc, char* argv[])
         rv = RunExternalFiles();
     }
     delete optimizerMem;
+    delete compileCache;
     if (rv == 255)  // means don't run the optimizer or backend
         rv = 0;
     return rv;
@@ -551,7 +551,7 @@ ObjFile* MakeBrowseFile(ObjFactory& factory, std::string name)
 void output_obj_file(void)
 {
     ObjIeeeIndexManager im;
-    ObjFactory f(&im);
+    ObjFactory f(&im, true);
     std::string name = infile;
     ObjFile* fi = MakeFile(f, name);
     DumpFile(f, fi, Optimizer::outputFile);
@@ -559,7 +559,7 @@ void output_obj_file(void)
     if (Optimizer::cparams.prm_browse)
     {
         ObjIeeeIndexManager im1;
-        ObjFactory f1(&im1);
+        ObjFactory f1(&im1, true);
         name = infile;
         fi = MakeBrowseFile(f1, name);
         DumpFile(f1, fi, Optimizer::browseFile);
@@ -814,9 +814,8 @@ void outcode_genlongdouble(FPF* val)
 
 void outcode_genstring(char* string, int len)
 {
-    int i;
-    for (i = 0; i < len; i++)
-        outcode_genbyte(string[i]);
+    if (len)
+        emit(string, len);
 }
 
 /*-------------------------------------------------------------------------*/
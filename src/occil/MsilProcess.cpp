@@ -2044,6 +2044,8 @@ void msil_main_postprocess(bool errors)
                                       ? PELib::ilasm
                                       : (Optimizer::cparams.prm_targettype == DLL ? PELib::pedll : PELib::peexe),
                                   Optimizer::cparams.prm_targettype != CONSOLE);
+            if (Optimizer::cparams.verbosity && !Optimizer::cparams.prm_asmfile)
+                printf("Metadata heap bytes saved by merging duplicates: %d\n", (int)peLib->HeapBytesSaved());
         }
     }
 }
@@ -169,6 +169,7 @@ static void iop_functailend(Optimizer::QUAD* q)
     }
 }
 static void iop_gcsestub(Optimizer::QUAD* q) {}
+static void iop_vector(Optimizer::QUAD* q) {}
 static void iop_atomic_thread_fence(Optimizer::QUAD* q) { asm_atomic(q); }
 static void iop_atomic_signal_fence(Optimizer::QUAD* q) { asm_atomic(q); }
 static void iop_atomic_flag_fence(Optimizer::QUAD* q) { asm_atomic(q); }
@@ -291,6 +292,7 @@ static void (*oplst[])(Optimizer::QUAD* q) = {
     asm_expressiontag,
     asm_tag,
     asm_seh,
+    iop_vector,
     iop_initblk,
     iop_cpblk,
     iop_initobj,
@@ -262,6 +262,12 @@ int msil_main_preprocess(char* fileName)
     if (!peLib)
     {
         peLib = new PELib(q, corFlags);
+        // decoded metadata of mscorlib and the other references is kept between compiles
+        const char* cache = getenv("OCC_METADATA_CACHE");
+        if (!cache)
+            cache = getenv("TEMP");
+        if (cache)
+            peLib->MetadataCache(cache);
 
         if (peLib->LoadAssembly("mscorlib"))
         {
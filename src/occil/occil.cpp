@@ -84,7 +84,6 @@ int dbgblocknum;
 
 static const char* occil_verbosity = nullptr;
 
-static const int MAX_SHARED_REGION = 240 * 1024 * 1024;
 
 void flush_peep() {}
 
@@ -423,7 +422,7 @@ int main(int argc, char* argv[])
         if (strstr(*p, "/y") || strstr(*p, "-y"))
             occil_verbosity = "";
     }
-    auto optimizerMem = new SharedMemory(MAX_SHARED_REGION);
+    auto optimizerMem = new SharedMemory();
     optimizerMem->Create();
     int rv = 0;
     if (argc == 2 && Utils::HasExt(argv[1], ".icf"))
@@ -441,7 +440,7 @@ int main(int argc, char* argv[])
     }
     else
     {
-        auto parserMem = new SharedMemory(MAX_SHARED_REGION);
+        auto parserMem = new SharedMemory();
         parserMem->Create();
         rv = InvokeParser(argc, argv, parserMem);
         if (!rv)
@@ -0,0 +1,74 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "OptHash.h"
+
+namespace Optimizer
+{
+static HashTableBase* tables;
+
+unsigned HashMix(unsigned long long value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return (unsigned)value;
+}
+unsigned HashBytes(const void* data, size_t len)
+{
+    const unsigned char* str = (const unsigned char*)data;
+    unsigned long long hash = 0x9e3779b97f4a7c15ULL ^ len;
+    for (; len >= sizeof(unsigned long long); len -= sizeof(unsigned long long), str += sizeof(unsigned long long))
+    {
+        unsigned long long word;
+        memcpy(&word, str, sizeof(word));
+        hash = (hash ^ word) * 0x100000001b3ULL;
+        hash ^= hash >> 29;
+    }
+    for (; len; len--, str++)
+        hash = (hash ^ *str) * 0x100000001b3ULL;
+    return HashMix(hash);
+}
+
+HashTableBase::HashTableBase(const char* Name) :
+    name(Name), lookups(0), probes(0), peak(0), peakCapacity(0), next(tables)
+{
+    tables = this;
+}
+void HashTableBase::Statistics()
+{
+    printf("Hash tables:\n");
+    for (HashTableBase* table = tables; table; table = table->next)
+    {
+        if (table->lookups)
+            printf("  %-16s %10llu lookups, %5.2f probes per lookup, peak %zu entries in %zu slots (load %.2f)\n", table->name,
+                   table->lookups, (double)table->probes / table->lookups, table->peak, table->peakCapacity,
+                   table->peakCapacity ? (double)table->peak / table->peakCapacity : 0.0);
+    }
+}
+}  // namespace Optimizer
@@ -0,0 +1,245 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#pragma once
+
+/*
+ * open addressing hash tables for the optimizer's value numbering, alias and cast lookups
+ *
+ * the tables grow as needed so that a function with a great many expressions doesn't end up walking
+ * long collision chains.   Clearing a table is constant time, so it can be done at every basic block
+ * without cost.  The tables the DAG code saves and restores at each level of the dominator tree use
+ * BeginScope/EndScope, which undo whatever was entered since the matching BeginScope.
+ */
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Optimizer
+{
+unsigned HashMix(unsigned long long value);
+unsigned HashBytes(const void* data, size_t len);
+
+inline unsigned HashKey(const void* key) { return HashMix((unsigned long long)(size_t)key); }
+inline unsigned HashKey(int key) { return HashMix((unsigned)key); }
+template <class First, class Second>
+inline unsigned HashKey(const std::pair<First, Second>& key)
+{
+    return HashMix(((unsigned long long)HashKey(key.first) << 32) | HashKey(key.second));
+}
+
+template <class Key>
+struct HashTraits
+{
+    static unsigned Hash(const Key& key) { return HashKey(key); }
+    static bool Equal(const Key& left, const Key& right) { return left == right; }
+};
+
+// usage counts for the optimizer statistics
+class HashTableBase
+{
+  public:
+    HashTableBase(const char* Name);
+    static void Statistics();
+
+  protected:
+    void Count(size_t probes)
+    {
+        lookups++;
+        this->probes += probes;
+    }
+    void Peak(size_t count, size_t capacity)
+    {
+        if (count > peak)
+        {
+            peak = count;
+            peakCapacity = capacity;
+        }
+    }
+
+  private:
+    const char* name;
+    unsigned long long lookups;
+    unsigned long long probes;
+    size_t peak;
+    size_t peakCapacity;
+    HashTableBase* next;
+};
+
+template <class Key, class Value, class Traits = HashTraits<Key>>
+class HashTable : public HashTableBase
+{
+    struct Slot
+    {
+        unsigned generation;
+        unsigned hash;
+        Key key;
+        Value value;
+    };
+    struct Undo
+    {
+        unsigned hash;
+        bool added;
+        Key key;
+        Value value;
+    };
+
+  public:
+    HashTable(const char* name) : HashTableBase(name), generation(1), count(0), scopes(0) {}
+
+    Value* Find(const Key& key)
+    {
+        if (!count)
+            return nullptr;
+        Slot* slot = Locate(Traits::Hash(key), key);
+        return slot ? &slot->value : nullptr;
+    }
+    // enter a key, or replace the value in place if it is already there
+    void Set(const Key& key, const Value& value) { Enter(key, value, false); }
+    // enter a key, shadowing any value it already has until the current scope ends
+    void Push(const Key& key, const Value& value) { Enter(key, value, true); }
+    size_t BeginScope()
+    {
+        scopes++;
+        return undo.size();
+    }
+    void EndScope(size_t mark)
+    {
+        while (undo.size() > mark)
+        {
+            Undo& u = undo.back();
+            Slot* slot = Locate(u.hash, u.key);
+            if (slot)
+            {
+                if (u.added)
+                    Remove(slot - &slots[0]);
+                else
+                    slot->value = u.value;
+            }
+            undo.pop_back();
+        }
+        scopes--;
+    }
+    void Clear()
+    {
+        count = 0;
+        undo.clear();
+        if (++generation == 0)
+        {
+            for (auto& slot : slots)
+                slot.generation = 0;
+            generation = 1;
+        }
+    }
+    size_t Size() const { return count; }
+    template <class Func>
+    void ForEach(Func func)
+    {
+        for (auto& slot : slots)
+            if (slot.generation == generation)
+                func(slot.key, slot.value);
+    }
+
+  private:
+    Slot* Locate(unsigned hash, const Key& key)
+    {
+        if (slots.empty())
+            return nullptr;
+        size_t mask = slots.size() - 1;
+        size_t probes = 1;
+        for (size_t i = hash & mask; slots[i].generation == generation; i = (i + 1) & mask, probes++)
+        {
+            if (slots[i].hash == hash && Traits::Equal(slots[i].key, key))
+            {
+                Count(probes);
+                return &slots[i];
+            }
+        }
+        Count(probes);
+        return nullptr;
+    }
+    void Enter(const Key& key, const Value& value, bool shadow)
+    {
+        unsigned hash = Traits::Hash(key);
+        Slot* slot = count ? Locate(hash, key) : nullptr;
+        if (slot)
+        {
+            if (shadow && scopes)
+                undo.push_back(Undo{hash, false, slot->key, slot->value});
+            slot->value = value;
+            return;
+        }
+        if ((count + 1) * 2 > slots.size())
+            Grow();
+        Insert(hash, key, value);
+        count++;
+        Peak(count, slots.size());
+        if (scopes)
+            undo.push_back(Undo{hash, true, key, value});
+    }
+    void Insert(unsigned hash, const Key& key, const Value& value)
+    {
+        size_t mask = slots.size() - 1;
+        size_t i = hash & mask;
+        while (slots[i].generation == generation)
+            i = (i + 1) & mask;
+        slots[i].generation = generation;
+        slots[i].hash = hash;
+        slots[i].key = key;
+        slots[i].value = value;
+    }
+    void Grow()
+    {
+        std::vector<Slot> old;
+        old.swap(slots);
+        unsigned oldGeneration = generation;
+        slots.resize(old.empty() ? 64 : old.size() * 2);
+        generation = 1;
+        for (auto& slot : old)
+            if (slot.generation == oldGeneration)
+                Insert(slot.hash, slot.key, slot.value);
+    }
+    // linear probing: move later members of the cluster back so lookups don't stop at the hole
+    void Remove(size_t hole)
+    {
+        size_t mask = slots.size() - 1;
+        for (size_t i = (hole + 1) & mask; slots[i].generation == generation; i = (i + 1) & mask)
+        {
+            size_t home = slots[i].hash & mask;
+            if (((i - home) & mask) >= ((i - hole) & mask))
+            {
+                slots[hole] = slots[i];
+                hole = i;
+            }
+        }
+        slots[hole].generation = 0;
+        count--;
+    }
+    std::vector<Slot> slots;
+    std::vector<Undo> undo;
+    unsigned generation;
+    size_t count;
+    int scopes;
+};
+}  // namespace Optimizer
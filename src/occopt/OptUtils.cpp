@@ -38,7 +38,7 @@
 namespace Optimizer
 {
 std::map<Optimizer::IMODE*, Optimizer::IMODE*> loadHash;
-CASTTEMPHASH* castHash[DAGSIZE];
+HashTable<std::pair<IMODE*, int>, IMODE*> castHash("castHash");
 int tempCount;
 
 LIST* immed_list[4091];
@@ -401,31 +401,13 @@ Optimizer::IMODE* LookupCastTemp(Optimizer::IMODE* im, int size)
 {
     if (im->mode != i_immed)
     {
-        CASTTEMPHASH ch;
-        CASTTEMPHASH* sh;
-        int hash;
-        memset(&ch, 0, sizeof(ch));
-        ch.sf.im = im;
-        ch.sf.size = size;
-        hash = dhash((UBYTE*)&ch.sf, sizeof(ch.sf));
-        sh = castHash[hash];
-        while (sh)
-        {
-            if (!memcmp(&sh->sf, &ch.sf, sizeof(ch.sf)))
-            {
-                break;
-            }
-            sh = sh->next;
-        }
-        if (!sh)
-        {
-            sh = Allocate<CASTTEMPHASH>();
-            memcpy(&sh->sf, &ch.sf, sizeof(ch.sf));
-            sh->rv = tempreg(size, 0);
-            sh->next = castHash[hash];
-            castHash[hash] = sh;
-        }
-        return sh->rv;
+        std::pair<IMODE*, int> key(im, size);
+        IMODE** rv = castHash.Find(key);
+        if (rv)
+            return *rv;
+        IMODE* temp = tempreg(size, 0);
+        castHash.Set(key, temp);
+        return temp;
     }
     else
     {
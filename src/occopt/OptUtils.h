@@ -27,7 +27,7 @@
 namespace Optimizer
 {
 extern std::map<IMODE*, IMODE*> loadHash;
-extern CASTTEMPHASH* castHash[DAGSIZE];
+extern HashTable<std::pair<IMODE*, int>, IMODE*> castHash;
 extern int tempCount;
 
 extern LIST* immed_list[4091];
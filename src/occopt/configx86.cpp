@@ -59,7 +59,7 @@ static char usage_text[] =
     "/pxxx     - pass command to tool      /snn      - align stack\n"
     "/t        - display timing info       /wxxx     - warning control\n"
     "/x xxx    - specify language          /y[...]   - verbosity\n"
-    "/z        - set SYSTEM include path\n"
+    "/z        - set SYSTEM include path   /jnn      - parse on nn processes\n"
     "+A        - disable extensions        /Dxxx     - define something\n"
     "/E[+]nn   - max number of errors      /Ipath    - specify include path\n"
     "/Lxxx     - set library path          /M        - generate make stubs\n"
@@ -114,6 +114,7 @@ static char usage_text[] =
     " -dumpmachine                    print(to stdout) a representation of the target architecture\n"
     " -print-file-name=xxx            print(to stdout) the runtime library file path\n"
     " -print-prog-name=xxx            print(to stdout) the executable path for the xxx executable\n"
+    " --trace=file                    write a Chrome trace of where the compile time goes\n"
     "\n--architecture <architecture>\n"
     "    x86 - x86 code       msil - managed code\n"
     "\nDependency generation:\n"
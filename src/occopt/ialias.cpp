@@ -68,10 +68,10 @@ static bool changed;
 static ALIASLIST* parmList;
 static int processCount;
 
-static ALIASADDRESS* addresses[DAGSIZE];
-static ALIASNAME* mem[DAGSIZE];
-static struct UIVHash* names[DAGSIZE];
-static ADDRBYNAME* addrNames[DAGSIZE];
+static HashTable<std::pair<ALIASNAME*, int>, ALIASADDRESS*> addresses("addresses");
+static HashTable<IMODE*, ALIASNAME*> mem("mem");
+static HashTable<std::pair<ALIASNAME*, int>, ALIASNAME*> names("names");
+static HashTable<ALIASNAME*, ADDRBYNAME*> addrNames("addrNames");
 static void ResetProcessed(void);
 static void GatherInds(BITINT* p, int n, ALIASLIST* al);
 void AliasInit(void)
@@ -82,10 +82,10 @@ void AliasInit(void)
         tempInfo[i]->pointsto = nullptr;
         tempInfo[i]->modifiedBy = nullptr;
     }
-    memset(addresses, 0, sizeof(addresses));
-    memset(names, 0, sizeof(names));
-    memset(mem, 0, sizeof(mem));
-    memset(addrNames, 0, sizeof(addrNames));
+    addresses.Clear();
+    names.Clear();
+    mem.Clear();
+    addrNames.Clear();
     parmList = nullptr;
     uivBytes = nullptr;
     cachedTempCount = tempCount;
@@ -137,29 +137,23 @@ static void DumpAliases(void)
     oprintf(icdFile, "function: %s\n", currentFunction->name);
     int i;
     oprintf(icdFile, "Alias Dump:\n");
-    for (i = 0; i < DAGSIZE; i++)
-    {
-        ALIASADDRESS* aa = addresses[i];
-        while (aa)
+    addresses.ForEach([](const std::pair<ALIASNAME*, int>&, ALIASADDRESS* aa) {
+        ALIASLIST* al;
+        ALIASADDRESS* aa1 = aa;
+        while (aa1->merge)
+            aa1 = aa1->merge;
+        al = aa1->pointsto;
+        PrintName(aa->name, aa->offset);
+        oprintf(icdFile, ": ");
+        while (al)
         {
-            ALIASLIST* al;
-            ALIASADDRESS* aa1 = aa;
-            while (aa1->merge)
-                aa1 = aa1->merge;
-            al = aa1->pointsto;
-            PrintName(aa->name, aa->offset);
-            oprintf(icdFile, ": ");
-            while (al)
-            {
-                PrintName(al->address->name, al->address->offset);
-                oprintf(icdFile, " ");
-                al = al->next;
-            }
-            PrintTemps(aa1->modifiedBy);
-            oprintf(icdFile, "\n");
-            aa = aa->next;
+            PrintName(al->address->name, al->address->offset);
+            oprintf(icdFile, " ");
+            al = al->next;
         }
-    }
+        PrintTemps(aa1->modifiedBy);
+        oprintf(icdFile, "\n");
+    });
     for (i = 0; i < cachedTempCount; i++)
     {
         if (tempInfo[i]->pointsto)
@@ -193,8 +187,7 @@ static void DumpAliases(void)
 }
 static ALIASNAME* LookupMem(IMODE* im)
 {
-    ALIASNAME** p;
-    int hash;
+    ALIASNAME* p;
     switch (im->offset->type)
     {
         case se_global:
@@ -207,31 +200,24 @@ static ALIASNAME* LookupMem(IMODE* im)
         default:
             break;
     }
-    hash = dhash((UBYTE*)&im, sizeof(im));
-    p = &mem[hash];
-    while (*p)
-    {
-        if (((*p)->byUIV == false && (*p)->v.name == im) ||
-            ((*p)->byUIV == true && (*p)->v.uiv->im == im && (*p)->v.uiv->offset == nullptr))
-        {
-            return *p;
-        }
-        p = &(*p)->next;
-    }
-    *p = aAllocate<ALIASNAME>();
-    (*p)->v.name = im;
+    ALIASNAME** found = mem.Find(im);
+    if (found)
+        return *found;
+    p = aAllocate<ALIASNAME>();
+    p->v.name = im;
     switch (im->offset->type)
     {
         case se_auto:
         case se_global:
-            (*p)->v.uiv = aAllocate<UIV>();
-            (*p)->v.uiv->im = im;
-            (*p)->byUIV = true;
+            p->v.uiv = aAllocate<UIV>();
+            p->v.uiv->im = im;
+            p->byUIV = true;
             break;
         default:
             break;
     }
-    return *p;
+    mem.Set(im, p);
+    return p;
 }
 static void AliasUnion(ALIASLIST** dest, ALIASLIST* src)
 {
@@ -296,23 +282,10 @@ static void AliasUnionParm(ALIASLIST** dest, ALIASLIST* src)
 }
 static ALIASNAME* LookupAliasName(ALIASNAME* name, int offset)
 {
-    int str[(sizeof(ALIASNAME*) + sizeof(int)) / sizeof(int)];
-    int hash;
     ALIASNAME* result;
-    struct UIVHash** uivs;
-    str[0] = offset;
-    *((ALIASNAME**)(str + 1)) = name;
-    hash = dhash((UBYTE*)str, sizeof(str));
-    uivs = &names[hash];
-    while (*uivs)
-    {
-        if ((*uivs)->name == name && (*uivs)->offset == offset)
-            return (*uivs)->result;
-        uivs = &(*uivs)->next;
-    }
-    *uivs = aAllocate<UIVHash>();
-    (*uivs)->name = name;
-    (*uivs)->offset = offset;
+    ALIASNAME** found = names.Find(std::pair<ALIASNAME*, int>(name, offset));
+    if (found)
+        return *found;
     result = aAllocate<ALIASNAME>();
     result->byUIV = true;
     result->v.uiv = aAllocate<UIV>();
@@ -329,45 +302,24 @@ static ALIASNAME* LookupAliasName(ALIASNAME* name, int offset)
     result->v.uiv->offset->offset = offset;
     if (name->byUIV)
         result->v.uiv->offset->next = name->v.uiv->offset;
-    (*uivs)->result = result;
+    names.Set(std::pair<ALIASNAME*, int>(name, offset), result);
     return result;
 }
 static ALIASNAME* GetAliasName(ALIASNAME* name, int offset)
 {
-    int str[(sizeof(ALIASNAME*) + sizeof(int)) / sizeof(int)];
-    int hash;
-    ALIASNAME* result;
-    struct UIVHash** uivs;
-    str[0] = offset;
-    *((ALIASNAME**)(str + 1)) = name;
-    hash = dhash((UBYTE*)str, sizeof(str));
-    uivs = &names[hash];
-    while (*uivs)
-    {
-        if ((*uivs)->name == name && (*uivs)->offset == offset)
-            return (*uivs)->result;
-        uivs = &(*uivs)->next;
-    }
-    return nullptr;
+    ALIASNAME** found = names.Find(std::pair<ALIASNAME*, int>(name, offset));
+    return found ? *found : nullptr;
 }
 static ALIASADDRESS* LookupAddress(ALIASNAME* name, int offset)
 {
-    int str[(sizeof(ALIASNAME*) + sizeof(int)) / sizeof(int)];
-    int hash;
-    ALIASADDRESS *addr, **search;
+    ALIASADDRESS* addr;
     IMODE* im;
     LIST* li;
-    str[0] = offset;
-    *((ALIASNAME**)(str + 1)) = name;
-    hash = dhash((UBYTE*)str, sizeof(str));
-    search = &addresses[hash];
-    while (*search)
-    {
-        if ((*search)->name == name && (*search)->offset == offset)
-            return (*search);
-        search = &(*search)->next;
-    }
-    addr = (*search) = aAllocate<ALIASADDRESS>();
+    ALIASADDRESS** found = addresses.Find(std::pair<ALIASNAME*, int>(name, offset));
+    if (found)
+        return *found;
+    addr = aAllocate<ALIASADDRESS>();
+    addresses.Set(std::pair<ALIASNAME*, int>(name, offset), addr);
     addr->name = name;
     addr->offset = offset;
     if (addr->name->byUIV)
@@ -396,20 +348,13 @@ static ALIASADDRESS* LookupAddress(ALIASNAME* name, int offset)
     li->data = addr;
     li->next = name->addresses;
     name->addresses = li;
-    hash = dhash((UBYTE*)&name, sizeof(name));
-    ADDRBYNAME* q = addrNames[hash];
-    while (q)
-    {
-        if (q->name == name)
-            break;
-        q = q->next;
-    }
+    ADDRBYNAME** found2 = addrNames.Find(name);
+    ADDRBYNAME* q = found2 ? *found2 : nullptr;
     if (!q)
     {
         q = aAllocate<ADDRBYNAME>();
-        q->next = addrNames[hash];
-        addrNames[hash] = q;
         q->name = name;
+        addrNames.Set(name, q);
     }
     ALIASLIST* ali = aAllocate<ALIASLIST>();
     ali->address = addr;
@@ -419,22 +364,8 @@ static ALIASADDRESS* LookupAddress(ALIASNAME* name, int offset)
 }
 static ALIASADDRESS* GetAddress(ALIASNAME* name, int offset)
 {
-    int str[(sizeof(ALIASNAME*) + sizeof(int)) / sizeof(int)];
-    int hash;
-    ALIASADDRESS *addr, **search;
-    IMODE* im;
-    LIST* li;
-    str[0] = offset;
-    *((ALIASNAME**)(str + 1)) = name;
-    hash = dhash((UBYTE*)str, sizeof(str));
-    search = &addresses[hash];
-    while (*search)
-    {
-        if ((*search)->name == name && (*search)->offset == offset)
-            return (*search);
-        search = &(*search)->next;
-    }
-    return nullptr;
+    ALIASADDRESS** found = addresses.Find(std::pair<ALIASNAME*, int>(name, offset));
+    return found ? *found : nullptr;
 }
 static void CreateMem(IMODE* im)
 {
@@ -746,44 +677,34 @@ static int InferStride(IMODE* im)
 }
 static void SetStride(ALIASADDRESS* addr, int stride)
 {
-    int hash = dhash((UBYTE*)&addr->name, sizeof(addr->name));
-    ADDRBYNAME* q = addrNames[hash];
-    while (q)
-    {
-        if (q->name == addr->name)
-            break;
-        q = q->next;
-    }
+    ADDRBYNAME** found = addrNames.Find(addr->name);
+    ADDRBYNAME* q = found ? *found : nullptr;
     if (q)
     {
         ALIASLIST* addresses = q->addresses;
         while (addresses)
         {
             ALIASADDRESS* scan = addresses->address;
-            while (scan)
+            if (addr != scan && addr->name == scan->name)
             {
-                if (addr != scan && addr->name == scan->name)
+                if (addr->offset < scan->offset)
                 {
-                    if (addr->offset < scan->offset)
+                    int o2 = addr->offset + (scan->offset - addr->offset) % stride;
+                    if (addr->offset == o2)
                     {
-                        int o2 = addr->offset + (scan->offset - addr->offset) % stride;
-                        if (addr->offset == o2)
-                        {
-                            AliasUnion(&addr->pointsto, scan->pointsto);
-                            scan->merge = addr;
-                        }
-                        else
+                        AliasUnion(&addr->pointsto, scan->pointsto);
+                        scan->merge = addr;
+                    }
+                    else
+                    {
+                        ALIASADDRESS* sc2 = LookupAddress(addr->name, o2);
+                        if (sc2 && sc2 != scan)
                         {
-                            ALIASADDRESS* sc2 = LookupAddress(addr->name, o2);
-                            if (sc2 && sc2 != scan)
-                            {
-                                AliasUnion(&sc2->pointsto, scan->pointsto);
-                                scan->merge = sc2;
-                            }
+                            AliasUnion(&sc2->pointsto, scan->pointsto);
+                            scan->merge = sc2;
                         }
                     }
                 }
-                scan = scan->next;
             }
             addresses = addresses->next;
         }
@@ -1397,44 +1318,37 @@ static void ScanUIVs(void)
 {
     bool done = false;
     ALIASLIST* al = parmList;
-    int i;
     ResetProcessed();
     uivBytes = aallocbit(termCount);
-    for (i = 0; i < DAGSIZE; i++)
-    {
-        ALIASADDRESS* aa = addresses[i];
-        while (aa)
+    addresses.ForEach([](const std::pair<ALIASNAME*, int>&, ALIASADDRESS* aa) {
+        ALIASADDRESS* aa1 = aa;
+        IMODE* im;
+        while (aa1->merge)
+            aa1 = aa1->merge;
+        if (aa1->name->byUIV)
         {
-            ALIASADDRESS* aa1 = aa;
-            IMODE* im;
-            while (aa1->merge)
-                aa1 = aa1->merge;
-            if (aa1->name->byUIV)
-            {
-                im = aa1->name->v.uiv->im;
-            }
-            else
-            {
-                im = aa1->name->v.name;
-            }
-            switch (im->offset->type)
-            {
-                case se_auto:
-                case se_global:
-                case se_pc:
-                case se_threadlocal:
-                    im = GetLoadTemp(im);
-                    if (im)
-                        setbit(uivBytes, termMap[im->offset->sp->i]);
-                    if (aa1->modifiedBy)
-                        ormap(uivBytes, aa1->modifiedBy);
-                    break;
-                default:
-                    break;
-            }
-            aa = aa->next;
+            im = aa1->name->v.uiv->im;
         }
-    }
+        else
+        {
+            im = aa1->name->v.name;
+        }
+        switch (im->offset->type)
+        {
+            case se_auto:
+            case se_global:
+            case se_pc:
+            case se_threadlocal:
+                im = GetLoadTemp(im);
+                if (im)
+                    setbit(uivBytes, termMap[im->offset->sp->i]);
+                if (aa1->modifiedBy)
+                    ormap(uivBytes, aa1->modifiedBy);
+                break;
+            default:
+                break;
+        }
+    });
 }
 void FinishScanUIVs()
 {
@@ -1496,20 +1410,13 @@ static void MakeAliasLists(void)
 static void ResetProcessed(void) { bitarrayClear(processBits, processCount); }
 static void AllocateProcessed(void)
 {
-    int i;
     processCount = 0;
-    for (i = 0; i < DAGSIZE; i++)
-    {
-        ALIASADDRESS* addr = addresses[i];
-        while (addr)
-        {
-            ALIASADDRESS* aa = addr;
-            while (aa->merge)
-                aa = aa->merge;
-            aa->processIndex = processCount++;
-            addr = addr->next;
-        }
-    }
+    addresses.ForEach([](const std::pair<ALIASNAME*, int>&, ALIASADDRESS* addr) {
+        ALIASADDRESS* aa = addr;
+        while (aa->merge)
+            aa = aa->merge;
+        aa->processIndex = processCount++;
+    });
     processBits = aallocbit(processCount);
 }
 static void GatherInds(BITINT* p, int n, ALIASLIST* al)
@@ -1544,24 +1451,17 @@ static void GatherInds(BITINT* p, int n, ALIASLIST* al)
 }
 static void ScanMem(void)
 {
-    int i, k;
     int n = (termCount + BITINTBITS - 1) / BITINTBITS;
     do
     {
         changed = false;
         ResetProcessed();
-        for (i = 0; i < DAGSIZE; i++)
-        {
-            ALIASADDRESS* aa = addresses[i];
-            while (aa)
-            {
-                ALIASADDRESS* aa1 = aa;
-                while (aa1->merge)
-                    aa1 = aa1->merge;
-                GatherInds(&aa1->modifiedBy[0], n, aa->pointsto);
-                aa = aa->next;
-            }
-        }
+        addresses.ForEach([n](const std::pair<ALIASNAME*, int>&, ALIASADDRESS* aa) {
+            ALIASADDRESS* aa1 = aa;
+            while (aa1->merge)
+                aa1 = aa1->merge;
+            GatherInds(&aa1->modifiedBy[0], n, aa->pointsto);
+        });
     } while (changed);
 }
 void AliasPass1(void)
@@ -28,14 +28,6 @@ namespace Optimizer
 extern int cachedTempCount;
 extern BITINT* uivBytes;
 extern BITINT* processBits;
-struct UIVHash
-{
-    struct UIVHash* next;
-    ALIASNAME* name;
-    int offset;
-    ALIASNAME* result;
-};
-
 void AliasInit(void);
 void AliasRundown(void);
 void AliasStruct(BITINT* bits, IMODE* ans, IMODE* left, IMODE* right);
@@ -54,8 +54,8 @@ BLOCK** blockArray;
 
 Optimizer::QUAD *intermed_head, *intermed_tail;
 int blockCount;
-DAGLIST* ins_hash[DAGSIZE];
-DAGLIST* name_hash[DAGSIZE];
+DAGHASH ins_hash("ins_hash");
+DAGHASH name_hash("name_hash");
 short wasgoto = false;
 
 BLOCK* currentBlock;
@@ -93,59 +93,15 @@ int equalimode(Optimizer::IMODE* ap1, Optimizer::IMODE* ap2)
 
 /*-------------------------------------------------------------------------*/
 
-short dhash(UBYTE* str, int len)
-/*
- * hashing for dag nodes
- */
-{
-    int i;
-    unsigned short v = 0;
-    for (i = 0; i < len; i++)
-    {
-        v = (v << 3) + (v >> 13) + (v >> 3) + (v << 13);
-        v += str[i];
-    }
-    return v % DAGSIZE;
-}
-
-/*-------------------------------------------------------------------------*/
-
-Optimizer::QUAD* LookupNVHash(UBYTE* key, int size, DAGLIST** table)
+Optimizer::QUAD* LookupNVHash(UBYTE* key, int size, DAGHASH& table)
 {
-    int hashval = dhash(key, size);
-    DAGLIST* list = table[hashval];
-    while (list)
-    {
-        if (list->key && !memcmp(key, list->key, size))
-            return (Optimizer::QUAD*)list->rv;
-        list = list->next;
-    }
-    return 0;
+    Optimizer::QUAD** rv = table.Find(DagKey{key, size});
+    return rv ? *rv : nullptr;
 }
 
 /*-------------------------------------------------------------------------*/
 
-DAGLIST* ReplaceHash(Optimizer::QUAD* rv, UBYTE* key, int size, DAGLIST** table)
-{
-    int hashval = dhash(key, size);
-    DAGLIST **list = &table[hashval], **flist = list;
-    DAGLIST* newDag;
-    while (*list)
-    {
-        if ((*list)->key && !memcmp(key, (*list)->key, size))
-        {
-            (*list)->rv = (UBYTE*)rv;
-            return *list;
-        }
-        list = *(DAGLIST***)list;
-    }
-    newDag = oAllocate<DAGLIST>();
-    newDag->rv = (UBYTE*)rv;
-    newDag->key = key;
-    newDag->next = *flist;
-    *flist = newDag;
-    return newDag;
-}
+void ReplaceHash(Optimizer::QUAD* rv, UBYTE* key, int size, DAGHASH& table) { table.Set(DagKey{key, size}, rv); }
 
 /*-------------------------------------------------------------------------*/
 
@@ -474,8 +430,8 @@ static Optimizer::QUAD* add_dag(Optimizer::QUAD* newQuad)
 void flush_dag(void)
 {
 #ifdef DOING_LCSE
-    memset(name_hash, 0, sizeof(void*) * DAGSIZE);
-    memset(ins_hash, 0, sizeof(void*) * DAGSIZE);
+    name_hash.Clear();
+    ins_hash.Clear();
 #endif
 }
 
@@ -484,8 +440,8 @@ void flush_dag(void)
 void dag_rundown(void)
 {
 #ifdef DOING_LCSE
-    memset(name_hash, 0, sizeof(void*) * DAGSIZE);
-    memset(ins_hash, 0, sizeof(void*) * DAGSIZE);
+    name_hash.Clear();
+    ins_hash.Clear();
 #endif
 }
 
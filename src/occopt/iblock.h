@@ -30,8 +30,8 @@ extern BLOCK** blockArray;
 
 extern QUAD *intermed_head, *intermed_tail;
 extern int blockCount;
-extern DAGLIST* ins_hash[DAGSIZE];
-extern DAGLIST* name_hash[DAGSIZE];
+extern DAGHASH ins_hash;
+extern DAGHASH name_hash;
 extern short wasgoto;
 
 extern BLOCK* currentBlock;
@@ -40,9 +40,8 @@ extern int blockMax;
 
 void gen_nodag(enum i_ops op, IMODE* res, IMODE* left, IMODE* right);
 int equalimode(IMODE* ap1, IMODE* ap2);
-short dhash(UBYTE* str, int len);
-QUAD* LookupNVHash(UBYTE* key, int size, DAGLIST** table);
-DAGLIST* ReplaceHash(QUAD* rv, UBYTE* key, int size, DAGLIST** table);
+QUAD* LookupNVHash(UBYTE* key, int size, DAGHASH& table);
+void ReplaceHash(QUAD* rv, UBYTE* key, int size, DAGHASH& table);
 void add_intermed(QUAD* newQuad);
 IMODE* liveout2(QUAD* q);
 QUAD* liveout(QUAD* node);
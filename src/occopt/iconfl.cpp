@@ -48,11 +48,51 @@ void resetConflict(void)
         tempInfo[i]->neighbors = 0;
     }
 }
-int findPartition(int T0)
+/* the partitions are a union-find forest, with union by rank and path compression
+ * so that merging the temps of very large functions stays close to linear.  The
+ * root of a tree isn't necessarily the temp that names the partition, since
+ * the callers decide which of two temps survives a merge.
+ */
+void initPartition(int T0)
+{
+    tempInfo[T0]->partition = T0;
+    tempInfo[T0]->partitionName = T0;
+    tempInfo[T0]->partitionRank = 0;
+}
+static int partitionRoot(int T0)
+{
+    int root = T0;
+    while (root != tempInfo[root]->partition)
+        root = tempInfo[root]->partition;
+    while (T0 != root)
+    {
+        int next = tempInfo[T0]->partition;
+        tempInfo[T0]->partition = root;
+        T0 = next;
+    }
+    return root;
+}
+int findPartition(int T0) { return tempInfo[partitionRoot(T0)]->partitionName; }
+// merge the partitions, keeping the name of the one tnew is in
+void joinPartition(int tnew, int told)
 {
-    while (T0 != tempInfo[T0]->partition)
-        T0 = tempInfo[T0]->partition;
-    return T0;
+    int rnew = partitionRoot(tnew), rold = partitionRoot(told);
+    int name = tempInfo[rnew]->partitionName;
+    if (rnew != rold)
+    {
+        if (tempInfo[rnew]->partitionRank < tempInfo[rold]->partitionRank)
+        {
+            int temp = rnew;
+            rnew = rold;
+            rold = temp;
+        }
+        else if (tempInfo[rnew]->partitionRank == tempInfo[rold]->partitionRank)
+        {
+            tempInfo[rnew]->partitionRank++;
+        }
+        tempInfo[rold]->partition = rnew;
+    }
+    tempInfo[rnew]->partitionName = name;
 }
 void insertConflict(int i, int j)
 {
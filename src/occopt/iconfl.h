@@ -27,7 +27,9 @@ namespace Optimizer
 {
 void conflictini(void);
 void resetConflict(void);
+void initPartition(int T0);
 int findPartition(int T0);
+void joinPartition(int tnew, int told);
 void insertConflict(int i, int j);
 void JoinConflictLists(int T0, int T1);
 bool isConflicting(int T0, int T1);
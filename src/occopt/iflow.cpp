@@ -33,6 +33,8 @@
 #include <stdio.h>
 #include <malloc.h>
 #include <string.h>
+#include <vector>
+#include <utility>
 #include "ioptimizer.h"
 #include "beinterfdefs.h"
 #include "iflow.h"
@@ -51,7 +53,7 @@ int firstLabel;
 QUAD *criticalThunks, **criticalThunkPtr;
 int walkPreorder, walkPostorder;
 
-static EDGE* edgeHash[EDGE_HASH_SIZE];
+static HashTable<std::pair<int, int>, e_fgtype> edgeHash("edgeHash");
 
 static BLOCK** labels;
 
@@ -268,21 +270,34 @@ static void gather_flowgraph(void)
     }
 }
 
-static void FGWalker(int (*func)(enum e_fgtype type, BLOCK* parent, BLOCK* b), BLOCK* cur, int fwd)
+/* the walk keeps its own stack, a function with a long chain of blocks would otherwise
+ * recurse once for each block
+ */
+static void FGWalker(int (*func)(enum e_fgtype type, BLOCK* parent, BLOCK* b), BLOCK* start, int fwd)
 {
-    BLOCKLIST* l;
-    if (fwd)
-        l = cur->succ;
-    else
-        l = cur->pred;
-    cur->preWalk = walkPreorder++;
-    while (l)
+    std::vector<std::pair<BLOCK*, BLOCKLIST*>> stack;
+    start->preWalk = walkPreorder++;
+    stack.push_back(std::make_pair(start, fwd ? start->succ : start->pred));
+    while (!stack.empty())
     {
+        BLOCK* cur = stack.back().first;
+        BLOCKLIST* l = stack.back().second;
+        if (!l)
+        {
+            cur->postWalk = walkPostorder++;
+            stack.pop_back();
+            continue;
+        }
+        stack.back().second = l->next;
         if (l->block->preWalk == 0)
         {
             /* tree*/
             if (func(F_TREE, cur, l->block))
-                FGWalker(func, l->block, fwd);
+            {
+                BLOCK* b = l->block;
+                b->preWalk = walkPreorder++;
+                stack.push_back(std::make_pair(b, fwd ? b->succ : b->pred));
+            }
         }
         else if (l->block->postWalk == 0)
         {
@@ -299,9 +314,7 @@ static void FGWalker(int (*func)(enum e_fgtype type, BLOCK* parent, BLOCK* b), B
             /* cross edge*/
             func(F_CROSSEDGE, cur, l->block);
         }
-        l = l->next;
     }
-    cur->postWalk = walkPostorder++;
 }
 /* depth first search entry point */
 void WalkFlowgraph(BLOCK* b, int (*func)(enum e_fgtype type, BLOCK* parent, BLOCK* b), int fwd)
@@ -450,16 +463,23 @@ static void removeDeadBlocks(BRIGGS_SET* brs, BLOCK* back, BLOCK* b)
 }
 static void removeMark(BRIGGS_SET* bls, BLOCK* b)
 {
-    BLOCKLIST* bl;
-    if (b->blocknum == exitBlock || b->temp)
-        return;
-    b->temp = true;
-    briggsSet(bls, b->blocknum);
-    bl = b->succ;
-    while (bl)
+    std::vector<BLOCK*> stack;
+    stack.push_back(b);
+    while (!stack.empty())
     {
-        removeMark(bls, bl->block);
-        bl = bl->next;
+        BLOCKLIST* bl;
+        b = stack.back();
+        stack.pop_back();
+        if (b->blocknum == exitBlock || b->temp)
+            continue;
+        b->temp = true;
+        briggsSet(bls, b->blocknum);
+        bl = b->succ;
+        while (bl)
+        {
+            stack.push_back(bl->block);
+            bl = bl->next;
+        }
     }
 }
 void reflowConditional(BLOCK* src, BLOCK* dst)
@@ -599,7 +619,8 @@ static struct _tarjan
     int idom;
     int ancestor;
     int best;
-    BRIGGS_SET* bucket;
+    int bucket;     /* first vertex whose semidominator this is, vertices are chained through bucketNext */
+    int bucketNext; /* a vertex is only ever in one bucket so a single link is enough */
 } * *vectorData;
 static int domNumber(enum e_fgtype t, BLOCK* parent, BLOCK* b)
 {
@@ -645,10 +666,18 @@ static int domEval(int v)
 #else
 static void domCompress(int v)
 {
-    int a = vectorData[v]->ancestor;
-    if (vectorData[a]->ancestor)
+    // compress from the top of the ancestor chain down, as the recursive version would
+    static std::vector<int> path;
+    while (vectorData[vectorData[v]->ancestor]->ancestor)
     {
-        domCompress(a);
+        path.push_back(v);
+        v = vectorData[v]->ancestor;
+    }
+    while (!path.empty())
+    {
+        v = path.back();
+        path.pop_back();
+        int a = vectorData[v]->ancestor;
         if (vectorData[vectorData[v]->best]->semi > vectorData[vectorData[a]->best]->semi)
             vectorData[v]->best = vectorData[a]->best;
         vectorData[v]->ancestor = vectorData[a]->ancestor;
@@ -672,10 +701,7 @@ static void PostDominators(void)
     WalkFlowgraph(blockArray[exitBlock], domNumber, false);
     vectorData = tAllocate<_tarjan*>(domCount + 1);
     for (i = 0; i <= domCount; i++)
-    {
         vectorData[i] = tAllocate<_tarjan>();
-        vectorData[i]->bucket = briggsAlloct(domCount + 1);
-    }
     WalkFlowgraph(blockArray[exitBlock], domInit, false);
 
     for (w = domCount; w >= 2; w--)
@@ -691,18 +717,18 @@ static void PostDominators(void)
                 vectorData[w]->semi = vectorData[u]->semi;
             bl = bl->next;
         }
-        briggsSet(vectorData[vectorData[w]->semi]->bucket, w);
+        vectorData[w]->bucketNext = vectorData[vectorData[w]->semi]->bucket;
+        vectorData[vectorData[w]->semi]->bucket = w;
         domLink(p, w);
-        for (j = vectorData[p]->bucket->top - 1; j >= 0; j--)
+        for (j = vectorData[p]->bucket; j; j = vectorData[j]->bucketNext)
         {
-            int v = vectorData[p]->bucket->data[j];
-            int u = domEval(v);
+            int u = domEval(j);
             if (vectorData[u]->semi >= p)
-                vectorData[v]->idom = p;
+                vectorData[j]->idom = p;
             else
-                vectorData[v]->idom = u;
+                vectorData[j]->idom = u;
         }
-        briggsClear(vectorData[p]->bucket);
+        vectorData[p]->bucket = 0;
     }
     for (w = 2; w <= domCount; w++)
     {
@@ -725,10 +751,7 @@ static void Dominators(void)
     WalkFlowgraph(blockArray[0], domNumber, true);
     vectorData = tAllocate<_tarjan*>(domCount + 1);
     for (i = 0; i <= domCount; i++)
-    {
         vectorData[i] = tAllocate<_tarjan>();
-        vectorData[i]->bucket = briggsAlloct(domCount + 1);
-    }
     WalkFlowgraph(blockArray[0], domInit, true);
 
     for (w = domCount; w >= 2; w--)
@@ -744,18 +767,18 @@ static void Dominators(void)
                 vectorData[w]->semi = vectorData[u]->semi;
             bl = bl->next;
         }
-        briggsSet(vectorData[vectorData[w]->semi]->bucket, w);
+        vectorData[w]->bucketNext = vectorData[vectorData[w]->semi]->bucket;
+        vectorData[vectorData[w]->semi]->bucket = w;
         domLink(p, w);
-        for (j = vectorData[p]->bucket->top - 1; j >= 0; j--)
+        for (j = vectorData[p]->bucket; j; j = vectorData[j]->bucketNext)
         {
-            int v = vectorData[p]->bucket->data[j];
-            int u = domEval(v);
+            int u = domEval(j);
             if (vectorData[u]->semi >= p)
-                vectorData[v]->idom = p;
+                vectorData[j]->idom = p;
             else
-                vectorData[v]->idom = u;
+                vectorData[j]->idom = u;
         }
-        briggsClear(vectorData[p]->bucket);
+        vectorData[p]->bucket = 0;
     }
     for (w = 2; w <= domCount; w++)
     {
@@ -796,77 +819,85 @@ bool dominatedby(BLOCK* src, BLOCK* ancestor)
 /* we are also calculating the reverse postorder here
  * it will be needed later for the loop handling
  */
-static void DominanceFrontier(BLOCK* b, int* count)
+/* seen[n] holds the block whose frontier last had block n added, so that each
+ * frontier only lists a block once however many children pass it up
+ */
+static void AddToFrontier(BLOCK* b, BLOCK* f, std::vector<int>& seen)
 {
-    BLOCKLIST *c = b->dominates, *s;
-    while (c)
+    if (seen[f->blocknum] != b->blocknum)
     {
-        DominanceFrontier(c->block, count);
-        c = c->next;
+        BLOCKLIST* t = oAllocate<BLOCKLIST>();
+        seen[f->blocknum] = b->blocknum;
+        t->next = b->dominanceFrontier;
+        t->block = f;
+        b->dominanceFrontier = t;
     }
+}
+static void DominanceFrontierOf(BLOCK* b, int* count, std::vector<int>& seen)
+{
+    BLOCKLIST *c, *s;
     b->reversePostOrder = (*count)++;
     s = b->succ;
     while (s)
     {
         if (s->block->idom != b->blocknum)
-        {
-            BLOCKLIST* t = oAllocate<BLOCKLIST>();
-            t->next = b->dominanceFrontier;
-            t->block = s->block;
-            b->dominanceFrontier = t;
-        }
+            AddToFrontier(b, s->block, seen);
         s = s->next;
     }
     c = b->dominates;
     while (c)
     {
         BLOCKLIST* bl = c->block->dominanceFrontier;
-        int i;
         while (bl)
         {
-            if (!dominatedby(bl->block, b))
-            {
-                BLOCKLIST* t = oAllocate<BLOCKLIST>();
-                t->next = b->dominanceFrontier;
-                t->block = bl->block;
-                b->dominanceFrontier = t;
-            }
+            /* b strictly dominates a block in the frontier of its child only if it is the
+             * immediate dominator, which saves walking up the tree.  dominatedby() never
+             * reports the entry block as a dominator so everything is passed up to it.
+             */
+            if (!b->blocknum || bl->block->idom != b->blocknum)
+                AddToFrontier(b, bl->block, seen);
             bl = bl->next;
         }
         c = c->next;
     }
 }
-static int hashfunc(int i, int j) { return (j * (j - 1) / 2 + i) % EDGE_HASH_SIZE; }
-static int gatherEdges(enum e_fgtype type, BLOCK* parent, BLOCK* in)
+/* the children of each block in the dominator tree have to be done before it
+ * is, the tree is walked with an explicit stack since it can be very deep
+ */
+static void DominanceFrontier(BLOCK* root, int* count)
 {
-    if (parent)
+    std::vector<int> seen(blockCount, -1);
+    std::vector<std::pair<BLOCK*, BLOCKLIST*>> stack;
+    stack.push_back(std::make_pair(root, root->dominates));
+    while (!stack.empty())
     {
-        EDGE* edge = oAllocate<EDGE>();
-        int bucket = hashfunc(parent->blocknum, in->blocknum);
-        edge->first = parent->blocknum;
-        edge->second = in->blocknum;
-        edge->edgetype = type;
-        edge->next = edgeHash[bucket];
-        edgeHash[bucket] = edge;
+        BLOCKLIST* next = stack.back().second;
+        if (next)
+        {
+            stack.back().second = next->next;
+            stack.push_back(std::make_pair(next->block, next->block->dominates));
+            continue;
+        }
+        BLOCK* b = stack.back().first;
+        stack.pop_back();
+        DominanceFrontierOf(b, count, seen);
     }
+}
+static int gatherEdges(enum e_fgtype type, BLOCK* parent, BLOCK* in)
+{
+    if (parent)
+        edgeHash.Set(std::pair<int, int>(parent->blocknum, in->blocknum), type);
     return true;
 }
 static void CalculateEdges(BLOCK* b)
 {
-    memset(edgeHash, 0, EDGE_HASH_SIZE * sizeof(EDGE*));
+    edgeHash.Clear();
     WalkFlowgraph(b, gatherEdges, true);
 }
 enum e_fgtype getEdgeType(int first, int second)
 {
-    int bucket = hashfunc(first, second);
-    EDGE* p = edgeHash[bucket];
-    while (p)
-    {
-        if (p->first == first && p->second == second)
-            return p->edgetype;
-        p = p->next;
-    }
-    return F_NONE;
+    e_fgtype* type = edgeHash.Find(std::pair<int, int>(first, second));
+    return type ? *type : F_NONE;
 }
 /* SSA doesn't work well when there are dead paths */
 static void removeDeadBlock(BLOCK* b)
@@ -29,6 +29,7 @@
 #include <stdio.h>
 #include <malloc.h>
 #include <string.h>
+#include <vector>
 #include "ioptimizer.h"
 #include "beinterfdefs.h"
 #include "config.h"
@@ -189,7 +190,7 @@ static void liveSetup(void)
 static void liveOut()
 {
     BITINT inWorkList[8192];
-    unsigned short* workList = sAllocate<unsigned short>(blockCount + 1);
+    int* workList = sAllocate<int>(blockCount + 1);
     int i;
     int head = 0, tail = 0;
     int tempDWords = (tempCount + BITINTBITS - 1) / BITINTBITS;
@@ -435,6 +436,7 @@ static void markLiveInstruction(BRIGGS_SET* live, QUAD* ins)
         case i_clrblock:
         case i_parmblock:
         case i_cmpblock:
+        case i_vector:
             ins->live = true;
             break;
         case i_jne:
@@ -509,14 +511,35 @@ static void markLiveInstruction(BRIGGS_SET* live, QUAD* ins)
         }
     }
 }
-void removeDead(BLOCK* b)
+/* the live instructions in a block only depend on its live out set, so the reachable
+ * blocks can be visited in any order and are done with a worklist
+ */
+static void markLiveBlock(BRIGGS_SET* live, BLOCK* b)
 {
-    static BRIGGS_SET* live;
     BITINT* p;
     int j, k;
     QUAD* tail;
+    briggsClear(live);
+    p = b->liveOut;
+    for (j = 0; j < (tempCount + BITINTBITS - 1) / BITINTBITS; j++, p++)
+        if (*p)
+            for (k = 0; k < BITINTBITS; k++)
+                if (*p & (1 << k))
+                {
+                    briggsSet(live, j * BITINTBITS + k);
+                }
+    tail = b->tail;
+    while (tail != b->head->back)
+    {
+        markLiveInstruction(live, tail);
+        tail = tail->back;
+    }
+}
+void removeDead(BLOCK* b)
+{
+    static BRIGGS_SET* live;
+    std::vector<BLOCK*> stack;
     BLOCKLIST* bl;
-    bool done = false;
     if (b == blockArray[0])
     {
         int i;
@@ -535,27 +558,22 @@ void removeDead(BLOCK* b)
             }
     }
     b->visiteddfst = true;
-    briggsClear(live);
-    p = b->liveOut;
-    for (j = 0; j < (tempCount + BITINTBITS - 1) / BITINTBITS; j++, p++)
-        if (*p)
-            for (k = 0; k < BITINTBITS; k++)
-                if (*p & (1 << k))
-                {
-                    briggsSet(live, j * BITINTBITS + k);
-                }
-    tail = b->tail;
-    while (tail != b->head->back)
+    stack.push_back(b);
+    while (!stack.empty())
     {
-        markLiveInstruction(live, tail);
-        tail = tail->back;
-    }
-    bl = b->succ;
-    while (bl)
-    {
-        if (!bl->block->visiteddfst)
-            removeDead(bl->block);
-        bl = bl->next;
+        BLOCK* b1 = stack.back();
+        stack.pop_back();
+        markLiveBlock(live, b1);
+        bl = b1->succ;
+        while (bl)
+        {
+            if (!bl->block->visiteddfst)
+            {
+                bl->block->visiteddfst = true;
+                stack.push_back(bl->block);
+            }
+            bl = bl->next;
+        }
     }
     if (b == blockArray[0])
     {
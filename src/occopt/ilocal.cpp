@@ -38,6 +38,7 @@
 #include "optmain.h"
 #include "ioptutil.h"
 #include "memory.h"
+#include "iconfl.h"
 
 void diag(const char* fmt, ...) {}
 
@@ -329,7 +330,7 @@ static int AllocTempOpt(int size1)
     }
     tempInfo[t]->enode = rv->offset;
     nextTemp = t;
-    tempInfo[t]->partition = t;
+    initPartition(t);
     tempInfo[t]->color = -1;
     tempInfo[t]->inUse = true;
     return t;
@@ -365,7 +366,7 @@ static void InitTempInfo(void)
     for (i = 0; i < tempCount; i++)
     {
         tempInfo[i] = oAllocate<TEMP_INFO>();
-        tempInfo[i]->partition = i;
+        initPartition(i);
         tempInfo[i]->color = -1;
         tempInfo[i]->inUse = true;
     }
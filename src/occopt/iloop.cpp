@@ -26,6 +26,8 @@
 #include <malloc.h>
 #include <string.h>
 #include <limits.h>
+#include <vector>
+#include <utility>
 #include "ioptimizer.h"
 #include "beinterfdefs.h"
 #include "Utils.h"
@@ -85,14 +87,22 @@ static void dump_loops(void)
 }
 static void findInfinite(BLOCK* b)
 {
-    if (!b->visiteddfst)
+    std::vector<BLOCK*> stack;
+    stack.push_back(b);
+    while (!stack.empty())
     {
-        BLOCKLIST* l = b->pred;
-        b->visiteddfst = true;
-        while (l)
+        b = stack.back();
+        stack.pop_back();
+        if (!b->visiteddfst)
         {
-            findInfinite(l->block);
-            l = l->next;
+            BLOCKLIST* l = b->pred;
+            b->visiteddfst = true;
+            while (l)
+            {
+                if (!l->block->visiteddfst)
+                    stack.push_back(l->block);
+                l = l->next;
+            }
         }
     }
 }
@@ -147,24 +157,22 @@ void CancelInfinite(int orgBlockCount)
 {
     int i;
     (void)orgBlockCount;
-    while (true)
+    for (i = 0; i < blockCount; i++)
     {
-        for (i = 0; i < blockCount; i++)
-        {
-            if (blockArray[i])
-                blockArray[i]->visiteddfst = false;
-        }
-        findInfinite(blockArray[exitBlock]);
-        for (i = exitBlock; i >= 0; i--)
+        if (blockArray[i])
+            blockArray[i]->visiteddfst = false;
+    }
+    findInfinite(blockArray[exitBlock]);
+    /* once a block has a thunk to the exit, everything that reaches it reaches the exit
+     * too, so only those blocks need marking rather than walking the whole graph again
+     */
+    for (i = exitBlock; i >= 0; i--)
+    {
+        if (blockArray[i] && !blockArray[i]->visiteddfst)
         {
-            if (blockArray[i] && !blockArray[i]->visiteddfst)
-            {
-                makeNonInfinite(blockArray[i]);
-                break;
-            }
+            makeNonInfinite(blockArray[i]);
+            findInfinite(blockArray[i]);
         }
-        if (i < 0)
-            break;
     }
 }
 void RemoveInfiniteThunks(void)
@@ -337,23 +345,37 @@ static void FindLoop(BLOCK* b)
         FindBody(loop, b, LT_SINGLE);
     }
 }
+/* depth first walk of the flowgraph, each block is handled after its successors.
+ * It uses an explicit stack since the path can be as long as the function
+ */
 static void Loop(BLOCK* b)
 {
-    BLOCKLIST* bl;
+    std::vector<std::pair<BLOCK*, BLOCKLIST*>> stack;
     if (b->visiteddfst)
         return;
-    bl = b->succ;
     b->visiteddfst = true;
-    while (bl)
-    {
-        Loop(bl->block);
-        bl = bl->next;
-    }
-    if (b->loopGenerators)
+    stack.push_back(std::make_pair(b, b->succ));
+    while (!stack.empty())
     {
-        FindBody(b->loopGenerators, b, LT_MULTI);
+        BLOCKLIST* bl = stack.back().second;
+        if (bl)
+        {
+            stack.back().second = bl->next;
+            if (!bl->block->visiteddfst)
+            {
+                bl->block->visiteddfst = true;
+                stack.push_back(std::make_pair(bl->block, bl->block->succ));
+            }
+            continue;
+        }
+        b = stack.back().first;
+        stack.pop_back();
+        if (b->loopGenerators)
+        {
+            FindBody(b->loopGenerators, b, LT_MULTI);
+        }
+        FindLoop(b);
     }
-    FindLoop(b);
 }
 static void CalculateLoopedBlocks(LOOP* l)
 {
@@ -593,7 +615,7 @@ static void CalculateLoopInvariants(BLOCK* b)
     }
 }
 static BRIGGS_SET* candidates;
-static unsigned short* inductionCandidateStack;
+static int* inductionCandidateStack;
 static int inductionCandidateStackTop;
 
 static void PruneInductionCandidate(int tnum, LOOP* l)
@@ -812,7 +834,7 @@ static void CalculateInductionCandidates(LOOP* l)
     }
 }
 static int max_dfs = 0;
-static unsigned short* strongStack;
+static int* strongStack;
 static int strongStackTop;
 LIST* strongRegiondfs(int tnum)
 {
@@ -903,7 +925,7 @@ static LIST* strongRegions(LOOP* lp, ILIST** anchors)
     QUAD* head;
     LIST* rv = nullptr;
     *anchors = nullptr;
-    strongStack = oAllocate<unsigned short>(tempCount);
+    strongStack = oAllocate<int>(tempCount);
     max_dfs = 0;
     strongStackTop = 0;
     for (i = 0; i < tempCount; i++)
@@ -938,7 +960,7 @@ static LIST* strongRegions(LOOP* lp, ILIST** anchors)
 void CalculateInduction(void)
 {
     int i;
-    inductionCandidateStack = oAllocate<unsigned short>(tempCount);
+    inductionCandidateStack = oAllocate<int>(tempCount);
 
     candidates = briggsAlloc(tempCount);
     CalculateLoopInvariants(blockArray[0]);
@@ -34,7 +34,6 @@
 #include "Utils.h"
 #include "SharedMemory.h"
 #include <deque>
-#include <functional>
 #include <unordered_map>
 #include <map>
 #include <set>
@@ -44,14 +43,14 @@ namespace Optimizer
 static std::list<std::string> textRegion;
 static std::unordered_map<std::string, int> cachedText;
 static size_t textOffset;
-static std::map<IMODE*, int> cachedImodes;
+static std::unordered_map<IMODE*, int> cachedImodes;
 static std::set<SimpleSymbol*> cachedAutos;
 static std::set<SimpleSymbol*> cachedTemps;
 
 static SharedMemory* sharedRegion;
 // the next are intended not to be reset on each read, as there will be another file streamed next
-static int outputPos;
-static int outputSize;
+static unsigned long long outputPos;
+static unsigned long long outputSize;
 static unsigned char* streamPointer;
 
 static size_t TextName(const std::string& name)
@@ -67,14 +66,17 @@ static size_t TextName(const std::string& name)
     cachedText[name] = rv;
     return rv;
 }
-static void resize(int size)
+static void grow()
+{
+    outputSize += sharedRegion->ViewWindowSize();
+    sharedRegion->EnsureCommitted(outputSize);
+    streamPointer = sharedRegion->GetMapping(outputPos);
+}
+// the mapping is moved forward a window at a time, so callers must not ask for more than half a window at once
+inline static void resize(int size)
 {
     if (outputPos + size > outputSize)
-    {
-        outputSize += sharedRegion->ViewWindowSize();
-        sharedRegion->EnsureCommitted(outputSize);
-        streamPointer = sharedRegion->GetMapping(outputPos);
-    }
+        grow();
 }
 inline static void StreamByte(int value)
 {
@@ -82,8 +84,8 @@ inline static void StreamByte(int value)
     streamPointer[outputPos++] = value;
 }
 inline static void StreamBlockType(int blockType, bool end) { StreamByte(blockType + (end ? 0x80 : 0x40)); }
-template <class T>
-inline static void StreamBlock(T blockType, std::function<void(void)> blockRenderer)
+template <class T, class F>
+inline static void StreamBlock(T blockType, F blockRenderer)
 {
     StreamBlockType(blockType, false);
     blockRenderer();
@@ -92,17 +94,21 @@ inline static void StreamBlock(T blockType, std::function<void(void)> blockRende
 
 inline static void StreamIndex(int value)
 {
+    resize(4);
+    unsigned char* p = streamPointer + outputPos;
     if (value >= 0 && value < 0x8000)
     {
-        StreamByte(value >> 8);
-        StreamByte(value);
+        p[0] = value >> 8;
+        p[1] = value;
+        outputPos += 2;
     }
     else
     {
-        StreamByte((value >> 24) | 0x80);
-        StreamByte(value >> 16);
-        StreamByte(value >> 8);
-        StreamByte(value >> 0);
+        p[0] = (value >> 24) | 0x80;
+        p[1] = value >> 16;
+        p[2] = value >> 8;
+        p[3] = value >> 0;
+        outputPos += 4;
     }
 }
 inline static void StreamTextIndex(const char* name)
@@ -112,11 +118,11 @@ inline static void StreamTextIndex(const char* name)
     else
         StreamIndex(TextName(name));
 }
+static void StreamBuffer(const void* buf, int len);
 inline static void StreamString(const std::string& value)
 {
     StreamIndex(value.size());
-    for (auto c : value)
-        StreamByte(c);
+    StreamBuffer(value.c_str(), value.size());
 }
 static void StreamStringList(const std::list<std::string>& list)
 {
@@ -126,16 +132,24 @@ static void StreamStringList(const std::list<std::string>& list)
 }
 static void StreamBuffer(const void* buf, int len)
 {
-    resize(len);
-    memcpy(&streamPointer[outputPos], buf, len);
-    outputPos += len;
+    int chunk = sharedRegion->ViewWindowSize() / 2;
+    while (len > 0)
+    {
+        int n = len < chunk ? len : chunk;
+        resize(n);
+        memcpy(&streamPointer[outputPos], buf, n);
+        outputPos += n;
+        buf = (const unsigned char*)buf + n;
+        len -= n;
+    }
 }
 inline static void StreamIntValue(const void* buf, int len)
 {
-    StreamBlock(STT_INT, [buf, len]() {
-        for (int i = len - 1; i >= 0; i--)
-            StreamByte(((unsigned char*)buf)[i]);
-    });
+    StreamBlockType(STT_INT, false);
+    resize(len);
+    for (int i = len - 1; i >= 0; i--)
+        streamPointer[outputPos++] = ((unsigned char*)buf)[i];
+    StreamBlockType(STT_INT, true);
 }
 static void StreamFloatValue(FPF& fv)
 {
@@ -475,6 +489,7 @@ static void StreamInstruction(QUAD* q)
                 case i_coswitch:
                 case i_goto:
                 case i_cmpblock:
+                case i_vector:
                     StreamIndex(q->dc.v.label);
                     // fallthrough
                 default:
@@ -849,15 +864,10 @@ static void StreamData()
                         StreamIndex(data->diff.l1);
                         StreamIndex(data->diff.l2);
                         break;
-                    case DT_STRING: {
-                        bool instring = false;
+                    case DT_STRING:
                         StreamIndex(data->astring.i);
-                        for (int i = 0; i < data->astring.i; i++)
-                        {
-                            StreamByte(data->astring.str[i]);
-                        }
-                    }
-                    break;
+                        StreamBuffer(data->astring.str, data->astring.i);
+                        break;
                     case DT_BIT:
                         break;
                     case DT_BOOL:
@@ -999,7 +1009,7 @@ static void NumberTypes()
     for (auto s : typedefs)
         s->typeIndex = s->fileIndex = 2 * i++ + 1;
 }
-int GetOutputSize() { return outputPos; }
+unsigned long long GetOutputSize() { return outputPos; }
 void OutputIntermediate(SharedMemory* mem)
 {
     sharedRegion = mem;
@@ -1021,11 +1031,11 @@ void OutputIntermediate(SharedMemory* mem)
 }
 void WriteMappingFile(SharedMemory* mem, FILE* fil)
 {
-    int pos = 0;
+    unsigned long long pos = 0;
     unsigned char* p = mem->GetMapping();
     while (outputPos > 0)
     {
-        int n = mem->ViewWindowSize();
+        unsigned n = mem->ViewWindowSize();
         if (outputPos < n)
             n = outputPos;
         fwrite(p + pos, n, 1, fil);
@@ -1034,4 +1044,14 @@ void WriteMappingFile(SharedMemory* mem, FILE* fil)
         p = mem->GetMapping(pos);
     }
 }
+// add an intermediate file written elsewhere to the end of the output, e.g. from an occparse
+// job that compiled some of the files
+void AppendMappingFile(SharedMemory* mem, FILE* fil)
+{
+    sharedRegion = mem;
+    unsigned char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fil)) > 0)
+        StreamBuffer(buf, n);
+}
 }  // namespace Optimizer
\ No newline at end of file
@@ -26,7 +26,8 @@
 namespace Optimizer
 {
 void WriteText(void);
-int GetOutputSize(void);
+unsigned long long GetOutputSize(void);
 void OutputIntermediate(SharedMemory* mem);
 void WriteMappingFile(SharedMemory* mem, FILE* fil);
+void AppendMappingFile(SharedMemory* mem, FILE* fil);
 }  // namespace Optimizer
\ No newline at end of file
@@ -35,7 +35,6 @@
 #include "../occ/winmode.h"
 #include "../occ/be.h"
 #include <deque>
-#include <functional>
 #include <map>
 #include <unordered_map>
 #include <stdexcept>
@@ -53,9 +52,9 @@ static std::vector<Optimizer::SimpleSymbol*> temps;
 
 static unsigned char* streamPointer;
 static SharedMemory* shared;
-static unsigned top;
+static unsigned long long top;
 
-static int
+static unsigned long long
     inputPos;  // it is not intended we ever reset this, as multiple files could be streamed one after the other and we are going to
 // read them in order
 inline void dothrow()
@@ -63,13 +62,15 @@ inline void dothrow()
     std::runtime_error e("");
     throw e;
 }
+static void slide()
+{
+    top += shared->ViewWindowSize();
+    streamPointer = shared->GetMapping(inputPos);
+}
 inline static int UnstreamByte()
 {
     if (inputPos >= top)
-    {
-        top += shared->ViewWindowSize();
-        streamPointer = shared->GetMapping(inputPos);
-    }
+        slide();
     return streamPointer[inputPos++];
 }
 inline static void UnstreamBlockType(int blockType, bool end)
@@ -81,8 +82,8 @@ inline static void UnstreamBlockType(int blockType, bool end)
         dothrow();
     }
 }
-template <class T>
-inline static void UnstreamBlock(T blockType, std::function<void(void)> blockRenderer)
+template <class T, class F>
+inline static void UnstreamBlock(T blockType, F blockRenderer)
 {
     UnstreamBlockType(blockType, false);
     blockRenderer();
@@ -91,6 +92,17 @@ inline static void UnstreamBlock(T blockType, std::function<void(void)> blockRen
 
 inline static int UnstreamIndex()
 {
+    if (inputPos + 4 <= top)
+    {
+        unsigned char* p = streamPointer + inputPos;
+        if (p[0] & 0x80)
+        {
+            inputPos += 4;
+            return ((p[0] & 0x7f) << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+        }
+        inputPos += 2;
+        return (p[0] << 8) | p[1];
+    }
     int value = UnstreamByte() << 8;
     value |= UnstreamByte();
     if (value & 0x8000)
@@ -103,12 +115,13 @@ inline static int UnstreamIndex()
     return value;
 }
 inline static int UnstreamTextIndex() { return UnstreamIndex(); }
+static void UnstreamBuffer(void* buf, int len);
 inline static void UnstreamString(std::string& value)
 {
     int v = UnstreamIndex();
     value.resize(v, 0);
-    for (auto&& c : value)
-        c = UnstreamByte();
+    if (v)
+        UnstreamBuffer(&value[0], v);
 }
 static void UnstreamStringList(std::list<std::string>& list)
 {
@@ -121,20 +134,27 @@ static void UnstreamStringList(std::list<std::string>& list)
 }
 static void UnstreamBuffer(void* buf, int len)
 {
-    if (inputPos + len >= top)
+    // the mapping only moves forward a window at a time, so copy in pieces that are known to fit
+    int chunk = shared->ViewWindowSize() / 2;
+    while (len > 0)
     {
-        top += shared->ViewWindowSize();
-        streamPointer = shared->GetMapping(inputPos);
+        int n = len < chunk ? len : chunk;
+        if (inputPos + n >= top)
+            slide();
+        memcpy(buf, &streamPointer[inputPos], n);
+        inputPos += n;
+        buf = (unsigned char*)buf + n;
+        len -= n;
     }
-    memcpy(buf, &streamPointer[inputPos], len);
-    inputPos += len;
 }
 inline static void UnstreamIntValue(void* buf, int len)
 {
-    UnstreamBlock(STT_INT, [buf, len]() {
-        for (int i = len - 1; i >= 0; i--)
-            ((unsigned char*)buf)[i] = UnstreamByte();
-    });
+    UnstreamBlockType(STT_INT, false);
+    if (inputPos + len >= top)
+        slide();
+    for (int i = len - 1; i >= 0; i--)
+        ((unsigned char*)buf)[i] = streamPointer[inputPos++];
+    UnstreamBlockType(STT_INT, true);
 }
 static void UnstreamFloatValue(FPF& fv)
 {
@@ -491,6 +511,7 @@ static Optimizer::QUAD* UnstreamInstruction(FunctionData& fd)
                 case i_coswitch:
                 case i_goto:
                 case i_cmpblock:
+                case i_vector:
                     rv->dc.v.label = UnstreamIndex();
                     // fallthrough
                 default:
@@ -809,16 +830,11 @@ static void UnstreamData()
                         data->diff.l1 = UnstreamIndex();
                         data->diff.l2 = UnstreamIndex();
                         break;
-                    case DT_STRING: {
-                        bool instring = false;
+                    case DT_STRING:
                         data->astring.i = UnstreamIndex();
                         data->astring.str = (char*)Alloc(data->astring.i + 1);
-                        for (int i = 0; i < data->astring.i; i++)
-                        {
-                            data->astring.str[i] = UnstreamByte();
-                        }
-                    }
-                    break;
+                        UnstreamBuffer(data->astring.str, data->astring.i);
+                        break;
                     case DT_BIT:
                         break;
                     case DT_BOOL:
@@ -1245,21 +1261,13 @@ bool InputIntermediate(SharedMemory* inputMem)
 }
 void ReadMappingFile(SharedMemory* mem, FILE* fil)
 {
-    int pos = 0;
-    fseek(fil, 0, SEEK_END);
-    int end = ftell(fil);
-    fseek(fil, 0, SEEK_SET);
+    // read a window at a time until the end of the file, the region grows to fit
+    unsigned long long pos = 0;
     unsigned char* p = mem->GetMapping();
-    mem->EnsureCommitted(end);
-    while (end > 0)
+    size_t n;
+    while (p && (n = fread(p + pos, 1, mem->ViewWindowSize(), fil)) > 0)
     {
-
-        int n = mem->ViewWindowSize();
-        if (n > end)
-            n = end;
-        fread(p + pos, n, 1, fil);
         pos += n;
-        end -= n;
         p = mem->GetMapping(pos);
     }
 }
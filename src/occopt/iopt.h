@@ -110,8 +110,8 @@ typedef BITINT BITARRAY;
 #define BLOCKLIST_VISITED 1
 typedef struct
 {
-    unsigned short* indexes;
-    unsigned short* data;
+    unsigned* indexes;
+    unsigned* data;
     int size;
     int top;
 } BRIGGS_SET;
@@ -236,7 +236,6 @@ typedef struct _uiv
 } UIV;
 typedef struct _aliasName
 {
-    struct _aliasName* next;
     LIST* addresses;
     int byUIV;
     union
@@ -248,7 +247,6 @@ typedef struct _aliasName
 
 typedef struct _aliasAddress
 {
-    struct _aliasAddress* next;
     struct _aliasAddress* merge;
     ALIASNAME* name;
     struct _aliaslist* pointsto;
@@ -265,7 +263,6 @@ typedef struct _aliaslist
 
 typedef struct _addrByName
 {
-    struct _addrByName* next;
     ALIASNAME* name;
     ALIASLIST* addresses;
 } ADDRBYNAME;
@@ -333,7 +330,9 @@ typedef struct
     int degree;
     int regCount;
     int color;
-    int partition;
+    int partition;     /* parent in the partition tree */
+    int partitionName; /* name of the partition, valid at the root of the tree */
+    int partitionRank;
     int dfstOrder;
     int temp;
     int inductionLoop; /* 0 = none, else outermost enclosing loop */
@@ -372,7 +371,7 @@ typedef struct _exceedPressure
 
 struct _block
 {
-    short blocknum;
+    int blocknum;
     /*        short dfstnum; */
     int critical : 1;
     int dead : 1;
@@ -383,8 +382,8 @@ struct _block
     int globalChanged : 1;
     int alwayslive : 1;
     short callcount;
-    short preWalk;
-    short postWalk;
+    int preWalk;
+    int postWalk;
     int temp;
     int idom;
     int pdom;
@@ -441,12 +440,21 @@ typedef struct _comgo
  * DAG structures
  */
 
-typedef struct _daglist
+// the key is the bytes of a quad or an IMODE pointer, compared by value
+struct DagKey
 {
-    struct _daglist* next;
-    UBYTE* key;
-    UBYTE* rv;
-} DAGLIST;
+    UBYTE* data;
+    int size;
+};
+struct DagTraits
+{
+    static unsigned Hash(const DagKey& key) { return HashBytes(key.data, key.size); }
+    static bool Equal(const DagKey& left, const DagKey& right)
+    {
+        return left.size == right.size && !memcmp(left.data, right.data, left.size);
+    }
+};
+typedef HashTable<DagKey, QUAD*, DagTraits> DAGHASH;
 
 typedef struct _list2
 {
@@ -31,7 +31,9 @@
 #include <unordered_map>
 #include <list>
 #include <vector>
+#include <cstring>
 #include "ctypes.h"
+#include "OptHash.h"
 #include <Floating.h>
 
 #define imax(x, y) ((x) > (y) ? (x) : (y))
@@ -420,7 +422,7 @@ struct ArgList
         i_kill_dependency, i_xchg,
         i_prologue, i_epilogue, i_pushcontext, i_popcontext, i_loadcontext, i_unloadcontext,
         i_tryblock, i_substack, i_parmstack, i_loadstack, i_savestack, i_functailstart, i_functailend,
-        i_gcsestub, i_expressiontag, i_tag, i_seh,
+        i_gcsestub, i_expressiontag, i_tag, i_seh, i_vector,
         /* msil */
         i__initblk, i__cpblk, i__initobj, i__sizeof,
         /* Dag- specific stuff */
@@ -600,7 +602,6 @@ typedef struct quad
 /*-------------------------------------------------------------------------*/
 
 #define DAGCOMPARE sizeof(struct Optimizer::_basic_dag)
-#define DAGSIZE 251
 
 /* constant node combinattions:
  * ic = prefix
@@ -656,16 +657,5 @@ typedef struct _storetemphash
     IMODE* mem;
     IMODE* temp;
 } STORETEMPHASH;
-
-typedef struct _casttemphash
-{
-    struct _casttemphash* next;
-    struct
-    {
-        IMODE* im;
-        int size;
-    } sf;
-    IMODE* rv;
-} CASTTEMPHASH;
 }  // namespace Optimizer
 #include "iopt.h"
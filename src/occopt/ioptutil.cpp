@@ -46,32 +46,32 @@ void BitInit(void)
 BRIGGS_SET* briggsAlloc(int size)
 {
     BRIGGS_SET* p = oAllocate<BRIGGS_SET>();
-    p->indexes = oAllocate<unsigned short>(size);
-    p->data = oAllocate<unsigned short>(size);
+    p->indexes = oAllocate<unsigned>(size);
+    p->data = oAllocate<unsigned>(size);
     p->size = size;
     return p;
 }
 BRIGGS_SET* briggsAlloct(int size)
 {
     BRIGGS_SET* p = tAllocate<BRIGGS_SET>();
-    p->indexes = tAllocate<unsigned short>(size);
-    p->data = tAllocate<unsigned short>(size);
+    p->indexes = tAllocate<unsigned>(size);
+    p->data = tAllocate<unsigned>(size);
     p->size = size;
     return p;
 }
 BRIGGS_SET* briggsAllocc(int size)
 {
     BRIGGS_SET* p = cAllocate<BRIGGS_SET>();
-    p->indexes = cAllocate<unsigned short>(size);
-    p->data = cAllocate<unsigned short>(size);
+    p->indexes = cAllocate<unsigned>(size);
+    p->data = cAllocate<unsigned>(size);
     p->size = size;
     return p;
 }
 BRIGGS_SET* briggsAllocs(int size)
 {
     BRIGGS_SET* p = sAllocate<BRIGGS_SET>();
-    p->indexes = sAllocate<unsigned short>(size);
-    p->data = sAllocate<unsigned short>(size);
+    p->indexes = sAllocate<unsigned>(size);
+    p->data = sAllocate<unsigned>(size);
     p->size = size;
     return p;
 }
@@ -129,10 +129,10 @@ int briggsReset(BRIGGS_SET* p, int index)
 }
 int briggsTest(BRIGGS_SET* p, int index)
 {
-    int i = p->indexes[index];
+    unsigned i = p->indexes[index];
     if (index >= p->size || index < 0)
         diag("briggsTest: out of bounds");
-    if (i >= p->top)
+    if (i >= (unsigned)p->top)
         return 0;
     return p->data[i] == index;
 }
@@ -666,6 +666,49 @@ static void iop_gcsestub(Optimizer::QUAD* q) { oprintf(icdFile, "\tGCSE"); }
 static void iop_expressiontag(Optimizer::QUAD* q) { oprintf(icdFile, "\tEXPR TAG\t%d", q->dc.v.label); }
 static void iop_tag(Optimizer::QUAD* q) { oprintf(icdFile, "\tTAG"); }
 static void iop_seh(Optimizer::QUAD* q) { oprintf(icdFile, "\tSEH %d", q->sehMode); }
+static void iop_vector(Optimizer::QUAD* q)
+{
+    const char* str;
+    switch (q->dc.v.label)
+    {
+        case i_add:
+            str = "+";
+            break;
+        case i_sub:
+            str = "-";
+            break;
+        case i_mul:
+            str = "*";
+            break;
+        case i_sdiv:
+            str = "S/";
+            break;
+        case i_udiv:
+            str = "U/";
+            break;
+        case i_and:
+            str = "&";
+            break;
+        case i_or:
+            str = "|";
+            break;
+        case i_eor:
+            str = "^";
+            break;
+        default:
+            str = "";
+            break;
+    }
+    oputc('\t', icdFile);
+    putamode(q, q->ans);
+    oprintf(icdFile, " = VECTOR ");
+    putamode(q, q->dc.left);
+    if (q->dc.right)
+    {
+        oprintf(icdFile, " %s ", str);
+        putamode(q, q->dc.right);
+    }
+}
 static void iop_atomic_thread_fence(Optimizer::QUAD* q)
 {
     oprintf(icdFile, "\tATOMIC THREAD FENCE");
@@ -853,6 +896,7 @@ static void (*oplst[])(Optimizer::QUAD* q) = {
     iop_expressiontag,
     iop_tag,
     iop_seh,
+    iop_vector,
     iop_initblk,
     iop_cpblk,
     iop_initobj,
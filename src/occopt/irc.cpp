@@ -78,7 +78,7 @@ static int tempStackcount;
 static int lc_maxauto;
 static unsigned long long regmask;
 static int localspill, spillcount;
-static unsigned short* simplifyWorklist;
+static int* simplifyWorklist;
 static int simplifyBottom, simplifyTop;
 static BRIGGS_SET* freezeWorklist;
 static BRIGGS_SET* spillWorklist;
@@ -909,23 +909,9 @@ static int fsizeFromISZ(int sz)
         n += 100;
     return n;
 }
-static void Build(BLOCK* b)
+static void BuildBlock(BLOCK* b)
 {
-    QUAD* head;
-    BLOCKLIST* bl;
-    int i;
-    if (b == nullptr)
-    {
-        for (i = 0; i < tempCount; i++)
-        {
-            TEMP_INFO* t = tempInfo[i];
-            t->workingMoves = nullptr;
-            t->spillCost = 0;
-            t->temp = 0;
-        }
-        b = blockArray[0];
-    }
-    head = b->head;
+    QUAD* head = b->head;
     while (head != b->tail)
     {
         if (head->dc.opcode == i_assn)
@@ -1005,11 +991,34 @@ static void Build(BLOCK* b)
         }
         head = head->fwd;
     }
-    bl = b->dominates;
-    while (bl)
+}
+/* the blocks are visited in preorder on the dominator tree, using an explicit stack since
+ * the tree can be as deep as the function is long
+ */
+static void Build(void)
+{
+    std::vector<BLOCKLIST*> stack;
+    int i;
+    for (i = 0; i < tempCount; i++)
+    {
+        TEMP_INFO* t = tempInfo[i];
+        t->workingMoves = nullptr;
+        t->spillCost = 0;
+        t->temp = 0;
+    }
+    BuildBlock(blockArray[0]);
+    stack.push_back(blockArray[0]->dominates);
+    while (!stack.empty())
     {
-        Build(bl->block);
-        bl = bl->next;
+        BLOCKLIST* bl = stack.back();
+        if (!bl)
+        {
+            stack.pop_back();
+            continue;
+        }
+        stack.back() = bl->next;
+        BuildBlock(bl->block);
+        stack.push_back(bl->block->dominates);
     }
 }
 static void Adjacent(int n)
@@ -1207,7 +1216,7 @@ static int Combine(int u, int v)
     else
         briggsReset(spillWorklist, v);
     setbit(coalescedNodes, v);
-    tempInfo[v]->partition = u;
+    joinPartition(u, v);
     // assumes that the more stringent set has less elements
     if (tempInfo[v]->liveAcrossFunctionCall)
     {
@@ -2189,7 +2198,7 @@ static void KeepCoalescedNodes(void)
     bitarrayClear(coalescedNodes, tempCount);
     bitarrayClear(coalescedMoves, instructionCount);
     for (i = 0; i < tempCount; i++)
-        tempInfo[i]->partition = i;
+        initPartition(i);
 }
 static int LoopNesting(LOOP* loop)
 {
@@ -2240,10 +2249,9 @@ void Precolor(bool optimized)
 }
 void retemp(void)
 {
-    unsigned short map[65536];
+    std::vector<int> map(tempCount);
     int i, cur = 0;
     QUAD* head;
-    memset(map, 0, sizeof(map));
     for (i = 0; i < tempCount; i++)
     {
         tempInfo[i]->inUse = false;
@@ -2369,12 +2377,12 @@ void AllocateRegisters(QUAD* head)
                     tempInfo[i]->enode->sp->regmode = 0;
             }
             tempInfo[i]->workingMoves = nullptr;
-            tempInfo[i]->partition = i;
+            initPartition(i);
         }
         CountInstructions(first);
         simplifyBottom = simplifyTop = 0;
         tempCount += 3000;
-        simplifyWorklist = tAllocate<unsigned short>(tempCount);
+        simplifyWorklist = tAllocate<int>(tempCount);
         freezeWorklist = briggsAlloct(tempCount);
         spillWorklist = briggsAlloct(tempCount);
         spilledNodes = briggsAlloct(tempCount);
@@ -2391,7 +2399,7 @@ void AllocateRegisters(QUAD* head)
         usesInfo();
         CalculateConflictGraph(nullptr, true);
         SqueezeInit();
-        Build(nullptr);
+        Build();
         MkWorklist();
         for (i = 0; i < tempCount; i++)
         {
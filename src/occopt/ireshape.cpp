@@ -370,16 +370,7 @@ static void ApplyDistribution(void)
             done = true;
     }
 }
-void ReplaceHashReshape(QUAD* rv, UBYTE* key, int size, DAGLIST** table)
-{
-    int hashval = dhash(key, size);
-    DAGLIST* newDag;
-    newDag = tAllocate<DAGLIST>();
-    newDag->rv = (UBYTE*)rv;
-    newDag->key = key;
-    newDag->next = table[hashval];
-    table[hashval] = newDag;
-}
+void ReplaceHashReshape(QUAD* rv, UBYTE* key, int size, DAGHASH& table) { table.Push(DagKey{key, size}, rv); }
 static void replaceIM(IMODE** iml, IMODE* im)
 {
     if ((*iml)->mode == i_immed)
@@ -797,10 +788,8 @@ static void RewriteInvariantExpressions(BLOCK* b)
 {
     BLOCKLIST* bl = b->dominates;
     int i;
-    DAGLIST* old_ins_hash[DAGSIZE];
-    DAGLIST* old_name_hash[DAGSIZE];
-    memcpy(old_ins_hash, ins_hash, sizeof(DAGLIST*) * DAGSIZE);
-    memcpy(old_name_hash, name_hash, sizeof(DAGLIST*) * DAGSIZE);
+    size_t insScope = ins_hash.BeginScope();
+    size_t nameScope = name_hash.BeginScope();
     for (i = 0; i < cachedTempCount; i++)
     {
         if (tempInfo[i]->expressionRoot && tempInfo[i]->size < ISZ_FLOAT && tempInfo[i]->instructionDefines->block == b)
@@ -832,8 +821,8 @@ static void RewriteInvariantExpressions(BLOCK* b)
         RewriteInvariantExpressions(bl->block);
         bl = bl->next;
     }
-    memcpy(ins_hash, old_ins_hash, sizeof(DAGLIST*) * DAGSIZE);
-    memcpy(name_hash, old_name_hash, sizeof(DAGLIST*) * DAGSIZE);
+    ins_hash.EndScope(insScope);
+    name_hash.EndScope(nameScope);
 }
 void RewriteInnerExpressions(void)
 {
@@ -871,8 +860,8 @@ void Reshape(void)
     CalculateInduction();
     CreateExpressionLists();
     ApplyDistribution(); /* assumes the lists are already sorted */
-    memset(name_hash, 0, sizeof(name_hash));
-    memset(ins_hash, 0, sizeof(ins_hash));
+    name_hash.Clear();
+    ins_hash.Clear();
     RewriteInvariantExpressions(blockArray[0]);
     RewriteInnerExpressions();
 #ifdef XXXXX
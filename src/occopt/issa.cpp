@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include <malloc.h>
 #include <string.h>
+#include <vector>
 #include "ioptimizer.h"
 #include "beinterfdefs.h"
 #include "config.h"
@@ -55,16 +56,25 @@ namespace Optimizer
 
 /* don't make this too large, we are stacking a copy... */
 static bool changed;
-static LIST* savedDag;
 
 IMODE *trueName, *falseName;
 
-void SSAInit(void) { savedDag = nullptr; }
+void SSAInit(void) {}
+/*
+ * a phi is only useful where the temp is live, and doesn't do anything in a block
+ * with a single predecessor
+ */
+static bool needsPhi(BLOCK* b, int tnum) { return isset(b->liveIn, tnum) && b->pred && b->pred->next; }
 /*
  * this is an internal calculation needed to locate where to put PHI nodes
+ *
+ * with pruned SSA the frontier of a block is only followed if the temp is live
+ * into it, since a block where it is dead won't get a phi and so doesn't define
+ * it.   That stops the walk early for temps with short lifetimes.
  */
-static void DominancePrime(BLOCK* workList[], BRIGGS_SET* dest, BLOCKLIST* src)
+static void DominancePrime(BLOCK* workList[], BRIGGS_SET* dest, BLOCKLIST* src, int tnum)
 {
+    bool pruned = !!(cparams.optimizer_modules & OPT_PRUNEDSSA);
     int top = 0;
     while (src)
     {
@@ -84,7 +94,8 @@ static void DominancePrime(BLOCK* workList[], BRIGGS_SET* dest, BLOCKLIST* src)
             if (!briggsTest(dest, d->block->blocknum))
             {
                 briggsSet(dest, d->block->blocknum);
-                workList[top++] = d->block;
+                if (!pruned || isset(d->block->liveIn, tnum))
+                    workList[top++] = d->block;
             }
             d = d->next;
         }
@@ -148,19 +159,12 @@ static void insertPhiNodes(void)
             int j;
             entry->next = (BLOCKLIST*)tempInfo[i]->bdefines;
             briggsClear(bset);
-            DominancePrime(workList, bset, entry);
+            DominancePrime(workList, bset, entry, i);
             for (j = 0; j < bset->top; j++)
             {
                 BLOCK* b = blockArray[bset->data[j]];
-                if (b)
-                {
-                    if (isset(b->liveIn, i))
-                    {
-                        /* avoid phi ops which are essentially assigns */
-                        if (b->pred && b->pred->next)
-                            insertPhiOp(b, i);
-                    }
-                }
+                if (b && needsPhi(b, i))
+                    insertPhiOp(b, i);
             }
         }
     }
@@ -220,64 +224,16 @@ static IMODE* renameTemp(BLOCK* b, QUAD* head, IMODE* adr)
     }
     return im;
 }
-static void RemoveName(int i)
-{
-    IMODE* key = tempInfo[i]->enode->sp->imvalue;
-    int hashval = dhash((UBYTE*)&key, sizeof(void*));
-    DAGLIST* list = name_hash[hashval];
-    while (list)
-    {
-        if (list->key && !memcmp(key, list->key, sizeof(void*)))
-        {
-            memset(list->key, 0, sizeof(void*));
-            list->rv = nullptr;
-        }
-        list = list->next;
-    }
-}
-static DAGLIST* InsertHash(QUAD* rv, UBYTE* key, int size, DAGLIST** table)
-{
-    int hashval = dhash(key, size);
-    DAGLIST* newDag;
-    newDag = oAllocate<DAGLIST>();
-    newDag->rv = (UBYTE*)rv;
-    newDag->key = key;
-    newDag->next = *table;
-    *table = newDag;
-    return newDag;
-}
-DAGLIST** getSavedDAG(void)
-{
-    if (savedDag)
-    {
-        DAGLIST** rv = (DAGLIST**)savedDag;
-        savedDag = (LIST*)rv[0];
-        return rv;
-    }
-    return Allocate<DAGLIST*>(DAGSIZE);
-}
-void releaseSavedDAG(DAGLIST** dag)
-{
-    dag[0] = (DAGLIST*)savedDag;
-    savedDag = (LIST*)dag;
-}
 /*
  * after the phi nodes are in place, we start renaming all related temps
- * accordingly
+ * accordingly.  This is the part of the renaming done on the way down the
+ * dominator tree
  */
-static void renameToPhi(BLOCK* b)
+static void renameBlock(BLOCK* b)
 {
-    QUAD *head = b->head, *tail;
+    QUAD* head = b->head;
     BLOCKLIST* bl;
     bool done = false;
-    DAGLIST** saved_ins = getSavedDAG();
-    DAGLIST** saved_name = getSavedDAG();
-    if (b->visiteddfst)
-        return;
-    b->visiteddfst = true;
-
-    memcpy(saved_ins, ins_hash, sizeof(ins_hash));
-    memcpy(saved_name, name_hash, sizeof(name_hash));
     /* go through the code in the block in forward order */
     while (!done)
     {
@@ -421,22 +377,15 @@ static void renameToPhi(BLOCK* b)
         }
         bl = bl->next;
     }
-
-    /* now go through all the blocks we immediately dominate and process them
-     */
-    bl = b->dominates;
-    /* when we get here, we simply process any remaining blocks */
-    while (bl)
-    {
-        renameToPhi(bl->block);
-        bl = bl->next;
-    }
-    /* ok now we've evaluated all the dependencies, go through and finish
-     * renaming the answers, and also release anything we have put on the
-     * temporary stacks
-     */
-    tail = b->tail;
-    done = false;
+}
+/* ok now we've evaluated all the dependencies, go through and finish
+ * renaming the answers, and also release anything we have put on the
+ * temporary stacks
+ */
+static void unrenameBlock(BLOCK* b)
+{
+    QUAD* tail = b->tail;
+    bool done = false;
     while (!done)
     {
         /* if it is an i_nop get rid of it
@@ -503,21 +452,62 @@ static void renameToPhi(BLOCK* b)
             q = q->fwd;
         }
     }
-    memcpy(ins_hash, saved_ins, sizeof(ins_hash));
-    memcpy(name_hash, saved_name, sizeof(name_hash));
-    releaseSavedDAG(saved_ins);
-    releaseSavedDAG(saved_name);
+}
+/* walk the dominator tree, each block is renamed before the blocks it dominates
+ * and its names are released after them.   This uses an explicit stack as the
+ * tree can be very deep in large functions
+ */
+struct RenameFrame
+{
+    BLOCK* block;
+    BLOCKLIST* next;
+    size_t insScope, nameScope;
+};
+static void renameToPhi(BLOCK* start)
+{
+    std::vector<RenameFrame> stack;
+    BLOCK* b = start;
+    while (true)
+    {
+        if (b && !b->visiteddfst)
+        {
+            b->visiteddfst = true;
+            RenameFrame frame;
+            frame.block = b;
+            frame.next = b->dominates;
+            frame.insScope = ins_hash.BeginScope();
+            frame.nameScope = name_hash.BeginScope();
+            renameBlock(b);
+            stack.push_back(frame);
+        }
+        if (stack.empty())
+            break;
+        RenameFrame& top = stack.back();
+        if (top.next)
+        {
+            b = top.next->block;
+            top.next = top.next->next;
+        }
+        else
+        {
+            unrenameBlock(top.block);
+            ins_hash.EndScope(top.insScope);
+            name_hash.EndScope(top.nameScope);
+            stack.pop_back();
+            b = nullptr;
+        }
+    }
 }
 void TranslateToSSA(void)
 {
     int i;
-    memset(name_hash, 0, sizeof(void*) * DAGSIZE);
-    memset(ins_hash, 0, sizeof(void*) * DAGSIZE);
+    name_hash.Clear();
+    ins_hash.Clear();
     for (i = 0; i < tempCount; i++)
     {
         tempInfo[i]->preSSATemp = -1;
         tempInfo[i]->postSSATemp = -1;
-        tempInfo[i]->partition = i;
+        initPartition(i);
         tempInfo[i]->instructionDefines = nullptr;
         tempInfo[i]->instructionUses = nullptr;
         tempInfo[i]->renameStack = nullptr;
@@ -597,7 +587,7 @@ static void mergePartition(int tnew, int told)
         }
     }
     JoinConflictLists(told, tnew);
-    tempInfo[told]->partition = tnew;
+    joinPartition(tnew, told);
     changed = true;
 }
 static void convergeCriticals(void)
@@ -918,23 +908,41 @@ static void BuildAuxGraph(BLOCK* b, int which, BRIGGS_SET* nodes)
             head = head->fwd;
     }
 }
+/* the two walks of the auxiliary graph use explicit stacks, one entry per temp
+ * being visited along with the next edge to follow from it
+ */
+struct ElimFrame
+{
+    int T;
+    ILIST* next;
+};
 static void ElimForward(BRIGGS_SET* visited, ILIST** stack, int T)
 {
-    ILIST* l = tempInfo[T]->elimSuccessors;
+    std::vector<ElimFrame> walk;
     briggsSet(visited, T);
-    while (l)
+    walk.push_back(ElimFrame{T, tempInfo[T]->elimSuccessors});
+    while (!walk.empty())
     {
-        int n = (int)l->data;
-        if (!briggsTest(visited, n))
+        ElimFrame& top = walk.back();
+        if (top.next)
+        {
+            int n = (int)top.next->data;
+            top.next = top.next->next;
+            if (!briggsTest(visited, n))
+            {
+                briggsSet(visited, n);
+                walk.push_back(ElimFrame{n, tempInfo[n]->elimSuccessors});
+            }
+        }
+        else
         {
-            ElimForward(visited, stack, n);
+            ILIST* l = oAllocate<ILIST>();
+            l->data = top.T;
+            l->next = *stack;
+            *stack = l;
+            walk.pop_back();
         }
-        l = l->next;
     }
-    l = oAllocate<ILIST>();
-    l->data = T;
-    l->next = *stack;
-    *stack = l;
 }
 static bool unvisitedPredecessor(BRIGGS_SET* visited, int T)
 {
@@ -949,18 +957,30 @@ static bool unvisitedPredecessor(BRIGGS_SET* visited, int T)
 }
 static void ElimBackward(BRIGGS_SET* visited, BLOCK* pred, int T, bool all)
 {
-    ILIST* l;
+    std::vector<ElimFrame> walk;
     briggsSet(visited, T);
-    l = tempInfo[T]->elimPredecessors;
-    while (l)
+    walk.push_back(ElimFrame{T, tempInfo[T]->elimPredecessors});
+    while (!walk.empty())
     {
-        int p = l->data;
-        if (!briggsTest(visited, p))
+        ElimFrame& top = walk.back();
+        if (top.next)
+        {
+            int p = top.next->data;
+            top.next = top.next->next;
+            if (!briggsTest(visited, p))
+            {
+                briggsSet(visited, p);
+                walk.push_back(ElimFrame{p, tempInfo[p]->elimPredecessors});
+            }
+        }
+        else
         {
-            ElimBackward(visited, pred, p, all);
-            copyInstruction(pred, p, T, all);
+            int p = top.T;
+            walk.pop_back();
+            /* copy into each predecessor once everything feeding it has been copied */
+            if (!walk.empty())
+                copyInstruction(pred, p, walk.back().T, all);
         }
-        l = l->next;
     }
 }
 static void CreateCopy(BRIGGS_SET* visited, BLOCK* pred, int T, bool all)
@@ -1034,7 +1054,7 @@ static void cancelPartition(void)
     for (i = 0; i < tempCount; i++)
     {
         if (tempInfo[i]->preSSATemp < 0)
-            tempInfo[tempInfo[i]->partition]->preSSATemp = -1;
+            tempInfo[findPartition(i)]->preSSATemp = -1;
     }
 }
 void TranslateFromSSA(bool all)
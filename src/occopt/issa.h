@@ -28,8 +28,6 @@ namespace Optimizer
 extern IMODE *trueName, *falseName;
 
 void SSAInit(void);
-DAGLIST** getSavedDAG(void);
-void releaseSavedDAG(DAGLIST** dag);
 void TranslateToSSA(void);
 void TranslateFromSSA(bool all);
 }  // namespace Optimizer
\ No newline at end of file
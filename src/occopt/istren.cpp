@@ -718,7 +718,7 @@ void ReduceLoopStrength(void)
 {
     loadTemps.clear();
     int i;
-    memset(ins_hash, 0, sizeof(ins_hash));
+    ins_hash.Clear();
     CalculateInduction();
     ScanStrength();
     for (i = 0; i < blockCount; i++)
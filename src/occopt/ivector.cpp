@@ -0,0 +1,795 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include "ioptimizer.h"
+#include "beinterfdefs.h"
+#include "iblock.h"
+#include "ildata.h"
+#include "ilive.h"
+#include "ilocal.h"
+#include "OptUtils.h"
+#include "ioptutil.h"
+#include "optmain.h"
+#include "OptHash.h"
+#include "memory.h"
+#include "ivector.h"
+
+/* loop vectorization
+ *
+ * we look for innermost loops that have been reduced to the form
+ *
+ *     for (i = start; i < n; i++)
+ *         a[i] = b[i] op c[i];
+ *
+ * or a plain a[i] = b[i] copy, where all the elements are the same size and the
+ * operation has a packed SSE2 equivalent.   The arrays may be addressed either
+ * directly or through pointers that don't change inside the loop.
+ *
+ * The store may not overlap the loads at a different index; this is decided from
+ * the points-to sets left by the alias analysis, or from 'restrict' on the pointers.
+ *
+ * such a loop gets a second loop placed in front of it, which moves 16 bytes
+ * per iteration with an i_vector instruction.  The original loop is left alone and
+ * runs whatever iterations are left over; if none are left it is skipped.
+ *
+ * this runs after global optimization, when we are out of SSA form and the loop is
+ * a chain of blocks from the head to a latch which branches back to the head.
+ * The blocks are walked in order and each temporary is evaluated symbolically; anything
+ * that isn't part of the pattern, e.g. a call or a store to another location, stops
+ * the loop from being vectorized.
+ *
+ * the alias information is still around at this point, and since the i_vector instruction
+ * is created after the lazy optimizer runs it doesn't have to know about it.
+ */
+namespace Optimizer
+{
+#define VECTOR_BYTES 16
+
+enum e_vkind
+{
+    vk_invariant,
+    vk_index,
+    vk_next,
+    vk_scaled,
+    vk_address,
+    vk_data
+};
+
+struct VectorValue
+{
+    e_vkind kind;
+    IMODE* base;     /* invariant value, or the base of an address */
+    int shift;       /* log2 of the scale applied to the index */
+    int left, right; /* loads making up the data, right is -1 for a plain load */
+    enum i_ops op;   /* operation on the data, i_nop for a plain load */
+    bool converted;  /* data went through an integer size conversion */
+};
+
+struct VectorAccess
+{
+    IMODE* base;    /* address of element zero */
+    IMODE* mem;     /* the memory reference in the original loop */
+    IMODE* pointer; /* pointer walking the array in the vector loop */
+};
+
+struct VectorLoop
+{
+    BLOCK *preheader, *head, *latch, *exit;
+    IMODE* index;
+    IMODE* bound;
+    int size;
+    int shift;
+    enum i_ops op;
+    int left, right;
+    VectorAccess store;
+    std::vector<VectorAccess> loads;
+};
+
+static HashTable<int, VectorValue> values("vectorValues");
+static HashTable<int, int> definitions("vectorDefines");
+
+static bool IsTemp(IMODE* im)
+{
+    return im->mode == i_direct && im->offset && im->offset->type == se_tempref && !im->bits && !im->vol && !im->retval;
+}
+static bool IsIntSize(int size)
+{
+    if (size < 0)
+        size = -size;
+    return size >= ISZ_UCHAR && size <= ISZ_ULONGLONG && size != ISZ_BOOLEAN;
+}
+static bool IsFloatSize(int size) { return size == ISZ_FLOAT || size == ISZ_DOUBLE; }
+static int Log2(int n)
+{
+    switch (n)
+    {
+        case 1:
+            return 0;
+        case 2:
+            return 1;
+        case 4:
+            return 2;
+        case 8:
+            return 3;
+        default:
+            return -1;
+    }
+}
+static bool ConstantValue(IMODE* im, long long* val)
+{
+    if (im->mode == i_immed && isintconst(im->offset))
+    {
+        *val = im->offset->i;
+        return true;
+    }
+    return false;
+}
+static bool Evaluate(IMODE* im, int* index, VectorValue* rv)
+{
+    memset(rv, 0, sizeof(*rv));
+    if (im->mode == i_immed)
+    {
+        rv->kind = vk_invariant;
+        rv->base = im;
+        return true;
+    }
+    if (!IsTemp(im))
+        return false;
+    int t = im->offset->sp->i;
+    VectorValue* v = values.Find(t);
+    if (v)
+    {
+        *rv = *v;
+        return true;
+    }
+    if (!definitions.Find(t))
+    {
+        rv->kind = vk_invariant;
+        rv->base = im;
+        return true;
+    }
+    // read before it is written, so the value is carried around the loop.  The only
+    // such temp allowed is the index
+    if (*index == -1)
+        *index = t;
+    if (*index != t)
+        return false;
+    rv->kind = vk_index;
+    return true;
+}
+static bool Access(VectorLoop& loop, IMODE* mem, int* index, VectorAccess* rv)
+{
+    VectorValue v;
+    if (mem->offset2 || mem->bits || mem->vol || mem->offset->type != se_tempref)
+        return false;
+    IMODE* ptr = tempInfo[mem->offset->sp->i]->enode->sp->imvalue;
+    if (!Evaluate(ptr, index, &v) || v.kind != vk_address)
+        return false;
+    if (loop.size == 0)
+    {
+        loop.size = mem->size;
+        loop.shift = v.shift;
+    }
+    if (sizeFromISZ(mem->size) != sizeFromISZ(loop.size) || IsFloatSize(mem->size) != IsFloatSize(loop.size) ||
+        v.shift != loop.shift)
+        return false;
+    rv->base = v.base;
+    rv->mem = mem;
+    rv->pointer = nullptr;
+    return true;
+}
+static bool Load(VectorLoop& loop, IMODE* mem, int* index, VectorValue* rv)
+{
+    VectorAccess access;
+    if (!Access(loop, mem, index, &access) || loop.loads.size() == 2)
+        return false;
+    memset(rv, 0, sizeof(*rv));
+    rv->kind = vk_data;
+    rv->left = loop.loads.size();
+    rv->right = -1;
+    rv->op = i_nop;
+    loop.loads.push_back(access);
+    return true;
+}
+static bool Combine(QUAD* head, VectorValue& left, VectorValue& right, VectorValue* rv)
+{
+    memset(rv, 0, sizeof(*rv));
+    long long n;
+    switch (head->dc.opcode)
+    {
+        case i_add:
+            if (left.kind == vk_invariant && right.kind != vk_invariant)
+                return Combine(head, right, left, rv);
+            if (left.kind == vk_index && right.kind == vk_invariant && ConstantValue(right.base, &n) && n == 1)
+            {
+                rv->kind = vk_next;
+                return true;
+            }
+            // byte arrays are indexed without scaling
+            if ((left.kind == vk_scaled || left.kind == vk_index) && right.kind == vk_invariant &&
+                !ConstantValue(right.base, &n))
+            {
+                rv->kind = vk_address;
+                rv->base = right.base;
+                rv->shift = left.kind == vk_scaled ? left.shift : 0;
+                return true;
+            }
+            break;
+        case i_lsl:
+            if (left.kind == vk_index && right.kind == vk_invariant && ConstantValue(right.base, &n) && n >= 0 && n <= 3)
+            {
+                rv->kind = vk_scaled;
+                rv->shift = n;
+                return true;
+            }
+            return false;
+        case i_mul:
+            if (left.kind == vk_invariant && right.kind == vk_index)
+                return Combine(head, right, left, rv);
+            if (left.kind == vk_index && right.kind == vk_invariant && ConstantValue(right.base, &n) && Log2(n) >= 0)
+            {
+                rv->kind = vk_scaled;
+                rv->shift = Log2(n);
+                return true;
+            }
+            break;
+        case i_sub:
+        case i_and:
+        case i_or:
+        case i_eor:
+        case i_sdiv:
+        case i_udiv:
+            break;
+        default:
+            return false;
+    }
+    // operations on the data only go one level deep, so they map onto one packed instruction
+    if (left.kind != vk_data || right.kind != vk_data || left.op != i_nop || right.op != i_nop)
+        return false;
+    rv->kind = vk_data;
+    rv->left = left.left;
+    rv->right = right.left;
+    rv->op = head->dc.opcode;
+    rv->converted = left.converted || right.converted;
+    return true;
+}
+static bool Step(VectorLoop& loop, QUAD* head, int* index, VectorValue* stored)
+{
+    VectorValue left, right, result;
+    if (head->isvolatile || head->atomic || (head->ans && (head->ans->vol || head->ans->bits)))
+        return false;
+    switch (head->dc.opcode)
+    {
+        case i_block:
+        case i_blockend:
+        case i_label:
+        case i_line:
+        case i_dbgblock:
+        case i_dbgblockend:
+        case i_nop:
+            return true;
+        case i_assn:
+            if (head->dc.left->mode == i_ind)
+            {
+                if (!Load(loop, head->dc.left, index, &left))
+                    return false;
+            }
+            else if (!Evaluate(head->dc.left, index, &left))
+            {
+                return false;
+            }
+            if (sizeFromISZ(head->ans->size) != sizeFromISZ(head->dc.left->size) ||
+                IsFloatSize(head->ans->size) != IsFloatSize(head->dc.left->size))
+            {
+                // wrapping integer operations give the same low bits whatever size they are done in
+                if (left.kind != vk_data || !IsIntSize(head->ans->size) || !IsIntSize(head->dc.left->size))
+                    return false;
+                left.converted = true;
+            }
+            if (head->ans->mode == i_ind)
+            {
+                if (left.kind != vk_data || stored->kind == vk_data ||
+                    !Access(loop, head->ans, index, &loop.store))
+                    return false;
+                *stored = left;
+                return true;
+            }
+            result = left;
+            break;
+        case i_add:
+        case i_sub:
+        case i_mul:
+        case i_lsl:
+        case i_and:
+        case i_or:
+        case i_eor:
+        case i_sdiv:
+        case i_udiv:
+            if (head->ans->mode != i_direct || head->dc.left->mode == i_ind || head->dc.right->mode == i_ind)
+                return false;
+            if (!Evaluate(head->dc.left, index, &left) || !Evaluate(head->dc.right, index, &right) ||
+                !Combine(head, left, right, &result))
+                return false;
+            break;
+        default:
+            return false;
+    }
+    if (!IsTemp(head->ans))
+        return false;
+    int t = head->ans->offset->sp->i;
+    if (t == *index || (*index == -1 && result.kind == vk_next))
+    {
+        // the one update of the index
+        VectorValue* v = values.Find(t);
+        if (result.kind != vk_next || (v && v->kind == vk_next) || !IsIntSize(head->ans->size) ||
+            sizeFromISZ(head->ans->size) != sizeFromISZ(ISZ_UINT))
+            return false;
+        if (*index == -1)
+            return false;
+        loop.index = head->ans;
+    }
+    values.Set(t, result);
+    return true;
+}
+static QUAD* LoopBranch(BLOCK* b)
+{
+    QUAD* tail = b->tail;
+    while (tail != b->head && tail->ignoreMe)
+        tail = tail->back;
+    return tail;
+}
+static bool IsBranch(QUAD* q)
+{
+    switch (q->dc.opcode)
+    {
+        case i_goto:
+        case i_asmgoto:
+        case i_asmcond:
+        case i_coswitch:
+        case i_swbranch:
+        case i_cmpblock:
+            return true;
+        default:
+            return q->dc.opcode >= i_jne && q->dc.opcode <= i_jge;
+    }
+}
+static int Count(BLOCKLIST* l)
+{
+    int n = 0;
+    for (; l; l = l->next)
+        n++;
+    return n;
+}
+static bool Contains(BLOCKLIST* l, BLOCK* b)
+{
+    for (; l; l = l->next)
+        if (l->block == b)
+            return true;
+    return false;
+}
+// walk the chain of blocks starting at 'head' looking for a latch that branches back to it
+static bool FindLoop(std::vector<BLOCK*>& order, int n, VectorLoop& loop)
+{
+    if (n == 0 || n + 1 >= order.size())
+        return false;
+    BLOCK* head = order[n];
+    BLOCK* preheader = order[n - 1];
+    if (Count(head->pred) != 2 || !Contains(head->pred, preheader))
+        return false;
+    QUAD* before = LoopBranch(preheader);
+    if (IsBranch(before) && (before->dc.opcode == i_goto || before->dc.v.label == head->head->fwd->dc.v.label))
+        return false;
+    for (int i = n; i + 1 < order.size(); i++)
+    {
+        BLOCK* b = order[i];
+        QUAD* branch = LoopBranch(b);
+        if (i != n && (Count(b->pred) != 1 || b->pred->block != order[i - 1]))
+            return false;
+        if (IsBranch(branch))
+        {
+            if ((branch->dc.opcode != i_jl && branch->dc.opcode != i_jg) || Count(b->succ) != 2 ||
+                !Contains(b->succ, head) || !Contains(b->succ, order[i + 1]) || order[i + 1] == head ||
+                !Contains(head->pred, b))
+                return false;
+            loop.preheader = preheader;
+            loop.head = head;
+            loop.latch = b;
+            loop.exit = order[i + 1];
+            return true;
+        }
+        if (Count(b->succ) != 1 || b->succ->block != order[i + 1])
+            return false;
+    }
+    return false;
+}
+static bool Analyze(VectorLoop& loop)
+{
+    values.Clear();
+    definitions.Clear();
+    for (BLOCK* b = loop.head;; b = b->succ->block)
+    {
+        for (QUAD* head = b->head; head != b->tail->fwd; head = head->fwd)
+            if (head->ans && head->ans->mode == i_direct && head->ans->offset && head->ans->offset->type == se_tempref)
+                definitions.Set(head->ans->offset->sp->i, 1);
+        if (b == loop.latch)
+            break;
+    }
+    int index = -1;
+    VectorValue stored;
+    memset(&stored, 0, sizeof(stored));
+    stored.kind = vk_invariant;
+    loop.index = nullptr;
+    loop.size = 0;
+    loop.loads.clear();
+    QUAD* branch = LoopBranch(loop.latch);
+    for (BLOCK* b = loop.head;; b = b->succ->block)
+    {
+        for (QUAD* head = b->head; head != b->tail->fwd; head = head->fwd)
+            if (head != branch && !Step(loop, head, &index, &stored))
+                return false;
+        if (b == loop.latch)
+            break;
+    }
+    if (!loop.index || stored.kind != vk_data || Log2(sizeFromISZ(loop.size)) != loop.shift)
+        return false;
+    VectorValue* v = values.Find(index);
+    if (!v || v->kind != vk_next)
+        return false;
+    // the latch compare has to be i+1 < n, with n invariant
+    VectorValue left, right;
+    if (!Evaluate(branch->dc.left, &index, &left) || !Evaluate(branch->dc.right, &index, &right))
+        return false;
+    if (branch->dc.opcode == i_jg)
+    {
+        VectorValue temp = left;
+        left = right;
+        right = temp;
+    }
+    if (left.kind != vk_next || right.kind != vk_invariant || !IsIntSize(right.base->size) ||
+        sizeFromISZ(right.base->size) != sizeFromISZ(ISZ_UINT) || (right.base->mode != i_immed && !IsTemp(right.base)))
+        return false;
+    loop.bound = right.base;
+    loop.op = stored.op;
+    loop.left = stored.left;
+    loop.right = stored.right;
+    switch (stored.op)
+    {
+        case i_nop:
+            return true;
+        case i_add:
+        case i_sub:
+            if (IsFloatSize(loop.size))
+                return !stored.converted;
+            // there isn't a packed 16-bit subtract in the instruction tables
+            return stored.op == i_add || sizeFromISZ(loop.size) != 2;
+        case i_and:
+        case i_or:
+        case i_eor:
+            return !IsFloatSize(loop.size);
+        case i_mul:
+        case i_sdiv:
+        case i_udiv:
+            return IsFloatSize(loop.size) && !stored.converted;
+        default:
+            return false;
+    }
+}
+static SimpleSymbol* BaseSymbol(IMODE* base)
+{
+    if (base->mode == i_immed && (base->offset->type == se_global || base->offset->type == se_auto))
+        return base->offset->sp;
+    return nullptr;
+}
+static bool SameBase(IMODE* left, IMODE* right)
+{
+    if (left == right)
+        return true;
+    if (left->mode != right->mode)
+        return false;
+    if (left->mode == i_immed)
+        return BaseSymbol(left) && BaseSymbol(left) == BaseSymbol(right);
+    return left->offset->sp->i == right->offset->sp->i;
+}
+// a restrict qualified pointer usually reaches the loop through a chain of copies, so follow
+// temps with a single definition back to the variable they were loaded from
+static bool Restricted(IMODE* base, int depth = 0)
+{
+    if (base->restricted)
+        return true;
+    if (base->mode != i_direct || depth > 4)
+        return false;
+    SimpleSymbol* sym = base->offset->sp;
+    if (base->offset->type != se_tempref)
+        return sym->tp && sym->tp->isrestrict;
+    if (sym->imvalue->restricted)
+        return true;
+    QUAD* def = nullptr;
+    for (QUAD* head = intermed_head; head; head = head->fwd)
+        if (head->ans && head->ans->mode == i_direct && head->ans->offset->type == se_tempref &&
+            head->ans->offset->sp->i == sym->i && head->dc.opcode != i_block && head->dc.opcode != i_label)
+        {
+            if (def)
+                return false;
+            def = head;
+        }
+    return def && def->dc.opcode == i_assn && def->dc.left->mode == i_direct && Restricted(def->dc.left, depth + 1);
+}
+static bool Restricted(VectorAccess& access) { return access.mem->restricted || Restricted(access.base); }
+// gather the objects a base can point to, fails if they aren't known
+static bool PointsTo(IMODE* base, std::vector<SimpleSymbol*>& names)
+{
+    SimpleSymbol* sym = BaseSymbol(base);
+    if (sym)
+    {
+        names.push_back(sym);
+        return true;
+    }
+    if (base->mode != i_direct)
+        return false;
+    ALIASLIST* al = tempInfo[base->offset->sp->i]->pointsto;
+    if (!al)
+        return false;
+    for (; al; al = al->next)
+    {
+        ALIASADDRESS* aa = al->address;
+        while (aa->merge)
+            aa = aa->merge;
+        if (!aa->name || aa->name->byUIV || !aa->name->v.name || !aa->name->v.name->offset)
+            return false;
+        names.push_back(aa->name->v.name->offset->sp);
+    }
+    return true;
+}
+static bool Disjoint(VectorAccess& store, VectorAccess& load)
+{
+    // the same element of the same array is read before it is written
+    if (SameBase(store.base, load.base))
+        return true;
+    if (Restricted(store) || Restricted(load))
+        return true;
+    std::vector<SimpleSymbol*> left, right;
+    if (!PointsTo(store.base, left) || !PointsTo(load.base, right))
+        return false;
+    for (auto l : left)
+        for (auto r : right)
+            if (l == r)
+                return false;
+    return true;
+}
+static bool Safe(VectorLoop& loop)
+{
+    for (auto&& load : loop.loads)
+        if (!Disjoint(loop.store, load))
+            return false;
+    // only the index may be used after the loop; the vector loop doesn't compute anything else
+    bool rv = true;
+    int index = loop.index->offset->sp->i;
+    definitions.ForEach([&](const int& t, int&) {
+        if (t != index && t < tempCount && isset(loop.exit->liveIn, t))
+            rv = false;
+    });
+    if (!rv)
+        return false;
+    // the packed instructions use xmm0 and xmm1 as scratch registers, so nothing
+    // in floating point may be live around the loop
+    for (int i = 0; i < tempCount; i++)
+        if (isset(loop.preheader->liveOut, i) && (tempInfo[i]->usedAsFloat || tempInfo[i]->size >= ISZ_FLOAT))
+            return false;
+    return true;
+}
+static int BlockLabel(BLOCK* b)
+{
+    QUAD* head = b->head->fwd;
+    while (head != b->tail->fwd && (head->ignoreMe || head->dc.opcode == i_label))
+    {
+        if (head->dc.opcode == i_label)
+            return head->dc.v.label;
+        head = head->fwd;
+    }
+    int label = nextLabel++;
+    QUAD* lbl = Allocate<QUAD>();
+    lbl->dc.opcode = i_label;
+    lbl->dc.v.label = label;
+    lbl->block = b;
+    lbl->back = b->head;
+    lbl->fwd = b->head->fwd;
+    if (lbl->fwd)
+        lbl->fwd->back = lbl;
+    b->head->fwd = lbl;
+    if (b->tail == b->head)
+        b->tail = lbl;
+    return label;
+}
+static BLOCK* NewBlock(QUAD* after)
+{
+    BLOCK* b = newBlock()->block;
+    QUAD* q = Allocate<QUAD>();
+    q->dc.opcode = i_block;
+    q->dc.v.label = b->blocknum;
+    q->block = b;
+    q->back = after;
+    q->fwd = after->fwd;
+    if (q->fwd)
+        q->fwd->back = q;
+    after->fwd = q;
+    b->head = b->tail = q;
+    return b;
+}
+static void Append(BLOCK* b, enum i_ops op, IMODE* ans, IMODE* left, IMODE* right, int label = 0)
+{
+    QUAD* q = Allocate<QUAD>();
+    q->dc.opcode = op;
+    q->dc.v.label = label;
+    q->ans = ans;
+    q->dc.left = left;
+    q->dc.right = right;
+    InsertInstruction(b->tail, q);
+}
+static BLOCKLIST* Edge(BLOCK* b, BLOCKLIST* next = nullptr)
+{
+    BLOCKLIST* rv = oAllocate<BLOCKLIST>();
+    rv->block = b;
+    rv->next = next;
+    return rv;
+}
+static void ReplaceEdge(BLOCKLIST* l, BLOCK* from, BLOCK* to)
+{
+    for (; l; l = l->next)
+        if (l->block == from)
+            l->block = to;
+}
+static IMODE* Indirect(IMODE* pointer, int size)
+{
+    IMODELIST* iml = pointer->offset->sp->imind;
+    for (; iml; iml = iml->next)
+        if (iml->im->size == size && !iml->im->bits)
+            return iml->im;
+    IMODE* im = Allocate<IMODE>();
+    *im = *pointer;
+    im->mode = i_ind;
+    im->size = size;
+    im->ptrsize = ISZ_ADDR;
+    iml = Allocate<IMODELIST>();
+    iml->im = im;
+    iml->next = pointer->offset->sp->imind;
+    pointer->offset->sp->imind = iml;
+    return im;
+}
+static IMODE* Pointer(VectorLoop& loop, VectorAccess& access, BLOCK* b, IMODE* offset)
+{
+    if (access.pointer)
+        return access.pointer;
+    if (SameBase(access.base, loop.store.base) && loop.store.pointer)
+        return access.pointer = loop.store.pointer;
+    for (auto&& load : loop.loads)
+        if (load.pointer && SameBase(access.base, load.base))
+            return access.pointer = load.pointer;
+    access.pointer = InitTempOpt(ISZ_ADDR, ISZ_ADDR);
+    Append(b, i_add, access.pointer, access.base, offset);
+    return access.pointer;
+}
+/*
+ * preheader:
+ *      ...
+ * V0:  Tcount = n - i
+ *      Tvector = Tcount & -elements
+ *      Toffset = i << shift
+ *      Tpointer = base + Toffset       for each array
+ *      Tend = i + Tvector
+ *      Tremaining = Tvector
+ *      if Tvector <= 0 goto head
+ * V1:  *(Tstore) = *(Tleft) op *(Tright)   (i_vector)
+ *      Tpointer = Tpointer + 16        for each array
+ *      Tremaining = Tremaining - elements
+ *      if Tremaining > 0 goto V1
+ * V2:  i = Tend
+ *      if i >= n goto exit
+ * head:
+ *      original loop
+ */
+static void Transform(VectorLoop& loop)
+{
+    int elements = VECTOR_BYTES / sizeFromISZ(loop.size);
+    int isize = loop.index->size;
+    int headLabel = BlockLabel(loop.head);
+    int exitLabel = BlockLabel(loop.exit);
+    int vectorLabel = nextLabel++;
+    QUAD* insert = loop.head->head->back;
+    BLOCK* start = NewBlock(insert);
+    IMODE* count = InitTempOpt(isize, isize);
+    IMODE* vector = InitTempOpt(isize, isize);
+    IMODE* offset = InitTempOpt(isize, isize);
+    IMODE* end = InitTempOpt(isize, isize);
+    IMODE* remaining = InitTempOpt(isize, isize);
+    Append(start, i_sub, count, loop.bound, loop.index);
+    Append(start, i_and, vector, count, make_immed(isize, -elements));
+    Append(start, i_lsl, offset, loop.index, make_immed(isize, loop.shift));
+    IMODE* store = Pointer(loop, loop.store, start, offset);
+    IMODE* left = Pointer(loop, loop.loads[loop.left], start, offset);
+    IMODE* right = loop.right >= 0 ? Pointer(loop, loop.loads[loop.right], start, offset) : nullptr;
+    Append(start, i_add, end, loop.index, vector);
+    Append(start, i_assn, remaining, vector, nullptr);
+    Append(start, i_jle, nullptr, vector, make_immed(isize, 0), headLabel);
+
+    BLOCK* body = NewBlock(start->tail);
+    QUAD* lbl = Allocate<QUAD>();
+    lbl->dc.opcode = i_label;
+    lbl->dc.v.label = vectorLabel;
+    InsertInstruction(body->tail, lbl);
+    int size = loop.size;
+    Append(body, i_vector, Indirect(store, size), Indirect(left, size), right ? Indirect(right, size) : nullptr,
+           loop.op == i_nop ? i_assn : loop.op);
+    std::vector<IMODE*> pointers;
+    for (auto p : {store, left, right})
+        if (p && std::find(pointers.begin(), pointers.end(), p) == pointers.end())
+            pointers.push_back(p);
+    for (auto p : pointers)
+        Append(body, i_add, p, p, make_immed(ISZ_UINT, VECTOR_BYTES));
+    Append(body, i_sub, remaining, remaining, make_immed(isize, elements));
+    Append(body, i_jg, nullptr, remaining, make_immed(isize, 0), vectorLabel);
+
+    BLOCK* finish = NewBlock(body->tail);
+    Append(finish, i_assn, loop.index, end, nullptr);
+    Append(finish, i_jge, nullptr, loop.index, loop.bound, exitLabel);
+
+    // the flow graph, successors list the fall through block first
+    ReplaceEdge(loop.preheader->succ, loop.head, start);
+    start->pred = Edge(loop.preheader);
+    start->succ = Edge(body, Edge(loop.head));
+    body->pred = Edge(start, Edge(body));
+    body->succ = Edge(finish, Edge(body));
+    finish->pred = Edge(body);
+    finish->succ = Edge(loop.head, Edge(loop.exit));
+    ReplaceEdge(loop.head->pred, loop.preheader, finish);
+    loop.head->pred = Edge(start, loop.head->pred);
+    loop.exit->pred = Edge(finish, loop.exit->pred);
+}
+void VectorizeLoops(void)
+{
+    // the packed instructions are only generated by the x86 back end
+    if (architecture == ARCHITECTURE_MSIL)
+        return;
+    std::vector<BLOCK*> order;
+    for (QUAD* head = intermed_head; head; head = head->fwd)
+        if (head->dc.opcode == i_block && !head->block->dead)
+            order.push_back(head->block);
+    liveVariables();
+    for (int i = 1; i + 1 < order.size(); i++)
+    {
+        VectorLoop loop;
+        if (FindLoop(order, i, loop) && Analyze(loop) && Safe(loop))
+        {
+            Transform(loop);
+            if (cparams.verbosity >= 5)
+                printf("Vectorized loop in %s\n", currentFunction->name);
+            while (order[i] != loop.latch)
+                i++;
+        }
+    }
+}
+}  // namespace Optimizer
@@ -31,6 +31,7 @@
 #include "config.h"
 #include "ildata.h"
 #include "SharedMemory.h"
+#include "Trace.h"
 #include "ildata.h"
 #include "OptUtils.h"
 #include "iblock.h"
@@ -77,6 +78,7 @@ CmdSwitchCombineString prm_flags(SwitchParser, 'f', ';');
 CmdSwitchBool useSharedMemory(SwitchParser, 'S');
 CmdSwitchString prm_verbosity(SwitchParser, 'y');
 CmdSwitchString prm_optimize(SwitchParser, 'O', ';');
+CmdSwitchString prm_trace(SwitchParser, 0, 0, {"trace"});
 
 const char* usageText =
     "[options] inputfile\n"
@@ -89,13 +91,13 @@ const char* usageText =
     "Ox           optimization control\n"
     "-S use shared memory\n"
     "-Y output icd file\n"
+    "--trace=file add events to a Chrome trace file\n"
     "\nOptimization control:\n" OPTIMIZATION_DESCRIPTION "\nFlags:\n" OPTMODULES_DESCRIPTION "\nTime: " __TIME__
     "  Date: " __DATE__;
 
 bool InputIntermediate(SharedMemory* mem);
 void OutputIntermediate(SharedMemory* mem);
 
-static const int MAX_SHARED_REGION = 500 * 1024 * 1024;
 
 void InternalConflict(QUAD* head)
 {
@@ -270,7 +272,10 @@ void Optimize(SimpleSymbol* funcsp)
     /* now do the actual allocation */
     if (!(chosenAssembler->arch->denyopts & DO_NOREGALLOC))
     {
-        AllocateRegisters(intermed_head);
+        {
+            TraceSpan span("optimize", "Register allocation");
+            AllocateRegisters(intermed_head);
+        }
         /* backend peephole optimization can sometimes benefit by knowing what is live */
 
         CalculateBackendLives();
@@ -285,6 +290,7 @@ void Optimize(SimpleSymbol* funcsp)
 
 void ProcessFunction(FunctionData* fd)
 {
+    TraceSpan span("optimize", "function", currentFunction->name);
     SetUsesESP(currentFunction->usesEsp);
     Parser::anonymousNotAlloc = 0;
     CreateTempsAndBlocks(fd);
@@ -389,7 +395,9 @@ int main(int argc, char* argv[])
     {
         Utils::usage(argv[0], usageText);
     }
-    cparams.optimizer_modules = ~0;
+    if (prm_trace.GetExists())
+        Trace::Open(prm_trace.GetValue(), "occopt");
+    cparams.optimizer_modules = ~OPT_VECTORIZE;
     bool fileMode = true;
     if (useSharedMemory.GetValue())
     {
@@ -422,11 +430,11 @@ int main(int argc, char* argv[])
         FILE* fil = fopen(argv[1], "rb");
         if (fil)
         {
-            parserMem = new SharedMemory(MAX_SHARED_REGION);
+            parserMem = new SharedMemory();
             parserMem->Create();
             Optimizer::ReadMappingFile(parserMem, fil);
             fclose(fil);
-            optimizerMem = new SharedMemory(MAX_SHARED_REGION);
+            optimizerMem = new SharedMemory();
             optimizerMem->Create();
         }
         else
@@ -436,8 +444,8 @@ int main(int argc, char* argv[])
     }
     else
     {
-        parserMem = new SharedMemory(0, argv[1]);
-        optimizerMem = new SharedMemory(0, argv[2]);
+        parserMem = new SharedMemory(argv[1]);
+        optimizerMem = new SharedMemory(argv[2]);
         if (!parserMem->Open() || !optimizerMem->Open())
         {
             Utils::fatal("invalid shared memory specifiers");
@@ -454,6 +462,8 @@ int main(int argc, char* argv[])
     regInit();
     alloc_init();
     ProcessFunctions();
+    if (Optimizer::cparams.verbosity >= 4)
+        Optimizer::HashTableBase::Statistics();
     std::string aa = inputFiles.size() ? inputFiles.front() : "";
     SaveFile(aa, optimizerMem);
     if (architecture != ARCHITECTURE_MSIL || (cparams.prm_compileonly && !cparams.prm_asmfile))
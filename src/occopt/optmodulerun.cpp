@@ -39,7 +39,9 @@
 #include "ilocal.h"
 #include "irc.h"
 #include "iconst.h"
+#include "ivector.h"
 #include "Utils.h"
+#include "Trace.h"
 namespace Optimizer
 {
 struct OptimizerModule
@@ -50,6 +52,7 @@ struct OptimizerModule
     int denyMask;
     bool needsSpeed;
     bool needsSize;
+    const char* traceName;  // the module's name in a --trace profile
 };
 // Precolor(true);
 // RearrangePrecolors();
@@ -106,27 +109,28 @@ void RemoveDead() { removeDead(blockArray[0]); }
 void ResetTempBottom() { nextTemp = tempBottom; }
 void RedoDoms() { doms_only(false); }
 OptimizerModule Modules[]{
-    {OptimizePrecolor, nullptr, ~0, 0, false, false},  // Precolor(true);
-    {RearrangePrecolors, nullptr, ~0, 0, false, false},
-    {SSAIn, nullptr, ~0, 0, false, false},
-    {ConstantFlow, "Constant Optimization", OPT_CONSTANT, DO_NOCONST, false, false},
-    {RemoveInfiniteThunks, nullptr, OPT_CONSTANT, 0, false, false},
+    {OptimizePrecolor, nullptr, ~0, 0, false, false, "Precolor"},  // Precolor(true);
+    {RearrangePrecolors, nullptr, ~0, 0, false, false, "Rearrange precolors"},
+    {SSAIn, nullptr, ~0, 0, false, false, "Translate to SSA"},
+    {ConstantFlow, "Constant Optimization", OPT_CONSTANT, DO_NOCONST, false, false, "Constant Optimization"},
+    {RemoveInfiniteThunks, nullptr, OPT_CONSTANT, 0, false, false, "Remove infinite thunks"},
     ////    { RemoveCriticalThunks, nullptr, OPT_CONSTANT, 0, false, false },
-    {RedoDoms, nullptr, OPT_CONSTANT, 0, false, false},
+    {RedoDoms, nullptr, OPT_CONSTANT, 0, false, false, "Redo dominators"},
     ////    { Reshape, "Loop reshaping", OPT_RESHAPE, 0, false, false },
-    {ReduceLoopStrength, "Reduce Loop Strength", OPT_LSTRENGTH, DO_NOGCSE, true, false},
-    {MoveLoopInvariants, "Move Loop Invariants", OPT_INVARIANT, DO_NOGCSE, true, false},
-    {AliasPass1, nullptr, ~0, DO_NOALIAS, false, false},
-    {SSAOut, nullptr, ~0, 0, false, false},
-    {RemoveDead, nullptr, ~0, 0, false, false},
-    {SetGlobalTerms, nullptr, ~0, 0, false, false},
-    {AliasPass2, nullptr, ~0, DO_NOALIAS, false, false},
-    {RemoveCriticalThunks, nullptr, ~0, 0, false, false},
-    {GlobalOptimization, "Lazy global optimization", OPT_GCSE, DO_NOGCSE, false, false},
-    {AliasRundown, nullptr, ~0, DO_NOALIAS, false, false},
-    {ResetTempBottom, nullptr, ~0, 0, false, false},
-    {RemoveDead, nullptr, ~0, 0, false, false},
-    {RemoveInfiniteThunks, nullptr, ~0, 0, false, false},
+    {ReduceLoopStrength, "Reduce Loop Strength", OPT_LSTRENGTH, DO_NOGCSE, true, false, "Reduce Loop Strength"},
+    {MoveLoopInvariants, "Move Loop Invariants", OPT_INVARIANT, DO_NOGCSE, true, false, "Move Loop Invariants"},
+    {AliasPass1, nullptr, ~0, DO_NOALIAS, false, false, "Alias pass 1"},
+    {SSAOut, nullptr, ~0, 0, false, false, "Translate from SSA"},
+    {RemoveDead, nullptr, ~0, 0, false, false, "Remove dead blocks"},
+    {SetGlobalTerms, nullptr, ~0, 0, false, false, "Set global terms"},
+    {AliasPass2, nullptr, ~0, DO_NOALIAS, false, false, "Alias pass 2"},
+    {RemoveCriticalThunks, nullptr, ~0, 0, false, false, "Remove critical thunks"},
+    {GlobalOptimization, "Lazy global optimization", OPT_GCSE, DO_NOGCSE, false, false, "Lazy global optimization"},
+    {VectorizeLoops, "Vectorize loops", OPT_VECTORIZE, DO_NOGCSE, true, false, "Vectorize loops"},
+    {AliasRundown, nullptr, ~0, DO_NOALIAS, false, false, "Alias rundown"},
+    {ResetTempBottom, nullptr, ~0, 0, false, false, "Reset temps"},
+    {RemoveDead, nullptr, ~0, 0, false, false, "Remove dead blocks"},
+    {RemoveInfiniteThunks, nullptr, ~0, 0, false, false, "Remove infinite thunks"},
 };
 
 void OptimizerStats()
@@ -187,6 +191,7 @@ void RunOptimizerModules()
                     {
                         printf("Running: %s\n", m.friendlyName);
                     }
+                    TraceSpan span("optimize", m.traceName);
                     m.func();
                 }
             }
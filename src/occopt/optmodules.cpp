@@ -36,7 +36,8 @@ struct OptimizerParam
 };
 std::vector<OptimizerParam> Params{
     {"reshape", OPT_RESHAPE},           {"constant", OPT_CONSTANT}, {"loop-strength", OPT_LSTRENGTH},
-    {"move-invariants", OPT_INVARIANT}, {"gcse", OPT_GCSE},
+    {"move-invariants", OPT_INVARIANT}, {"gcse", OPT_GCSE},     {"vectorize", OPT_VECTORIZE},
+    {"pruned-ssa", OPT_PRUNEDSSA},
 };
 
 std::vector<OptimizerParam> IcdParams{
@@ -30,6 +30,8 @@
 #define OPT_GCSE 4
 #define OPT_CONSTANT 8
 #define OPT_INVARIANT 0x10
+#define OPT_VECTORIZE 0x20
+#define OPT_PRUNEDSSA 0x40
 
 #define ICD_QUITEARLY 0x80000000
 #define ICD_OCP (1 | ICD_QUITEARLY)
@@ -47,6 +49,8 @@
     "  -fopt-{no}loop-strength        turn on or off loop strength optimization\n"      \
     "  -fopt-{no}move-invariants      turn on or off loop invariant code motion\n"      \
     "  -fopt-{no}gcse                 turn on or off global subexpression evaluation\n" \
+    "  -fopt-{no}vectorize            turn on or off SSE2 loop vectorization\n"         \
+    "  -fopt-{no}pruned-ssa           turn on or off pruned SSA construction\n"         \
     "  -ficd-{no}gcse                 turn on or off gcse diagnostics in the icd file\n"
 
 #define OPTIMIZATION_DESCRIPTION                               \
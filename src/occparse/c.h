@@ -507,6 +507,8 @@ typedef struct init
     struct sym* fieldsp;
     EXPRESSION* fieldoffs;
     EXPRESSION* exp;
+    char* packed;   /* constant scalar array contents in target byte order, when exp is null */
+    int packedSize;
     int tag; /* sequence number */
     int noassign : 1;
 } INITIALIZER;
@@ -1127,6 +1129,7 @@ typedef struct lexeme
     KEYWORD* kw;
     SYMBOL* typequal;
     int registered : 1;
+    int readAhead : 1;
 } LEXEME;
 
 typedef struct lexlist
@@ -232,9 +232,12 @@ void DisableTrivialWarnings()
                 Warning::Instance()->SetFlag(i, Warning::Disable);
 }
 static int total_errors;
+// every diagnostic that was raised, including the ones that weren't shown
+static int diagnosticCount;
 int diagcount;
 
 int TotalErrors() { return total_errors + Errors::GetErrorCount(); }
+int DiagnosticCount() { return diagnosticCount; }
 void errorinit(void)
 {
     total_errors = diagcount = 0;
@@ -365,6 +368,7 @@ bool IsNothrowError(int err)
 }
 bool printerrinternal(int err, const char* file, int line, va_list args)
 {
+    diagnosticCount++;
     if (inNothrowHandler && IsNothrowError(err))
     {
         noExcept = false;
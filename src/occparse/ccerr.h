@@ -105,6 +105,7 @@ void PushWarnings(void);
 void PopWarnings(void);
 void DisableTrivialWarnings(void);
 int TotalErrors(void);
+int DiagnosticCount(void);
 void errorinit(void);
 bool printerrinternal(int err, const char* file, int line, va_list args);
 int printerr(int err, const char* file, int line, ...);
@@ -0,0 +1,267 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#include "compiler.h"
+#include "compilecache.h"
+#include "occparse.h"
+#include "osutil.h"
+#include "config.h"
+#include "ildata.h"
+#include "CompileCache.h"
+#include "Errors.h"
+#include "Utils.h"
+#include "../version.h"
+#include <cstdio>
+#include <set>
+
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#else
+#    include <direct.h>
+#endif
+
+namespace Parser
+{
+// only plain object file compiles are cached, anything with other outputs goes the long way
+static bool Cacheable()
+{
+    return IsCompiler() && Optimizer::architecture == ARCHITECTURE_X86 && !prm_job.GetExists() &&
+           Optimizer::cparams.prm_compileonly && !Optimizer::cparams.prm_asmfile && !Optimizer::cparams.prm_assemble &&
+           !Optimizer::cparams.prm_browse && !Optimizer::cparams.prm_cppfile && !Optimizer::cparams.prm_errfile &&
+           !Optimizer::cparams.prm_icdfile && !Optimizer::cparams.prm_makestubs && !prm_prmSyntaxOnly.GetValue() && !prm_pipe.GetExists();
+}
+// the name occ will give the object file
+static std::string ObjectFile(const char* name)
+{
+    char buf[260];
+    Utils::StrCpy(buf, Optimizer::outputFileName.c_str());
+    if (buf[0] && buf[strlen(buf) - 1] == '\\')
+    {
+        Utils::StrCat(buf, name);
+        Utils::StripExt(buf);
+        Utils::AddExt(buf, Optimizer::chosenAssembler->objext);
+    }
+    else if (!buf[0])
+    {
+        const char* p = strrchr(name, '\\');
+        const char* q = strrchr(name, '/');
+        if (q > p)
+            p = q;
+        Utils::StrCpy(buf, p ? p + 1 : name);
+        Utils::StripExt(buf);
+        Utils::StrCat(buf, Optimizer::chosenAssembler->objext);
+    }
+    else
+    {
+        Utils::AddExt(buf, Optimizer::chosenAssembler->objext);
+    }
+    return buf;
+}
+// the compiler programs are started by name, on posix hosts that means they come off the path
+static std::string ToolName(const std::string& path, const std::string& tool)
+{
+    std::string exe = tool;
+#ifdef WIN32
+    exe += ".exe";
+#endif
+#ifdef HAVE_UNISTD_H
+    if (path.empty())
+    {
+        const char* env = getenv("PATH");
+        for (auto&& dir : Utils::split(env ? env : "", ':'))
+        {
+            std::string name = dir.empty() || dir.back() == '/' ? dir + exe : dir + "/" + exe;
+            if (Utils::FileExists(name.c_str()))
+                return name;
+        }
+    }
+#endif
+    return path + exe;
+}
+// the fields are added one at a time, a copy of the structure would also bring in whatever is in
+// the padding.   verbosity, prm_quiet and prm_displaytiming don't change the object file
+static void HashParams(CompileCache::Key& key, const Optimizer::COMPILER_PARAMS& p)
+{
+    for (long long v :
+         {(long long)p.prm_maxerr, (long long)p.prm_stackalign, (long long)p.optimizer_modules, (long long)p.icd_flags,
+          (long long)p.prm_optimize_for_speed, (long long)p.prm_optimize_for_size, (long long)p.prm_optimize_float_access,
+          (long long)p.prm_warning, (long long)p.prm_extwarning, (long long)p.prm_diag, (long long)p.prm_ansi,
+          (long long)p.prm_cmangle, (long long)p.prm_c99, (long long)p.prm_c1x, (long long)p.prm_cplusplus, (long long)p.prm_xcept,
+          (long long)p.prm_icdfile, (long long)p.prm_asmfile, (long long)p.prm_compileonly, (long long)p.prm_debug,
+          (long long)p.prm_listfile, (long long)p.prm_cppfile, (long long)p.prm_errfile, (long long)p.prm_browse,
+          (long long)p.prm_trigraph, (long long)p.prm_oldfor, (long long)p.prm_stackcheck, (long long)p.prm_allowinline,
+          (long long)p.prm_profiler, (long long)p.prm_mergestrings, (long long)p.prm_revbits, (long long)p.prm_lines,
+          (long long)p.prm_bss, (long long)p.prm_intrinsic, (long long)p.prm_smartframes, (long long)p.prm_farkeyword,
+          (long long)p.prm_linkreg, (long long)p.prm_charisunsigned, (long long)p.prm_assemble, (long long)p.prm_makestubs,
+          (long long)p.prm_targettype, (long long)p.compile_under_dos, (long long)p.prm_bepeep, (long long)p.prm_crtdll,
+          (long long)p.prm_lscrtdll, (long long)p.prm_msvcrt, (long long)p.prm_assembler, (long long)p.prm_flat,
+          (long long)p.prm_nodos, (long long)p.prm_useesp, (long long)p.managed_library, (long long)p.no_default_libs,
+          (long long)p.replacePInvoke, (long long)p.msilAllowExtensions})
+        key.Add(v);
+}
+// everything that goes into a compile other than the source: the compiler itself, and the options,
+// whether they came from the command line, the environment or the configuration file
+static void HashOptions(CompileCache::Key& key)
+{
+    key.Add(Optimizer::compilerName);
+    std::string path = Utils::GetModuleName();
+    size_t n = path.find_last_of("\\/");
+    path = n == std::string::npos ? "" : path.substr(0, n + 1);
+    for (auto tool : {"occparse", "occopt", "occ"})
+        key.Add(CompileCache::FileStamp(ToolName(path, tool)));
+    HashParams(key, Optimizer::cparams);
+    for (auto&& d : defines)
+        key.Add((d.undef ? "-" : "+") + d.name);
+    for (auto sw : {&prm_codegen, &prm_optimize, &prm_warning, &prm_error, &prm_Winmode})
+        key.Add(sw->GetValue());
+    for (auto sw : {&prm_cinclude, &prm_Csysinclude, &prm_CPPsysinclude, &prm_flags, &prm_tool})
+        key.Add(sw->GetValue());
+    key.Add(cplusplusversion);
+    key.Add(Optimizer::outputFileName);
+    char cwd[4096];
+    if (getcwd(cwd, sizeof(cwd)))
+        key.Add(cwd);
+}
+// run the preprocessor over the file with the same settings the compile will use, the source lines
+// and where they came from make up the rest of the key
+static bool HashSource(CompileCache::Key& key, const char* name)
+{
+    char buffer[260];
+    Utils::StrCpy(buffer, name);
+    Utils::AddExt(buffer, ".C");
+    SelectLanguage(buffer);
+    PreProcessor* old = preProcessor;
+    preProcessor = OpenPreProcessor(buffer);
+    bool rv = preProcessor->IsOpen();
+    if (rv)
+    {
+        // #if is handled by the preprocessor's own evaluator, the compiler isn't set up yet
+        preProcessor->SetExpressionHandler(nullptr);
+        setglbdefs();
+        Errors::SetQuiet(true);
+        key.Add(Optimizer::cparams.prm_cplusplus * 4 + Optimizer::cparams.prm_c99 * 2 + Optimizer::cparams.prm_c1x);
+        key.Add(name);
+        std::string line, file;
+        while (preProcessor->GetLine(line))
+        {
+            if (preProcessor->GetRealFile() != file)
+            {
+                file = preProcessor->GetRealFile();
+                key.Add(file);
+            }
+            key.Add(preProcessor->GetRealLineNo());
+            key.Add(line);
+        }
+        Errors::SetQuiet(false);
+        // anything with errors gets compiled for real so the errors are shown
+        rv = !Errors::GetErrorCount();
+        Errors::Reset();
+    }
+    delete preProcessor;
+    preProcessor = old;
+    return rv;
+}
+void SkipFiles(const std::string& positions)
+{
+    std::set<int> skip;
+    for (auto&& n : Utils::split(positions, ','))
+        skip.insert(Utils::StringToNumber(n));
+    int i = 0;
+    for (Optimizer::LIST** find = &clist; *find; i++)
+    {
+        if (skip.find(i) != skip.end())
+            *find = (*find)->next;
+        else
+            find = &(*find)->next;
+    }
+    i = 0;
+    for (auto it = Optimizer::inputFiles.begin(); it != Optimizer::inputFiles.end(); i++)
+    {
+        if (skip.find(i) != skip.end())
+            it = Optimizer::inputFiles.erase(it);
+        else
+            ++it;
+    }
+}
+std::string CacheLookup()
+{
+    std::string rv;
+    if (!prm_cache.GetExists() || !Cacheable())
+        return rv;
+    CompileCache cache(prm_cache.GetValue());
+    FILE* keys = prm_cacheKeys.GetExists() ? fopen(prm_cacheKeys.GetValue().c_str(), "w") : nullptr;
+    CompileCache::Key options;
+    HashOptions(options);
+    int hits = 0, misses = 0, i = 0;
+    for (auto c = clist; c; c = c->next, i++)
+    {
+        const char* name = (const char*)c->data;
+        if (name[0] == '-')
+            continue;  // stdin
+        CompileCache::Key key = options;
+        if (!HashSource(key, name))
+            continue;
+        if (cache.Lookup(key.Value(), ObjectFile(name)))
+        {
+            if (clist->next && !Optimizer::cparams.prm_quiet)
+                printf("%s\n", name);
+            if (rv.size())
+                rv += ",";
+            rv += Utils::NumberToString(i);
+            hits++;
+        }
+        else
+        {
+            if (keys)
+                fprintf(keys, "%s\t%s\n", key.Value().c_str(), name);
+            misses++;
+        }
+    }
+    if (keys)
+        fclose(keys);
+    cache.Count(hits, misses);
+    if (Optimizer::cparams.verbosity)
+        printf("compile cache: %d hits, %d misses\n", hits, misses);
+    if (rv.size())
+        SkipFiles(rv);
+    return rv;
+}
+void CacheStatistics()
+{
+    if (!prm_cache.GetExists())
+    {
+        printf("No compile cache, set OCC_CACHE to the directory to keep one in\n");
+        return;
+    }
+    CompileCache cache(prm_cache.GetValue());
+    int hits, misses, entries;
+    unsigned long long size;
+    cache.Statistics(hits, misses, entries, size);
+    printf("Compile cache %s\n", cache.Directory().c_str());
+    printf("  Hits:    %d\n", hits);
+    printf("  Misses:  %d\n", misses);
+    printf("  Entries: %d\n", entries);
+    printf("  Size:    %llu\n", size);
+}
+}  // namespace Parser
@@ -0,0 +1,41 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#pragma once
+
+#include <string>
+
+namespace Parser
+{
+// compile cache support.   When occ has a cache directory (OCC_CACHE) it passes it with --cache,
+// along with a file to hand back the keys of the files that still need compiling.   Each file is
+// preprocessed and hashed together with the options and the compiler version; files whose object
+// file is found in the cache are copied out and dropped from the compile.   Returns the positions
+// of the dropped files on the command line, as a list for --job-skip.
+std::string CacheLookup();
+// drop the files at the given comma separated positions from the list of files to compile
+void SkipFiles(const std::string& positions);
+// --cache-stats
+void CacheStatistics();
+}  // namespace Parser
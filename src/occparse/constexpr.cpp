@@ -49,6 +49,7 @@
 #include "beinterf.h"
 #include "iexpr.h"
 #include "floatconv.h"
+#include "Trace.h"
 
 namespace Parser
 {
@@ -1400,6 +1401,7 @@ bool EvaluateConstexprFunction(EXPRESSION*& node)
                     }
                     else
                     {
+                        TraceSpan span("constexpr", "evaluate", found1->name);
                         std::unordered_map<SYMBOL*, ConstExprArgArray> argmap;
                         std::unordered_map<SYMBOL*, ConstExprArgArray> tempmap;
                         if (!nestedMaps.empty())
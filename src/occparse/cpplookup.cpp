@@ -5350,6 +5350,210 @@ static bool IsMove(SYMBOL* sp)
     }
     return rv;
 }
+// overload resolution results are remembered for the duration of a function body,
+// keyed on the overload sets that were searched, where the call is made from and a
+// description of the arguments detailed enough that it determines every conversion
+// sequence.   An entry goes stale on its own when a declaration is added to one of
+// the sets, because the size of each set is part of the key.
+static std::unordered_map<std::string, SYMBOL*> overloadCache;
+static int overloadCacheHits, overloadCacheMisses;
+
+static void OverloadKeyAdd(std::string& key, const void* data, size_t len) { key.append((const char*)data, len); }
+template <class T>
+static void OverloadKeyAdd(std::string& key, T value)
+{
+    OverloadKeyAdd(key, &value, sizeof(value));
+}
+static bool OverloadKeyType(std::string& key, TYPE* tp)
+{
+    while (tp)
+    {
+        OverloadKeyAdd(key, tp->type);
+        OverloadKeyAdd(key, tp->size);
+        OverloadKeyAdd(key, (tp->array << 0) | (tp->msil << 1) | (tp->byRefArray << 2) | (tp->hasbits << 3) |
+                                (tp->scoped << 4) | (tp->fixed << 5) | (tp->nullptrType << 6) | (tp->enumConst << 7) |
+                                (tp->lref << 8) | (tp->rref << 9) | (tp->stringconst << 10));
+        OverloadKeyAdd(key, tp->bits);
+        OverloadKeyAdd(key, tp->startbit);
+        switch (tp->type)
+        {
+            case bt_aggregate:
+            case bt_any:
+            case bt_auto:
+            case bt_untyped:
+            case bt_cond:
+            case bt_consplaceholder:
+            case bt_templateparam:
+            case bt_templateselector:
+            case bt_templatedecltype:
+            case bt_derivedfromtemplate:
+            case bt_templateholder:
+            case bt_match_none:
+                return false;
+            case bt_struct:
+            case bt_class:
+            case bt_union:
+                // an incomplete class may gain conversions once it is defined
+                if (!tp->sp->tp->size || (tp->sp->sb->templateLevel && tp->sp->templateParams && !tp->sp->sb->instantiated))
+                    return false;
+                OverloadKeyAdd(key, tp->sp);
+                return true;
+            case bt_enum:
+                OverloadKeyAdd(key, tp->sp);
+                return true;
+            case bt_func:
+            case bt_ifunc:
+                OverloadKeyAdd(key, tp);
+                return true;
+            case bt_memberptr:
+                OverloadKeyAdd(key, tp->sp);
+                break;
+            default:
+                if (tp->vla)
+                    return false;
+                break;
+        }
+        tp = tp->btp;
+    }
+    return true;
+}
+static bool OverloadKeyExpression(std::string& key, EXPRESSION* exp, int depth)
+{
+    if (!exp)
+    {
+        OverloadKeyAdd(key, -1);
+        return true;
+    }
+    if (depth > 16)
+        return false;
+    OverloadKeyAdd(key, exp->type);
+    OverloadKeyAdd(key, exp->bits);
+    OverloadKeyAdd(key, exp->startbit);
+    switch (exp->type)
+    {
+        case en_func:
+            OverloadKeyAdd(key, exp->v.func->sp);
+            OverloadKeyAdd(key, exp->v.func->functp);
+            OverloadKeyAdd(key, (exp->v.func->ascall << 0) | (exp->v.func->astemplate << 1) |
+                                    ((exp->v.func->returnSP && !exp->v.func->returnSP->sb->anonymous) << 2));
+            return true;
+        case en_global:
+        case en_auto:
+        case en_absolute:
+        case en_pc:
+        case en_threadlocal:
+            OverloadKeyAdd(key, exp->v.sp->sb->constexpression | (exp->v.sp->sb->thisPtr << 1));
+            if (exp->type == en_pc || exp->v.sp->sb->constexpression)
+                OverloadKeyAdd(key, exp->v.sp);
+            return true;
+        case en_labcon:
+        case en_c_string:
+        case en_nullptr:
+        case en_structelem:
+            return true;
+        case en_construct:
+        case en_memberptr:
+        case en_literalclass:
+        case en_templateparam:
+        case en_templateselector:
+        case en_packedempty:
+        case en_sizeofellipse:
+        case en_stmt:
+        case en_atomic:
+        case en_imode:
+        case en_type:
+        case en_pointsto:
+        case en_dot:
+        case en_msil_array_access:
+        case en_msil_array_init:
+        case en_cshimref:
+        case en_cshimthis:
+        case en_paramsubstitute:
+            return false;
+        default:
+            if (isintconst(exp))
+            {
+                OverloadKeyAdd(key, exp->v.i);
+                return true;
+            }
+            if (isarithmeticconst(exp))
+                return true;
+            return OverloadKeyExpression(key, exp->left, depth + 1) && OverloadKeyExpression(key, exp->right, depth + 1);
+    }
+}
+static bool OverloadKey(std::string& key, SYMBOL* sp, Optimizer::LIST* gather, FUNCTIONCALL* args, int flags)
+{
+    if (templateNestingCount)
+        return false;
+    OverloadKeyAdd(key, sp);
+    OverloadKeyAdd(key, flags);
+    OverloadKeyAdd(key, (!!inDeduceArgs << 0) | (!!inTemplateArgs << 1) | (!!inSearchingFunctions << 2) |
+                            (!!instantiatingTemplate << 3) | (!!inGetUserConversion << 4) | (args->astemplate << 5) |
+                            (!!instantiatingFunction << 6));
+    // which candidates are accessible depends on where the call is made from
+    OverloadKeyAdd(key, getStructureDeclaration());
+    OverloadKeyAdd(key, theCurrentFunc);
+    for (auto lst = gather; lst; lst = lst->next)
+    {
+        int n = 0;
+        for (auto hr = ((SYMBOL*)lst->data)->tp->syms->table[0]; hr; hr = hr->next)
+            n++;
+        OverloadKeyAdd(key, lst->data);
+        OverloadKeyAdd(key, n);
+    }
+    for (auto tpl = args->templateParams; tpl; tpl = tpl->next)
+    {
+        if (tpl->p->packed)
+            return false;
+        OverloadKeyAdd(key, tpl->p->type);
+        switch (tpl->p->type)
+        {
+            case kw_typename:
+                if (!OverloadKeyType(key, tpl->p->byClass.dflt) || !OverloadKeyType(key, tpl->p->byClass.val))
+                    return false;
+                break;
+            case kw_int:
+                if (!OverloadKeyType(key, tpl->p->byNonType.tp) || !OverloadKeyExpression(key, tpl->p->byNonType.dflt, 0) ||
+                    !OverloadKeyExpression(key, tpl->p->byNonType.val, 0))
+                    return false;
+                break;
+            case kw_template:
+                OverloadKeyAdd(key, tpl->p->byTemplate.dflt);
+                OverloadKeyAdd(key, tpl->p->byTemplate.val);
+                break;
+            default:
+                return false;
+        }
+    }
+    OverloadKeyAdd(key, -1);
+    for (auto arg = args->arguments; arg; arg = arg->next)
+    {
+        if (!arg->tp || !arg->exp || arg->nested || arg->initializer_list || arg->valist)
+            return false;
+        if (!OverloadKeyType(key, arg->tp) || !OverloadKeyExpression(key, arg->exp, 0))
+            return false;
+    }
+    if (args->thisptr)
+    {
+        OverloadKeyAdd(key, -1);
+        if (!OverloadKeyType(key, args->thistp) || !OverloadKeyExpression(key, args->thisptr, 0))
+            return false;
+    }
+    return true;
+}
+void overloadCacheInit(void)
+{
+    overloadCache.clear();
+    overloadCacheHits = overloadCacheMisses = 0;
+}
+void overloadCacheFlush(void) { overloadCache.clear(); }
+void overloadCacheStatistics(void)
+{
+    int total = overloadCacheHits + overloadCacheMisses;
+    if (total)
+        printf("overload cache: %d hits, %d misses (%d%% hit rate)\n", overloadCacheHits, overloadCacheMisses,
+               overloadCacheHits * 100 / total);
+}
 int count3;
 SYMBOL* GetOverloadedFunction(TYPE** tp, EXPRESSION** exp, SYMBOL* sp, FUNCTIONCALL* args, TYPE* atp, int toErr,
                               bool maybeConversion, bool toInstantiate, int flags)
@@ -5499,7 +5703,16 @@ SYMBOL* GetOverloadedFunction(TYPE** tp, EXPRESSION** exp, SYMBOL* sp, FUNCTIONC
                 }
                 lst2 = lst2->next;
             }
-            if (args || atp)
+            std::string cacheKey;
+            bool cacheable = !atp && args && args->ascall && OverloadKey(cacheKey, sp, gather, args, flags);
+            int diagnosticCount = DiagnosticCount();
+            auto cached = cacheable ? overloadCache.find(cacheKey) : overloadCache.end();
+            if (cached != overloadCache.end())
+            {
+                overloadCacheHits++;
+                found1 = cached->second;
+            }
+            else if (args || atp)
             {
                 int i;
                 SYMBOL **spList;
@@ -5643,6 +5856,13 @@ SYMBOL* GetOverloadedFunction(TYPE** tp, EXPRESSION** exp, SYMBOL* sp, FUNCTIONC
                 {
                     found1 = spList[0];
                 }
+                if (cacheable)
+                {
+                    overloadCacheMisses++;
+                    // a hit doesn't repeat any diagnostics, so results that came with some aren't kept
+                    if (found1 && !found2 && diagnosticCount == DiagnosticCount())
+                        overloadCache[cacheKey] = found1;
+                }
             }
             else
             {
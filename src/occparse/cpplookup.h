@@ -78,6 +78,9 @@ bool sameTemplate(TYPE* P, TYPE* A, bool quals = false);
 SYMBOL* detemplate(SYMBOL* sym, FUNCTIONCALL* args, TYPE* atp);
 SYMBOL* GetOverloadedTemplate(SYMBOL* sp, FUNCTIONCALL* args);
 void weedgathering(Optimizer::LIST** gather);
+void overloadCacheInit(void);
+void overloadCacheFlush(void);
+void overloadCacheStatistics(void);
 SYMBOL* GetOverloadedFunction(TYPE** tp, EXPRESSION** exp, SYMBOL* sp, FUNCTIONCALL* args, TYPE* atp, int toErr,
                               bool maybeConversion, bool toInstantiate, int flags);
 SYMBOL* MatchOverloadedFunction(TYPE* tp, TYPE** mtp, SYMBOL* sym, EXPRESSION** exp, int flags);
@@ -80,6 +80,7 @@ static int unnamed_tag_id, unnamed_id;
 static char* importFile;
 static unsigned symbolKey;
 static int nameshim;
+static std::map<TYPE*, TYPE*> thisPointerTypes;
 
 static LEXLIST* getStorageAndType(LEXLIST* lex, SYMBOL* funcsp, SYMBOL** strSym, bool inTemplate, bool assumeType,
                                   enum e_sc* storage_class, enum e_sc* storage_class_in, Optimizer::ADDRESS* address, bool* blocked,
@@ -103,6 +104,7 @@ void declare_init(void)
     noNeedToSpecialize = 0;
     inConstantExpression = 0;
     parsingUsing = 0;
+    thisPointerTypes.clear();
 }
 
 void InsertGlobal(SYMBOL* sp) { Optimizer::globalCache.push_back(Optimizer::SymbolManager::Get(sp)); }
@@ -244,6 +246,23 @@ TYPE* MakeType(enum e_bt type, TYPE* base)
     TYPE* rv = Allocate<TYPE>();
     return MakeType(*rv, type, base);
 }
+// the type of the implicit 'this' pointer built for a member, constructor or destructor
+// call is only ever looked at, so the calls on one class type share a single pointer node.
+// No other types are shared, most of them get changed in place after they are made.
+// The nodes are allocated globally, but the table is emptied when local memory is
+// released since a base type may live there.
+TYPE* MakeThisPointerType(TYPE* base)
+{
+    TYPE*& rv = thisPointerTypes[base];
+    if (!rv)
+    {
+        SET_GLOBAL(true, 1);
+        rv = MakeType(bt_pointer, base);
+        RELEASE_GLOBAL(1);
+    }
+    return rv;
+}
+void ThisPointerTypesFlush(void) { thisPointerTypes.clear(); }
 TYPE* CopyType(TYPE* tp, bool deep, std::function<void(TYPE*&, TYPE*&)> callback)
 {
     TYPE* rv = nullptr;
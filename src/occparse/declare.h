@@ -53,6 +53,8 @@ SYMBOL* makeID(enum e_sc storage_class, TYPE* tp, SYMBOL* spi, const char* name)
 SYMBOL* makeUniqueID(enum e_sc storage_class, TYPE* tp, SYMBOL* spi, const char* name);
 TYPE* MakeType(TYPE& tp, enum e_bt type, TYPE* base = nullptr);
 TYPE* MakeType(enum e_bt type, TYPE* base = nullptr);
+TYPE* MakeThisPointerType(TYPE* base);
+void ThisPointerTypesFlush(void);
 TYPE* CopyType(TYPE* tp, bool deep = false, std::function<void(TYPE*&, TYPE*&)> callback = nullptr);
 void addStructureDeclaration(STRUCTSYM* decl);
 void addTemplateDeclaration(STRUCTSYM* decl);
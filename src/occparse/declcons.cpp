@@ -1446,7 +1446,7 @@ static void shimDefaultConstructor(SYMBOL* sp, SYMBOL* cons)
                 syms = localNameSpace->valueData->syms;
                 localNameSpace->valueData->syms = basetype(consfunc->tp)->syms;
                 params->thisptr = thisptr;
-                params->thistp = MakeType(bt_pointer, sp->tp);
+                params->thistp = MakeThisPointerType(sp->tp);
                 params->fcall = varNode(en_pc, match);
                 params->functp = match->tp;
                 params->sp = match;
@@ -2873,7 +2873,7 @@ static void genAsnCall(BLOCKDATA* b, SYMBOL* cls, SYMBOL* base, int offset, EXPR
     params->arguments->tp = tp;
     params->arguments->exp = right;
     params->thisptr = left;
-    params->thistp = MakeType(bt_pointer, base->tp);
+    params->thistp = MakeThisPointerType(base->tp);
     params->ascall = true;
     asn1 = GetOverloadedFunction(&tp, &params->fcall, cons, params, nullptr, true, false, true, 0);
 
@@ -3228,7 +3228,7 @@ bool callDestructor(SYMBOL* sp, SYMBOL* against, EXPRESSION** exp, EXPRESSION* a
         diag("callDestructor: no this pointer");
     }
     params->thisptr = *exp;
-    params->thistp = MakeType(bt_pointer, sp->tp);
+    params->thistp = MakeThisPointerType(sp->tp);
     params->ascall = true;
     dest1 = basetype(dest->tp)->syms->table[0]->p;
     if (!dest1 || !dest1->sb->defaulted || dest1->sb->storage_class == sc_virtual)
@@ -3341,7 +3341,7 @@ bool callConstructor(TYPE** tp, EXPRESSION** exp, FUNCTIONCALL* params, bool che
         }
     }
     params->thisptr = *exp;
-    params->thistp = MakeType(bt_pointer, sp->tp);
+    params->thistp = MakeThisPointerType(sp->tp);
     params->ascall = true;
 
     cons1 = GetOverloadedFunction(tp, &params->fcall, cons, params, nullptr, toErr, maybeConversion, true, usesInitList | _F_INCONSTRUCTOR | (inNothrowHandler ? _F_IS_NOTHROW : 0));
@@ -3362,7 +3362,7 @@ bool callConstructor(TYPE** tp, EXPRESSION** exp, FUNCTIONCALL* params, bool che
                 error(ERR_IMPLICIT_USE_OF_EXPLICIT_CONVERSION);
             oparams->fcall = params->fcall;
             oparams->thisptr = params->arguments->exp;
-            oparams->thistp = MakeType(bt_pointer, cons1->sb->parentClass->tp);
+            oparams->thistp = MakeThisPointerType(cons1->sb->parentClass->tp);
             oparams->functp = cons1->tp;
             oparams->sp = cons1;
             oparams->ascall = true;
@@ -3449,7 +3449,7 @@ bool callConstructor(TYPE** tp, EXPRESSION** exp, FUNCTIONCALL* params, bool che
                     diag("callDestructor: no this pointer");
                 }
                 params->thisptr = *exp;
-                params->thistp = MakeType(bt_pointer, sp->tp);
+                params->thistp = MakeThisPointerType(sp->tp);
                 params->ascall = true;
                 dest1 = GetOverloadedFunction(&tp, &params->fcall, dest, params, nullptr, true, false, true, 0);
                 if (dest1 &&
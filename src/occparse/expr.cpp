@@ -1434,7 +1434,7 @@ static LEXLIST* expression_member(LEXLIST* lex, SYMBOL* funcsp, TYPE** tp, EXPRE
                         EXPRESSION* exp1 = nullptr;
                         lex = getArgs(lex, funcsp, funcparams, closepa, true, flags);
                         funcparams->thisptr = intNode(en_c_i, 0);
-                        funcparams->thistp = MakeType(bt_pointer, *tp);
+                        funcparams->thistp = MakeThisPointerType(*tp);
                         funcparams->ascall = true;
                         match = GetOverloadedFunction(&tp1, &exp1, sp2, funcparams, nullptr, true, false, true, flags);
                         if (match)
@@ -1541,7 +1541,7 @@ static LEXLIST* expression_member(LEXLIST* lex, SYMBOL* funcsp, TYPE** tp, EXPRE
                     }
                     funcparams->sp = sp2;
                     funcparams->thisptr = *exp;
-                    funcparams->thistp = MakeType(bt_pointer, basetp);
+                    funcparams->thistp = MakeThisPointerType(basetp);
 
                     if (!points && (*exp)->type != en_l_ref && !typein->lref && !typein->rref)
                         funcparams->novtab = true;
@@ -7375,7 +7375,7 @@ static LEXLIST* expression_pm(LEXLIST* lex, SYMBOL* funcsp, TYPE* atp, TYPE** tp
                     funcparams->fcall = exp1;
                     deref(&stdpointer, &funcparams->fcall);
                     funcparams->thisptr = *exp;
-                    funcparams->thistp = MakeType(bt_pointer, *tp);
+                    funcparams->thistp = MakeThisPointerType(*tp);
                     *exp = varNode(en_func, nullptr);
                     (*exp)->v.func = funcparams;
                     *tp = basetype(tp1);
@@ -297,7 +297,7 @@ bool castToArithmeticInternal(bool integer, TYPE** tp, EXPRESSION** exp, enum e_
             EXPRESSION* e1;
             params->fcall = varNode(en_pc, cst);
             params->thisptr = *exp;
-            params->thistp = MakeType(bt_pointer, cst->sb->parentClass->tp);
+            params->thistp = MakeThisPointerType(cst->sb->parentClass->tp);
             params->functp = cst->tp;
             params->sp = cst;
             params->ascall = true;
@@ -396,7 +396,7 @@ bool castToPointer(TYPE** tp, EXPRESSION** exp, enum e_kw kw, TYPE* other)
                 *exp = DerivedToBase(cst->sb->parentClass->tp, *tp, *exp, 0);
                 params->fcall = varNode(en_pc, cst);
                 params->thisptr = *exp;
-                params->thistp = MakeType(bt_pointer, cst->sb->parentClass->tp);
+                params->thistp = MakeThisPointerType(cst->sb->parentClass->tp);
                 params->functp = cst->tp;
                 params->sp = cst;
                 params->ascall = true;
@@ -442,7 +442,7 @@ bool cppCast(TYPE* src, TYPE** tp, EXPRESSION** exp)
                 *exp = DerivedToBase(cst->sb->parentClass->tp, src, *exp, 0);
                 params->fcall = varNode(en_pc, cst);
                 params->thisptr = *exp;
-                params->thistp = MakeType(bt_pointer, cst->sb->parentClass->tp);
+                params->thistp = MakeThisPointerType(cst->sb->parentClass->tp);
                 params->functp = cst->tp;
                 params->sp = cst;
                 params->ascall = true;
@@ -1296,7 +1296,7 @@ bool insertOperatorParams(SYMBOL* funcsp, TYPE** tp, EXPRESSION** exp, FUNCTIONC
         addStructureDeclaration(&l);
         s2 = classsearch(name, false, true);
         dropStructureDeclaration();
-        funcparams->thistp = MakeType(bt_pointer, basetype(*tp));
+        funcparams->thistp = MakeThisPointerType(basetype(*tp));
         funcparams->thisptr = *exp;
     }
     // quit if there are no matches because we will use the default...
@@ -1637,7 +1637,7 @@ bool insertOperatorFunc(enum ovcl cls, enum e_kw kw, SYMBOL* funcsp, TYPE** tp,
         if (ismember(s3))
         {
             funcparams->arguments = funcparams->arguments->next;
-            funcparams->thistp = MakeType(bt_pointer, tpin);
+            funcparams->thistp = MakeThisPointerType(tpin);
             funcparams->thisptr = *exp;
         }
         s3->sb->throughClass = s3->sb->parentClass != nullptr;
@@ -76,7 +76,7 @@ Optimizer::IMODE* structret_imode;
 SYMBOL* inlinesp_list[MAX_INLINE_NESTING];
 int inlinesp_count;
 
-static Optimizer::DAGLIST* name_value_hash[DAGSIZE];
+static Optimizer::DAGHASH name_value_hash("name_value_hash");
 static Optimizer::LIST* incdecList;
 static Optimizer::LIST* incdecListLast;
 static int push_nesting;
@@ -102,9 +102,9 @@ void iexpr_init(void)
 }
 void iexpr_func_init(void)
 {
-    memset(name_value_hash, 0, sizeof(Optimizer::DAGLIST*) * DAGSIZE);
+    name_value_hash.Clear();
     Optimizer::loadHash.clear();
-    memset(Optimizer::castHash, 0, sizeof(Optimizer::castHash));
+    Optimizer::castHash.Clear();
     incdecList = nullptr;
 }
 
@@ -1124,7 +1124,14 @@ void dumpInitGroup(SYMBOL* sym, TYPE* tp)
                                 Optimizer::genstorage(init->offset - pos);
                             pos = init->offset;
                         }
-                        if (init->basetp && basetype(init->basetp)->hasbits)
+                        if (init->packed)
+                        {
+                            // the assembly file shows the block as plain data bytes
+                            Optimizer::putstring(init->packed, init->packedSize);
+                            pos += init->packedSize;
+                            init = init->next;
+                        }
+                        else if (init->basetp && basetype(init->basetp)->hasbits)
                         {
                             pos += dumpBits(&init);
                         }
@@ -2584,6 +2591,178 @@ static void set_array_sizes(AGGREGATE_DESCRIPTOR* cache)
         cache = cache->next;
     }
 }
+/* big constant tables, e.g. lookup tables, fonts and firmware images, are kept as one block of bytes
+ * rather than an INITIALIZER and EXPRESSION per element.  This is only done for one dimensional arrays
+ * of integer and floating point values with static storage, when every element is a plain literal;
+ * anything else goes through the general code below.  The packed block is written out as a single
+ * string by dumpInitGroup.
+ */
+static bool packable_array(TYPE* itype, SYMBOL* base, int offset, enum e_sc sc, INITIALIZER** init, bool arrayMember, int flags)
+{
+    TYPE* btp;
+    if (Optimizer::architecture == ARCHITECTURE_MSIL || Optimizer::chosenAssembler->arch->big_endian)
+        return false;
+    if (!isarray(itype) || basetype(itype)->vla || basetype(itype)->msil || offset || arrayMember || (flags & _F_NESTEDINIT))
+        return false;
+    if (sc != sc_global && sc != sc_static && sc != sc_localstatic)
+        return false;
+    if (!base || init != &base->sb->init || base->sb->constexpression || base->sb->parentClass || base->templateParams ||
+        templateNestingCount)
+        return false;
+    btp = basetype(itype)->btp;
+    if (isatomic(btp) || basetype(btp)->hasbits)
+        return false;
+    switch (basetype(btp)->type)
+    {
+        case bt_signed_char:
+        case bt_char:
+        case bt_unsigned_char:
+        case bt_short:
+        case bt_char16_t:
+        case bt_unsigned_short:
+        case bt_wchar_t:
+        case bt_int:
+        case bt_inative:
+        case bt_char32_t:
+        case bt_unsigned:
+        case bt_unative:
+        case bt_long:
+        case bt_unsigned_long:
+        case bt_long_long:
+        case bt_unsigned_long_long:
+        case bt_float:
+        case bt_double:
+            return true;
+        default:
+            return false;
+    }
+}
+// returns false if the value has to be converted by the general code, e.g. it doesn't fit
+static bool pack_literal(TYPE* btp, LEXLIST* lex, bool negate, std::vector<char>& buf)
+{
+    int size = btp->size;
+    if (lex->data->suffix)
+        return false;
+    if (btp->type == bt_float || btp->type == bt_double)
+    {
+        FPF f;
+        unsigned char data[8];
+        switch (lex->data->type)
+        {
+            case l_f:
+            case l_d:
+                f = *lex->data->value.f;
+                break;
+            case l_i:
+            case l_l:
+            case l_ll:
+            case l_achr:
+                // integers that are exactly representable
+                if (lex->data->value.i < 0 || lex->data->value.i >= (1LL << (btp->type == bt_float ? 24 : 53)))
+                    return false;
+                f = (long long)lex->data->value.i;
+                break;
+            default:
+                return false;
+        }
+        if (negate)
+            f.Negate();
+        if (btp->type == bt_float && size == 4)
+            f.ToFloat(data);
+        else if (btp->type == bt_double && size == 8)
+            f.ToDouble(data);
+        else
+            return false;
+        buf.insert(buf.end(), data, data + size);
+        return true;
+    }
+    unsigned long long maxUnsigned = size >= 8 ? ~0ULL : (1ULL << (size * 8)) - 1;
+    unsigned long long maxSigned = maxUnsigned >> 1;
+    unsigned long long value = lex->data->value.i;
+    switch (lex->data->type)
+    {
+        case l_i:
+        case l_l:
+        case l_ll:
+        case l_achr:
+            if (lex->data->value.i < 0)
+                return false;
+            break;
+        case l_ui:
+        case l_ul:
+        case l_ull:
+            if (negate)
+                return false;
+            break;
+        default:
+            return false;
+    }
+    if (btp->type == bt_char || btp->type == bt_wchar_t || btp->type == bt_char16_t || btp->type == bt_char32_t)
+    {
+        // character types, only take values that mean the same thing whether they are signed or not
+        if ((negate && value) || value > maxSigned)
+            return false;
+    }
+    else if (!isunsigned(btp))
+    {
+        if (value > maxSigned + negate)
+            return false;
+    }
+    else if (negate ? value != 0 : value > maxUnsigned)
+    {
+        return false;
+    }
+    if (negate)
+        value = -value;
+    for (int i = 0; i < size; i++)
+        buf.push_back((char)(value >> (i * 8)));
+    return true;
+}
+static LEXLIST* initialize_packed_array(LEXLIST* lex, TYPE* itype, int offset, INITIALIZER** init, bool* packed)
+{
+    LEXLIST* placeholder = lex;
+    TYPE* btp = basetype(basetype(itype)->btp);
+    std::vector<char> buf;
+    *packed = false;
+    while (true)
+    {
+        bool negate = MATCHKW(lex, minus);
+        if (negate || MATCHKW(lex, plus))
+            lex = getsym();
+        if (!lex || !pack_literal(btp, lex, negate, buf))
+            return backupReadAhead(placeholder);
+        lex = getsym();
+        if (MATCHKW(lex, comma))
+        {
+            lex = getsym();
+            if (!MATCHKW(lex, end))
+                continue;
+        }
+        if (!MATCHKW(lex, end))
+            return backupReadAhead(placeholder);
+        break;
+    }
+    // too many initializers, let the general code complain about it
+    if (itype->size && buf.size() > itype->size)
+        return backupReadAhead(placeholder);
+    lex = getsym();
+    if (itype->size == 0)
+    {
+        TYPE* temp = itype;
+        while (temp && temp->size == 0)
+        {
+            temp->size = buf.size();
+            temp->esize = intNode(en_c_i, buf.size() / btp->size);
+            temp = temp->btp;
+        }
+    }
+    INITIALIZER* it = initInsert(init, itype, nullptr, offset, false);
+    it->packed = Allocate<char>(buf.size());
+    it->packedSize = buf.size();
+    memcpy(it->packed, buf.data(), buf.size());
+    *packed = true;
+    return lex;
+}
 static LEXLIST* read_strings(LEXLIST* lex, INITIALIZER** next, AGGREGATE_DESCRIPTOR** desc)
 {
     bool nothingWritten = true;
@@ -3271,6 +3450,13 @@ static LEXLIST* initialize_aggregate_type(LEXLIST* lex, SYMBOL* funcsp, SYMBOL*
             needend = true;
         }
     }
+    if (needend && packable_array(itype, base, offset, sc, init, arrayMember, flags))
+    {
+        bool packed;
+        lex = initialize_packed_array(lex, itype, offset, init, &packed);
+        if (packed)
+            return lex;
+    }
     if (needend && MATCHKW(lex, end))
     {
         // empty braces
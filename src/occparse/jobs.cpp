@@ -0,0 +1,137 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#include "compiler.h"
+#include "jobs.h"
+#include "osutil.h"
+#include "ilstream.h"
+#include "SharedMemory.h"
+#include "Utils.h"
+#include <cstdio>
+#include <algorithm>
+#include <thread>
+
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#else
+#    include <io.h>
+#endif
+
+namespace Parser
+{
+static int CountFiles()
+{
+    int rv = 0;
+    for (auto c = clist; c; c = c->next)
+        rv++;
+    return rv;
+}
+bool RunJobs(int jobs, const std::vector<std::string>& args, SharedMemory* parserMem)
+{
+    int count = CountFiles();
+    if (jobs > count)
+        jobs = count;
+    std::string commandLine;
+    for (auto&& arg : args)
+    {
+        std::string curArg = arg;
+        if (curArg.size() && curArg[curArg.size() - 1] == '\\')
+            curArg += "\\";
+        Utils::ReplaceAll(curArg, "\"", "\\\"");
+        commandLine += std::string("\"") + curArg + "\" ";
+    }
+    std::vector<std::string> names(jobs);
+    std::vector<int> results(jobs);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < jobs; i++)
+    {
+        FILE* fil = Utils::TempName(names[i]);
+        fclose(fil);
+        std::string jobLine =
+            commandLine + "\"--job=" + Utils::NumberToString(i) + ";" + Utils::NumberToString(jobs) + ";" + names[i] + "\"";
+        threads.push_back(
+            std::thread([i, jobLine, &results]() { results[i] = Utils::ToolInvoke("occparse", nullptr, "%s", jobLine.c_str()); }));
+    }
+    for (auto&& t : threads)
+        t.join();
+    bool rv = false;
+    for (int i = 0; i < jobs; i++)
+    {
+        if (results[i])
+            rv = true;
+        std::string log = names[i] + ".log";
+        FILE* fil = fopen(log.c_str(), "rb");
+        if (fil)
+        {
+            char buf[4096];
+            size_t n;
+            while ((n = fread(buf, 1, sizeof(buf), fil)) > 0)
+                fwrite(buf, 1, n, stdout);
+            fclose(fil);
+            remove(log.c_str());
+        }
+        fil = fopen(names[i].c_str(), "rb");
+        if (fil)
+        {
+            Optimizer::AppendMappingFile(parserMem, fil);
+            fclose(fil);
+        }
+        else
+        {
+            rv = true;
+        }
+        remove(names[i].c_str());
+    }
+    return rv;
+}
+std::string SelectJobFiles(const std::string& spec)
+{
+    size_t first = spec.find(';');
+    size_t second = first == std::string::npos ? first : spec.find(';', first + 1);
+    if (second == std::string::npos)
+        Utils::fatal("invalid job specification");
+    int job = Utils::StringToNumber(spec.substr(0, first));
+    int jobs = Utils::StringToNumber(spec.substr(first + 1, second - first - 1));
+    // each job gets a run of consecutive files, the first 'count % jobs' runs are one file longer
+    int count = CountFiles();
+    int start = job * (count / jobs) + std::min(job, count % jobs);
+    int size = count / jobs + (job < count % jobs ? 1 : 0);
+    Optimizer::LIST** find = &clist;
+    for (int i = 0; i < start && *find; i++)
+        find = &(*find)->next;
+    clist = *find;
+    for (int i = 0; i < size && *find; i++)
+        find = &(*find)->next;
+    *find = nullptr;
+    // the jobs run at the same time, so what each one prints is collected in a file and the parent
+    // shows them one after the other
+    std::string output = spec.substr(second + 1);
+    if (freopen((output + ".log").c_str(), "w", stdout))
+    {
+        setvbuf(stdout, nullptr, _IONBF, 0);
+        dup2(fileno(stdout), fileno(stderr));
+    }
+    return output;
+}
+}  // namespace Parser
@@ -0,0 +1,42 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+class SharedMemory;
+
+namespace Parser
+{
+// -j support.   The files on the command line are split into runs of consecutive files and each
+// run is compiled by another copy of occparse into a temporary intermediate file.   The results are
+// then added to the output in command line order, so the optimizer sees the same thing a serial
+// compile would have given it.   Returns true if any of the jobs failed.
+bool RunJobs(int jobs, const std::vector<std::string>& args, SharedMemory* parserMem);
+// in a process started by RunJobs, drop the files that belong to other jobs.   'spec' is the value of
+// the --job switch, the return value is the name of the file the job's output goes to.
+std::string SelectJobFiles(const std::string& spec);
+}  // namespace Parser
@@ -29,8 +29,10 @@
 #include "math.h"
 #include <limits.h>
 #include "Utils.h"
+#include "PerfectHash.h"
 #include "PreProcessor.h"
 #include <stack>
+#include <map>
 #include "lex.h"
 #include "ccerr.h"
 #include "config.h"
@@ -71,9 +73,18 @@ static int nextFree;
 static const unsigned char* linePointer;
 static std::string currentLine;
 static int lastBrowseIndex;
-#ifdef KW_HASH
-HASHTABLE* kwhash;
-#endif
+// searchkw keeps the hash of every prefix of a punctuator, there is room for this many
+static const int MAX_PUNCT_LEN = 16;
+// the keywords of a language mode.   They are built once per mode and kept, the compile server
+// builds the common ones before it starts taking requests so its workers don't have to
+struct KeywordTable
+{
+    PerfectHash<KEYWORD*> hash;
+    int maxPunctLen;
+};
+static std::map<int, KeywordTable> keywordTables;
+// the keywords of the current language mode
+static KeywordTable* kwtable;
 
 struct ParseHold
 {
@@ -400,22 +411,68 @@ KEYWORD keywords[] = {
 
 #define TABSIZE (sizeof(keywords) / sizeof(keywords[0]))
 static bool kwmatches(KEYWORD* kw);
+// the switches kwmatches looks at
+static int kwmode(void)
+{
+    int mode = 0;
+    if (Optimizer::cparams.prm_assemble)
+        mode |= 1;
+    if (Optimizer::cparams.prm_cplusplus)
+        mode |= 2;
+    if (Optimizer::architecture == ARCHITECTURE_MSIL && Optimizer::cparams.msilAllowExtensions)
+        mode |= 4;
+    if (!Optimizer::cparams.prm_ansi)
+        mode |= 8;
+    return mode;
+}
+static KeywordTable* kwload(void)
+{
+    auto it = keywordTables.find(kwmode());
+    if (it != keywordTables.end())
+        return &it->second;
+    KeywordTable* table = &keywordTables[kwmode()];
+    table->maxPunctLen = 0;
+    for (int i = 0; i < TABSIZE; i++)
+    {
+        // a few of the gcc style __atomic names have the wrong length and have never been recognized,
+        // leave them as identifiers
+        if (kwmatches(&keywords[i]) && strlen(keywords[i].name) == keywords[i].len)
+        {
+            table->hash.Add(keywords[i].name, &keywords[i]);
+            if (!isstartchar((unsigned char)keywords[i].name[0]) && keywords[i].len > table->maxPunctLen)
+                table->maxPunctLen = keywords[i].len;
+        }
+    }
+    if (table->maxPunctLen > MAX_PUNCT_LEN)
+        table->maxPunctLen = MAX_PUNCT_LEN;
+    if (!table->hash.Build())
+        diag("lexini: cannot build keyword table");
+    return table;
+}
+void kwpreload(void)
+/*
+ * build the keyword tables for C and C++, with and without -A
+ */
+{
+    bool oldcplusplus = Optimizer::cparams.prm_cplusplus;
+    bool oldansi = Optimizer::cparams.prm_ansi;
+    for (int i = 0; i < 4; i++)
+    {
+        Optimizer::cparams.prm_cplusplus = !!(i & 1);
+        Optimizer::cparams.prm_ansi = !!(i & 2);
+        kwload();
+    }
+    Optimizer::cparams.prm_cplusplus = oldcplusplus;
+    Optimizer::cparams.prm_ansi = oldansi;
+}
 void lexini(void)
 /*
- * create a keyword hash table
+ * select the keyword table for the current language mode
  */
 {
     bool old = Optimizer::cparams.prm_extwarning;
     Optimizer::cparams.prm_extwarning = false;
-#ifdef KW_HASH
-    int i;
-    kwhash = CreateHashTable(1024);
-    for (i = 0; i < TABSIZE; i++)
-    {
-        if (kwmatches(&keywords[i]))
-            insert((SYMBOL*)&keywords[i], kwhash);
-    }
-#endif
+    kwtable = kwload();
     llminus1 = 0;
     llminus1--;
     context = Allocate<LEXCONTEXT>();
@@ -430,36 +487,6 @@ void lexini(void)
 
 /*-------------------------------------------------------------------------*/
 
-#ifndef KW_HASH
-static KEYWORD* binarySearch(char* name)
-{
-    int top = TABSIZE;
-    int bottom = -1;
-    int v;
-    KEYWORD* kw;
-    while (top - bottom > 1)
-    {
-        int mid = (top + bottom) / 2;
-        kw = &keywords[mid];
-        v = strncmp(name, kw->name, kw->len);
-        if (v < 0)
-        {
-            top = mid;
-        }
-        else
-        {
-            bottom = mid;
-        }
-    }
-    if (bottom == -1)
-        return 0;
-    kw = &keywords[bottom];
-    v = strncmp(name, kw->name, kw->len);
-    if (v)
-        return 0;
-    return &keywords[bottom];
-}
-#endif
 static bool kwmatches(KEYWORD* kw)
 {
     if (Optimizer::cparams.prm_assemble)
@@ -484,84 +511,52 @@ KEYWORD* searchkw(const unsigned char** p)
  * see if the current symbol is a keyword
  */
 {
-    KEYWORD* kw;
-    unsigned char buf[1000], *q = buf;
     const unsigned char* q1 = *p;
+    PerfectHash<KEYWORD*>::Hasher hash;
     if (isstartchar(*q1))
     {
-        int len = 0;
         while (issymchar(*q1))
+            hash.Add(*q1++);
+        KEYWORD* const* found = kwtable->hash.Lookup((const char*)*p, q1 - *p, hash.Value());
+        if (found)
         {
-            len++;
-            *q++ = *q1++;
-        }
-        *q = 0;
-#ifdef KW_HASH
-        kw = (KEYWORD*)search((char*)buf, kwhash);
-        if (kw)
-#else
-        kw = (KEYWORD*)binarySearch(buf);
-        if (kw && kwmatches(kw))
-#endif
-        {
-            if (len == kw->len)
+            KEYWORD* kw = *found;
+            if (kw->matchFlags & (KW_C99 | KW_C1X))
             {
                 int count = 0;
-                if (kw->matchFlags & (KW_C99 | KW_C1X))
+                if (Optimizer::cparams.prm_c99 && (kw->matchFlags & KW_C99))
+                    count++;
+                if (Optimizer::cparams.prm_c1x && (kw->matchFlags & KW_C1X))
+                    count++;
+                if (Optimizer::cparams.prm_cplusplus && (kw->matchFlags & KW_CPLUSPLUS))
+                    count++;
+                if (!count)
                 {
-                    if (Optimizer::cparams.prm_c99 && (kw->matchFlags & KW_C99))
-                        count++;
-                    if (Optimizer::cparams.prm_c1x && (kw->matchFlags & KW_C1X))
-                        count++;
-                    if (Optimizer::cparams.prm_cplusplus && (kw->matchFlags & KW_CPLUSPLUS))
-                        count++;
-                    if (!count)
-                    {
-                        errorstr(ERR_C99_KEYWORD, (char*)buf);
-                        return nullptr;
-                    }
+                    errorstr(ERR_C99_KEYWORD, (char*)kw->name);
+                    return nullptr;
                 }
-                *p = *p + len;
-                return kw;
             }
+            *p = q1;
+            return kw;
         }
     }
     else
     {
-        KEYWORD* found = nullptr;
-#ifdef KW_HASH
+        // longest match, so keep the hash of each prefix
+        unsigned long long prefixes[MAX_PUNCT_LEN];
         int len = 0;
-        while (ispunct((unsigned char)*q1))
-            *q++ = *q1++, len++;
-        if (len)
+        while (len < kwtable->maxPunctLen && ispunct(*q1))
         {
-            buf[len] = 0;
-            while (len && (found = (KEYWORD*)search((char*)buf, kwhash)) == nullptr)
-            {
-                buf[--len] = 0;
-            }
-            if (found)
-#else
-        *q++ = *q1++;
-        *q = 0;
-        kw = (KEYWORD*)binarySearch(buf);
-        if (kw)
+            hash.Add(*q1++);
+            prefixes[len++] = hash.Value();
+        }
+        for (; len; len--)
         {
-            KEYWORD* list = kw;
-            found = kw;
-            while (list < &keywords[0] + sizeof(keywords) / sizeof(keywords[0]) && buf[0] == list->name[0])
-            {
-                if (!strncmp(list->name, *p, list->len))
-                {
-                    found = list;
-                }
-                list++;
-            }
-            if (kwmatches(found))
-#endif
+            KEYWORD* const* found = kwtable->hash.Lookup((const char*)*p, len, prefixes[len - 1]);
+            if (found)
             {
-                *p = *p + found->len;
-                return found;
+                *p = *p + len;
+                return *found;
             }
         }
     }
@@ -1637,7 +1632,11 @@ LEXLIST* getsym(void)
             TemplateRegisterDeferred(context->last);
         context->last = rv;
         context->cur = context->cur->next;
-        if (rv->data->linedata && rv->data->linedata != &nullLineData)
+        // a token an initializer read ahead may still belong to the current list of lines, and then
+        // the list has to be left alone so lines read since aren't lost
+        bool keepLines = rv->data->readAhead && rv->data->linedata == linesHead;
+        rv->data->readAhead = false;
+        if (rv->data->linedata && rv->data->linedata != &nullLineData && !keepLines)
         {
             linesHead = rv->data->linedata;
             linesTail = linesHead;
@@ -1664,6 +1663,7 @@ LEXLIST* getsym(void)
     if (++nextFree >= MAX_LOOKBACK)
         nextFree = 0;
     lex->data->registered = false;
+    lex->data->readAhead = false;
     if (!parsingPreprocessorConstant)
         TemplateRegisterDeferred(last);
     last = nullptr;
@@ -1879,6 +1879,14 @@ LEXLIST* prevsym(LEXLIST* lex)
     }
     return lex;
 }
+// backs up over the tokens a packed array initializer read ahead before it found it had to use
+// the general code
+LEXLIST* backupReadAhead(LEXLIST* lex)
+{
+    for (LEXLIST* p = lex ? lex->next : nullptr; p; p = p->next)
+        p->data->readAhead = true;
+    return prevsym(lex);
+}
 LEXLIST* backupsym(void)
 {
     if (context->cur)
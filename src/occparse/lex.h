@@ -23,8 +23,6 @@
  *
  */
 
-#define KWHASHSIZE 253
-#define KW_HASH
 #define MAX_LOOKBACK 1024
 namespace Parser
 {
@@ -34,9 +32,9 @@ extern const char* eofFile;
 extern bool parsingPreprocessorConstant;
 extern LEXCONTEXT* context;
 extern int charIndex;
-extern HASHTABLE* kwhash;
 extern LEXLIST* currentLex;
 
+void kwpreload(void);
 void lexini(void);
 KEYWORD* searchkw(const unsigned char** p);
 LEXLIST* SkipToNextLine(void);
@@ -46,6 +44,7 @@ bool AtEol();
 void CompilePragma(const unsigned char** linePointer);
 LEXLIST* getsym(void);
 LEXLIST* prevsym(LEXLIST* lex);
+LEXLIST* backupReadAhead(LEXLIST* lex);
 LEXLIST* backupsym(void);
 LEXLIST* SetAlternateLex(LEXLIST* lexList);
 bool CompareLex(LEXLIST* left, LEXLIST* right);
@@ -58,6 +58,11 @@
 #include "iinline.h"
 #include "iexpr.h"
 #include "help.h"
+#include "cpplookup.h"
+#include "server.h"
+#include "jobs.h"
+#include "compilecache.h"
+#include "FileCache.h"
 #include "inasm.h"
 #include "expr.h"
 #include "constopt.h"
@@ -68,6 +73,7 @@
 #include "irc.h"
 #include "DotNetPELib.h"
 #include "constexpr.h"
+#include "Trace.h"
 
 using namespace DotNetPELib;
 PELib* peLib;
@@ -265,6 +271,7 @@ void compile(bool global)
     lexini();
     setglbdefs();
     templateInit();
+    overloadCacheInit();
     if (Optimizer::architecture != ARCHITECTURE_MSIL)
     {
         Optimizer::nextLabel = 1;
@@ -309,10 +316,13 @@ void compile(bool global)
     else
     {
         lex = getsym();
-        if (lex)
+        while (lex)
         {
-            while ((lex = declare(lex, nullptr, nullptr, sc_global, lk_none, nullptr, true, false, false, ac_public)) != nullptr)
-                ;
+            TraceSpan span;
+            if (Trace::Enabled())
+                span.Start("parse", "declaration",
+                           (std::string(lex->data->errfile) + ":" + std::to_string(lex->data->errline)).c_str());
+            lex = declare(lex, nullptr, nullptr, sc_global, lk_none, nullptr, true, false, false, ac_public);
         }
     }
     if (!IsCompiler())
@@ -321,6 +331,7 @@ void compile(bool global)
     }
     if (!TotalErrors())
     {
+        TraceSpan span("parse", "inline functions and initializers");
         dumpInlines();
         dumpInitializers();
         dumpInlines();
@@ -342,6 +353,96 @@ void compile(bool global)
 /*-------------------------------------------------------------------------*/
 
 void enter_filename(const char* name) { Optimizer::inputFiles.push_back(name); }
+/* work out the language of a file from the switches or its extension */
+void SelectLanguage(const char* name)
+{
+    // start from what the command line asked for each time, so the settings used for a file
+    // don't depend on what was compiled before it
+    static bool c99 = Optimizer::cparams.prm_c99, c1x = Optimizer::cparams.prm_c1x;
+    Optimizer::cparams.prm_c99 = c99;
+    Optimizer::cparams.prm_c1x = c1x;
+    Optimizer::cparams.prm_cplusplus = false;
+    if (prm_std.GetExists())
+    {
+        if (prm_std.GetValue() == "c89")
+        {
+            Optimizer::cparams.prm_c99 = Optimizer::cparams.prm_c1x = false;
+        }
+        else if (prm_std.GetValue() == "c99")
+        {
+            Optimizer::cparams.prm_c99 = true;
+            Optimizer::cparams.prm_c1x = false;
+        }
+        else if (prm_std.GetValue() == "c11")
+        {
+            Optimizer::cparams.prm_c99 = true;
+            Optimizer::cparams.prm_c1x = true;
+        }
+        else if (prm_std.GetValue() == "c++11")
+        {
+            cplusplusversion = 11;
+            Optimizer::cparams.prm_c99 = false;
+            Optimizer::cparams.prm_c1x = false;
+            Optimizer::cparams.prm_cplusplus = true;
+        }
+        else if (prm_std.GetValue() == "c++14")
+        {
+            cplusplusversion = 14;
+            Optimizer::cparams.prm_c99 = false;
+            Optimizer::cparams.prm_c1x = false;
+            Optimizer::cparams.prm_cplusplus = true;
+        }
+        else if (prm_std.GetValue() == "c++17")
+        {
+            cplusplusversion = 17;
+            Optimizer::cparams.prm_c99 = false;
+            Optimizer::cparams.prm_c1x = false;
+            Optimizer::cparams.prm_cplusplus = true;
+        }
+        else
+        {
+            Utils::fatal("value given for 'std' argument unknown: %s", prm_std.GetValue().c_str());
+        }
+    }
+    else if (prm_language.GetExists())
+    {
+        if (prm_language.GetValue() == "c++")
+        {
+            Optimizer::cparams.prm_cplusplus = true;
+            Optimizer::cparams.prm_c99 = Optimizer::cparams.prm_c1x = false;
+        }
+        else if (prm_language.GetValue() != "c")
+        {
+            Utils::fatal("Unknown language specifier: %s\n", prm_language.GetValue().c_str());
+        }
+    }
+    else
+    {
+        static const std::list<std::string> cppExtensions = {".h", ".hh", ".hpp", ".hxx", ".hm", ".cpp", ".cxx", ".cc", ".c++"};
+        for (auto& str : cppExtensions)
+        {
+            if (Utils::HasExt(name, str.c_str()))
+            {
+                Optimizer::cparams.prm_cplusplus = true;
+                Optimizer::cparams.prm_c99 = Optimizer::cparams.prm_c1x = false;
+                break;
+            }
+        }
+    }
+    if (Optimizer::cparams.prm_cplusplus && (Optimizer::architecture == ARCHITECTURE_MSIL))
+        Utils::fatal("MSIL compiler does not compile C++ files at this time");
+}
+/* a preprocessor set up for the current file and language settings */
+PreProcessor* OpenPreProcessor(const char* name)
+{
+    return new PreProcessor(name, prm_cinclude.GetValue(),
+                            Optimizer::cparams.prm_cplusplus ? prm_CPPsysinclude.GetValue() : prm_Csysinclude.GetValue(), true,
+                            Optimizer::cparams.prm_trigraph, '#', Optimizer::cparams.prm_charisunsigned,
+                            !Optimizer::cparams.prm_c99 && !Optimizer::cparams.prm_c1x && !Optimizer::cparams.prm_cplusplus,
+                            !Optimizer::cparams.prm_ansi,
+                            (MakeStubsOption.GetValue() || MakeStubsUser.GetValue()) && MakeStubsMissingHeaders.GetValue(),
+                            prm_pipe.GetValue() != "+" ? prm_pipe.GetValue() : "");
+}
 }  // namespace Parser
 int main(int argc, char* argv[])
 {
@@ -357,6 +458,27 @@ int main(int argc, char* argv[])
     /*   signal(SIGSEGV,internalError) ;*/
     /*   signal(SIGFPE, internalError) ;*/
 
+    std::vector<std::string> serverArgs;
+    std::vector<char*> serverArgv;
+    if (argc == 3 && !strcmp(argv[1], "--server"))
+    {
+        // the server only comes back here in a worker process that has been handed a compile.
+        // most of the parser's state depends on the switches in the request and lives in memory
+        // that is released between files, but the keyword tables can be shared with the workers
+        kwpreload();
+        if (!RunServer(argv[2], serverArgs))
+            return 1;
+        serverArgs[0] = argv[0];
+        for (auto&& arg : serverArgs)
+            serverArgv.push_back(&arg[0]);
+        serverArgv.push_back(nullptr);
+        argc = serverArgs.size();
+        argv = &serverArgv[0];
+    }
+    // -j starts more copies of the parser with the same arguments, and the switch parser is
+    // going to take them apart...
+    std::vector<std::string> jobArgs(argv + 1, argv + argc);
+
     /*
     if (Optimizer::chosenAssembler->Args)
     {
@@ -380,6 +502,12 @@ int main(int argc, char* argv[])
     /* loop through and preprocess all the files on the file list */
     if (clist && clist->next)
         multipleFiles = true;
+    // headers are usually shared between the files of a batch so keep them in memory.   The server
+    // has its own idea of what to cache
+    if (multipleFiles && !FileCache::Enabled())
+        FileCache::Enable(true);
+    if (prm_job.GetExists())
+        bePostFile.clear();  // jobs write to a file the parent process picks up
     const char* firstFile = clist ? (const char*)clist->data : "temp";
     SharedMemory* parserMem = nullptr;
     if (!IsCompiler())
@@ -395,7 +523,7 @@ int main(int argc, char* argv[])
         Parser::instructionParser = new x64Parser();
         if (bePostFile.size())
         {
-            parserMem = new SharedMemory(0, bePostFile.c_str());
+            parserMem = new SharedMemory(bePostFile);
             if (!parserMem->Open() || !parserMem->GetMapping())
                 Utils::fatal("internal error: invalid shared memory region");
             if (!clist)
@@ -405,7 +533,7 @@ int main(int argc, char* argv[])
         }
         else  // so we can do compiles without the output going anywhere...
         {
-            parserMem = new SharedMemory(240 * 1024 * 1024);
+            parserMem = new SharedMemory();
             parserMem->Create();
             compileToFile = true;
         }
@@ -414,6 +542,28 @@ int main(int argc, char* argv[])
     {
         enter_filename((const char*)c->data);
     }
+    std::string cached = CacheLookup();
+    if (cached.size() && !clist)
+    {
+        // everything came out of the compile cache, there is nothing for the optimizer or the backend to do
+        delete parserMem;
+        return 255;
+    }
+    std::string jobOutput;
+    if (prm_job.GetExists())
+    {
+        if (prm_jobSkip.GetExists())
+            SkipFiles(prm_jobSkip.GetValue());
+        jobOutput = SelectJobFiles(prm_job.GetValue());
+    }
+    else if (prm_jobs.GetValue() > 1 && multipleFiles && IsCompiler() && Optimizer::architecture != ARCHITECTURE_MSIL &&
+             !Optimizer::cparams.prm_makestubs)
+    {
+        if (cached.size())
+            jobArgs.push_back("--job-skip=" + cached);
+        stoponerr |= RunJobs(prm_jobs.GetValue(), jobArgs, parserMem);
+        clist = nullptr;
+    }
     //    mainPreprocess();
     bool first = true;
     while (clist)
@@ -429,7 +579,6 @@ int main(int argc, char* argv[])
         }
         first = false;
         Errors::Reset();
-        Optimizer::cparams.prm_cplusplus = false;
         strcpy(buffer, (char*)clist->data);
         if (IsCompiler())
         {
@@ -446,83 +595,8 @@ int main(int argc, char* argv[])
             CompletionCompiler::ccNewFile(buffer, true);
         }
         Utils::AddExt(buffer, ".C");
-        if (prm_std.GetExists())
-        {
-            if (prm_std.GetValue() == "c89")
-            {
-                Optimizer::cparams.prm_c99 = Optimizer::cparams.prm_c1x = false;
-            }
-            else if (prm_std.GetValue() == "c99")
-            {
-                Optimizer::cparams.prm_c99 = true;
-                Optimizer::cparams.prm_c1x = false;
-            }
-            else if (prm_std.GetValue() == "c11")
-            {
-                Optimizer::cparams.prm_c99 = true;
-                Optimizer::cparams.prm_c1x = true;
-            }
-            else if (prm_std.GetValue() == "c++11")
-            {
-                cplusplusversion = 11;
-                Optimizer::cparams.prm_c99 = false;
-                Optimizer::cparams.prm_c1x = false;
-                Optimizer::cparams.prm_cplusplus = true;
-            }
-            else if (prm_std.GetValue() == "c++14")
-            {
-                cplusplusversion = 14;
-                Optimizer::cparams.prm_c99 = false;
-                Optimizer::cparams.prm_c1x = false;
-                Optimizer::cparams.prm_cplusplus = true;
-            }
-            else if (prm_std.GetValue() == "c++17")
-            {
-                cplusplusversion = 17;
-                Optimizer::cparams.prm_c99 = false;
-                Optimizer::cparams.prm_c1x = false;
-                Optimizer::cparams.prm_cplusplus = true;
-            }
-            else
-            {
-                Utils::fatal("value given for 'std' argument unknown: %s", prm_std.GetValue().c_str());
-            }
-        }
-        else if (prm_language.GetExists())
-        {
-            if (prm_language.GetValue() == "c++")
-            {
-                Optimizer::cparams.prm_cplusplus = true;
-                Optimizer::cparams.prm_c99 = Optimizer::cparams.prm_c1x = false;
-            }
-            else if (prm_language.GetValue() != "c")
-            {
-                Utils::fatal("Unknown language specifier: %s\n", prm_language.GetValue().c_str());
-            }
-        }
-        else
-        {
-            static const std::list<std::string> cppExtensions = {".h", ".hh", ".hpp", ".hxx", ".hm", ".cpp", ".cxx", ".cc", ".c++"};
-            for (auto& str : cppExtensions)
-            {
-                if (Utils::HasExt(buffer, str.c_str()))
-                {
-                    Optimizer::cparams.prm_cplusplus = true;
-                    Optimizer::cparams.prm_c99 = Optimizer::cparams.prm_c1x = false;
-                    break;
-                }
-            }
-        }
-        if (Optimizer::cparams.prm_cplusplus && (Optimizer::architecture == ARCHITECTURE_MSIL))
-            Utils::fatal("MSIL compiler does not compile C++ files at this time");
-        preProcessor =
-            new PreProcessor(buffer, prm_cinclude.GetValue(),
-                             Optimizer::cparams.prm_cplusplus ? prm_CPPsysinclude.GetValue() : prm_Csysinclude.GetValue(), true,
-                             Optimizer::cparams.prm_trigraph, '#', Optimizer::cparams.prm_charisunsigned,
-                             !Optimizer::cparams.prm_c99 && !Optimizer::cparams.prm_c1x && !Optimizer::cparams.prm_cplusplus,
-                             !Optimizer::cparams.prm_ansi,
-                             (MakeStubsOption.GetValue() || MakeStubsUser.GetValue()) && MakeStubsMissingHeaders.GetValue(),
-                             prm_pipe.GetValue() != "+" ? prm_pipe.GetValue() : "");
+        SelectLanguage(buffer);
+        preProcessor = OpenPreProcessor(buffer);
 
         if (!preProcessor->IsOpen())
             exit(1);
@@ -576,6 +650,8 @@ int main(int argc, char* argv[])
                 printf("%s\n", (char*)clist->data);
 
             compile(false);
+            if (Optimizer::cparams.verbosity && Optimizer::cparams.prm_cplusplus)
+                overloadCacheStatistics();
             if (IsCompiler())
             {
                 if (Optimizer::architecture != ARCHITECTURE_MSIL ||
@@ -684,12 +760,19 @@ int main(int argc, char* argv[])
     if (compileToFile)
     {
         // compile to file
-        if (Optimizer::outputFileName.empty())
-            strcpy(realOutFile, firstFile);
+        if (!jobOutput.empty())
+        {
+            strcpy(realOutFile, jobOutput.c_str());
+        }
         else
-            strcpy(realOutFile, Optimizer::outputFileName.c_str());
-        Utils::StripExt(realOutFile);
-        Utils::AddExt(realOutFile, ".icf");
+        {
+            if (Optimizer::outputFileName.empty())
+                strcpy(realOutFile, firstFile);
+            else
+                strcpy(realOutFile, Optimizer::outputFileName.c_str());
+            Utils::StripExt(realOutFile);
+            Utils::AddExt(realOutFile, ".icf");
+        }
         int size = Optimizer::GetOutputSize();
         FILE* fil = fopen(realOutFile, "wb");
         if (!fil)
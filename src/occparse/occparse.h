@@ -51,5 +51,7 @@ int natural_size(EXPRESSION* exp);
 void MakeStubs(void);
 void compile(bool global);
 void enter_filename(const char* name);
+void SelectLanguage(const char* name);
+PreProcessor* OpenPreProcessor(const char* name);
 int main(int argc, char* argv[]);
 }  // namespace Parser
\ No newline at end of file
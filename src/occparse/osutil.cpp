@@ -48,6 +48,8 @@
 #include "configmsil.h"
 #include "initbackend.h"
 #include "optmodules.h"
+#include "compilecache.h"
+#include "Trace.h"
 
 namespace Optimizer
 {
@@ -93,6 +95,13 @@ CmdSwitchBool prm_xcept(switchParser, 'X');
 CmdSwitchBool prm_viaassembly(switchParser, '#');
 CmdSwitchBool displayTiming(switchParser, 't');
 CmdSwitchInt prm_stackalign(switchParser, 's', 16, 0, 2048);
+CmdSwitchInt prm_jobs(switchParser, 'j', 1, 1, 64);
+CmdSwitchString prm_job(switchParser, 0, 0, {"job"});  // internal, used by the processes -j starts
+CmdSwitchString prm_jobSkip(switchParser, 0, 0, {"job-skip"});  // internal, files -j jobs leave out
+CmdSwitchString prm_cache(switchParser, 0, 0, {"cache"});          // set by occ from OCC_CACHE
+CmdSwitchString prm_cacheKeys(switchParser, 0, 0, {"cache-keys"});  // internal, where occ wants the keys
+CmdSwitchBool prm_cacheStats(switchParser, 0, false, {"cache-stats"});
+CmdSwitchString prm_trace(switchParser, 0, 0, {"trace"});
 CmdSwitchString prm_error(switchParser, 'E');
 CmdSwitchString prm_Werror(switchParser, 0, 0, {"Werror"});  // doesn't do anything, just to help the libcxx tests...
 CmdSwitchString prm_define(switchParser, 'D', ';');
@@ -356,6 +365,11 @@ static int DisplayerParams()
         printf("%s", STRING_VERSION);
         rv = 1;
     }
+    if (prm_cacheStats.GetValue())
+    {
+        CacheStatistics();
+        rv = 1;
+    }
     if (prmDumpMachine.GetValue())
     {
         if (!Optimizer::chosenAssembler)
@@ -448,7 +462,7 @@ static void ParamTransfer(char* name)
     {
         prm_Csysinclude.SetValue("");
     }
-    Optimizer::cparams.optimizer_modules = ~0;
+    Optimizer::cparams.optimizer_modules = ~OPT_VECTORIZE;
     if (Optimizer::ParseOptimizerParams(prm_flags.GetValue()) != "")
         Utils::usage(name, getUsageText());
     // booleans
@@ -1153,6 +1167,8 @@ int ccinit(int argc, char* argv[])
     {
         need_usage = true;
     }
+    if (prm_trace.GetExists())
+        Trace::Open(prm_trace.GetValue(), "occparse");
     /* initialize back end */
     if (prm_assemble.GetExists())
     {
@@ -110,6 +110,12 @@ extern CmdSwitchBool prm_xcept;
 extern CmdSwitchBool prm_viaassembly;
 extern CmdSwitchBool displayTiming;
 extern CmdSwitchInt prm_stackaligns;
+extern CmdSwitchInt prm_jobs;
+extern CmdSwitchString prm_job;
+extern CmdSwitchString prm_jobSkip;
+extern CmdSwitchString prm_cache;
+extern CmdSwitchString prm_cacheKeys;
+extern CmdSwitchBool prm_cacheStats;
 extern CmdSwitchString prm_error;
 extern CmdSwitchString prm_define;
 extern CmdSwitchString prm_undefine;
@@ -120,6 +126,8 @@ extern CmdSwitchString prm_verbose;
 extern CmdSwitchString prm_warning;
 extern CmdSwitchCombineString prm_output;
 extern CmdSwitchCombineString prm_tool;
+extern CmdSwitchCombineString prm_flags;
+extern CmdSwitchBool prm_prmSyntaxOnly;
 
 extern CmdSwitchCombineString prm_library;
 extern CmdSwitchCombineString prm_language;
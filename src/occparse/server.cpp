@@ -0,0 +1,227 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#include "server.h"
+#include "FileCache.h"
+#include "SharedMemory.h"
+#include "ppInclude.h"
+#include "Utils.h"
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#    include <poll.h>
+#    include <signal.h>
+#    include <sys/wait.h>
+#    include <cerrno>
+#endif
+
+namespace Parser
+{
+#ifdef HAVE_UNISTD_H
+class ServerWorker
+{
+  public:
+    int pid;
+    int connection;
+    int report;
+    std::string files;
+};
+
+static int reportHandle = -1;
+
+// tell the server which files the worker had to read from disk so it can cache them for next time
+static void WorkerExit()
+{
+    std::string names;
+    for (auto&& name : FileCache::Misses())
+        names += name + "\n";
+    const char* p = names.c_str();
+    size_t n = names.size();
+    while (n)
+    {
+        int l = write(reportHandle, p, n);
+        if (l <= 0)
+            break;
+        p += l;
+        n -= l;
+    }
+    close(reportHandle);
+}
+// the worker writes the parse into the client's shared memory region, which isn't always reachable from
+// here, for example when the server runs with a different TMPDIR.   The client runs the parser itself then
+static bool RegionReachable(const std::vector<std::string>& lines)
+{
+    for (size_t i = 0; i + 1 < lines.size(); i++)
+    {
+        if (lines[i] == "--architecture")
+        {
+            size_t n = lines[i + 1].find(';');
+            if (n == std::string::npos)
+                return true;
+            SharedMemory region(lines[i + 1].substr(n + 1));
+            return region.Open();
+        }
+    }
+    return true;
+}
+static void FinishWorker(ServerWorker& worker)
+{
+    int status;
+    int rv = 255;
+    if (waitpid(worker.pid, &status, 0) == worker.pid && WIFEXITED(status))
+        rv = WEXITSTATUS(status);
+    Utils::PipeWrite(worker.connection, Utils::NumberToString(rv));
+    close(worker.connection);
+    close(worker.report);
+    for (auto&& name : Utils::split(worker.files, '\n'))
+        if (!name.empty())
+            FileCache::Load(name);
+}
+#endif
+
+bool RunServer(const std::string& name, std::vector<std::string>& args)
+{
+#ifdef HAVE_UNISTD_H
+    int server = Utils::NamedPipeServer(name);
+    if (server < 0)
+    {
+        fprintf(stderr, "Cannot create server pipe %s\n", name.c_str());
+        return false;
+    }
+    FileCache::Enable();
+    signal(SIGPIPE, SIG_IGN);
+    std::list<ServerWorker> workers;
+    while (true)
+    {
+        std::vector<struct pollfd> fds;
+        fds.push_back({server, POLLIN, 0});
+        for (auto&& worker : workers)
+            fds.push_back({worker.report, POLLIN, 0});
+        if (poll(&fds[0], fds.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        auto it = workers.begin();
+        for (int i = 1; i < fds.size(); i++)
+        {
+            auto current = it++;
+            if (fds[i].revents)
+            {
+                char buf[4096];
+                int n = read(current->report, buf, sizeof(buf));
+                if (n > 0)
+                {
+                    current->files.append(buf, n);
+                }
+                else
+                {
+                    FinishWorker(*current);
+                    workers.erase(current);
+                }
+            }
+        }
+        if (fds[0].revents & POLLIN)
+        {
+            int connection = Utils::NamedPipeAccept(server);
+            if (connection < 0)
+                continue;
+            // the request is the working directory followed by the arguments, one per line.
+            // after that come the client's stdout and stderr
+            std::string request = Utils::PipeRead(connection);
+            int handles[2];
+            int report[2];
+            if (request.empty() || !Utils::PipeReadHandles(connection, handles, 2))
+            {
+                close(connection);
+                continue;
+            }
+            std::vector<std::string> lines = Utils::split(request, '\n');
+            if (!RegionReachable(lines))
+            {
+                Utils::PipeWrite(connection, "-1");
+                close(connection);
+                close(handles[0]);
+                close(handles[1]);
+                continue;
+            }
+            if (pipe(report) < 0)
+            {
+                Utils::PipeWrite(connection, "255");
+                close(connection);
+                close(handles[0]);
+                close(handles[1]);
+                continue;
+            }
+            fflush(stdout);
+            fflush(stderr);
+            int pid = fork();
+            if (pid == 0)
+            {
+                close(server);
+                close(connection);
+                close(report[0]);
+                for (auto&& worker : workers)
+                {
+                    close(worker.connection);
+                    close(worker.report);
+                }
+                dup2(handles[0], 1);
+                dup2(handles[1], 2);
+                close(handles[0]);
+                close(handles[1]);
+                reportHandle = report[1];
+                FileCache::ClearMisses();
+                ppInclude::ClearFileCache();
+                atexit(WorkerExit);
+                if (lines.size() < 2)
+                    Utils::fatal("Invalid compile server request");
+                if (chdir(lines[0].c_str()) != 0)
+                    Utils::fatal("Cannot change to directory %s", lines[0].c_str());
+                args.assign(lines.begin() + 1, lines.end());
+                return true;
+            }
+            close(handles[0]);
+            close(handles[1]);
+            close(report[1]);
+            if (pid < 0)
+            {
+                Utils::PipeWrite(connection, "255");
+                close(connection);
+                close(report[0]);
+                continue;
+            }
+            workers.push_back({pid, connection, report[0]});
+        }
+    }
+#else
+    fprintf(stderr, "The compile server is not supported on this platform\n");
+    return false;
+#endif
+}
+}  // namespace Parser
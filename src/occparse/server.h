@@ -0,0 +1,36 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Parser
+{
+// runs occparse as a long-lived server on a named pipe.   Each request is compiled in a worker
+// process forked from the server so the file cache it has built up is already warm.   Returns
+// true in the worker with the arguments for the compile, or false if the server couldn't run.
+bool RunServer(const std::string& name, std::vector<std::string>& args);
+}  // namespace Parser
@@ -4088,7 +4088,11 @@ LEXLIST* body(LEXLIST* lex, SYMBOL* funcsp)
             }
         }
         if (IsCompiler() && funcNesting == 1)  // top level function
+        {
+            overloadCacheFlush();
+            ThisPointerTypesFlush();
             localFree();
+        }
         handleInlines(funcsp);
     }
     constexprfunctioninit(false);
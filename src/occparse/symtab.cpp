@@ -670,7 +670,7 @@ void insert(SYMBOL* in, HASHTABLE* table)
     {
         if (!IsCompiler())
         {
-            if (table != kwhash && table != CompletionCompiler::ccHash)
+            if (table != CompletionCompiler::ccHash)
                 if (!in->parserSet)
                 {
                     in->parserSet = true;
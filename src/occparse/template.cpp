@@ -53,6 +53,8 @@
 #include "template.h"
 #include "libcxx.h"
 #include "constexpr.h"
+#include "unmangle.h"
+#include "Trace.h"
 
 namespace Parser
 {
@@ -239,6 +241,8 @@ bool templatecomparetypes(TYPE* tp1, TYPE* tp2, bool exact, bool sameType)
 {
     if (!tp1 || !tp2)
         return false;
+    if (tp1 == tp2)
+        return true;
     if (basetype(tp1)->type == bt_templateselector && basetype(tp2)->type == bt_templateselector)
     {
         TEMPLATESELECTOR* left = basetype(tp1)->sp->sb->templateSelector;
@@ -3522,7 +3526,7 @@ TYPE* LookupTypeFromExpression(EXPRESSION* exp, TEMPLATEPARAMLIST* enclosing, bo
                     FUNCTIONCALL* func = Allocate<FUNCTIONCALL>();
                     *func = *next->v.func;
                     func->sp = sym;
-                    func->thistp = MakeType(bt_pointer, tp);
+                    func->thistp = MakeThisPointerType(tp);
                     func->thisptr = intNode(en_c_i, 0);
                     func->arguments = ExpandArguments(next);
                     auto oldnoExcept = noExcept;
@@ -7895,6 +7899,19 @@ void SwapMainTemplateArgs(SYMBOL* cls)
         }
     }
 }
+// the unmangled name is only worked out when there is a trace to put it in
+static void TraceInstantiation(TraceSpan& span, const char* kind, SYMBOL* sym)
+{
+    if (Trace::Enabled())
+    {
+        char buf[10000];
+        if (sym->sb->decoratedName)
+            unmangle(buf, sym->sb->decoratedName);
+        else
+            strcpy(buf, sym->name);
+        span.Start("template", kind, buf);
+    }
+}
 SYMBOL* TemplateClassInstantiateInternal(SYMBOL* sym, TEMPLATEPARAMLIST* args, bool isExtern)
 {
     (void)args;
@@ -7931,6 +7948,8 @@ SYMBOL* TemplateClassInstantiateInternal(SYMBOL* sym, TEMPLATEPARAMLIST* args, b
             lex = sym->sb->parentTemplate->sb->deferredCompile;
         if (lex)
         {
+            TraceSpan span;
+            TraceInstantiation(span, "instantiate class", sym);
             EnterInstantiation(lex, sym);
             int oldHeaderCount = templateHeaderCount;
             Optimizer::LIST* oldDeferred = deferred;
@@ -8197,6 +8216,8 @@ SYMBOL* TemplateFunctionInstantiate(SYMBOL* sym, bool warning, bool isExtern)
         lex = sym->sb->deferredCompile;
         if (lex)
         {
+            TraceSpan span;
+            TraceInstantiation(span, "instantiate function", sym);
             EnterInstantiation(lex, sym);
             Optimizer::LINEDATA* oldLinesHead = linesHead;
             Optimizer::LINEDATA* oldLinesTail = linesTail;
@@ -11955,7 +11976,7 @@ void DoInstantiateTemplateFunction(TYPE* tp, SYMBOL** sp, NAMESPACEVALUELIST* ns
             }
             if (spi->sb->parentClass)
             {
-                funcparams->thistp = MakeType(bt_pointer, spi->sb->parentClass->tp);
+                funcparams->thistp = MakeThisPointerType(spi->sb->parentClass->tp);
                 funcparams->thisptr = intNode(en_c_i, 0);
             }
             instance = GetOverloadedTemplate(spi, funcparams);
@@ -69,6 +69,8 @@ static TYPE* replaceTemplateSelector(TYPE* tp)
 }
 bool comparetypes(TYPE* typ1, TYPE* typ2, int exact)
 {
+    if (typ1 == typ2)
+        return true;
     if (typ1->type == bt_any || typ2->type == bt_any)
         return true;
     while (typ1->type == bt_typedef)
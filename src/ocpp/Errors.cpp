@@ -36,9 +36,15 @@ ppInclude* Errors::include;
 bool Errors::showWarnings = true;
 bool Errors::showTrivialWarnings;
 bool Errors::warningsAsErrors;
+bool Errors::quiet;
 
 void Errors::ErrorWithLine(const std::string& msg, const std::string& filname, int lineno)
 {
+    if (quiet)
+    {
+        errorCount++;
+        return;
+    }
     std::cout << "Error ";
     std::cout << filname << "(" << lineno << "): ";
     std::cout << msg << std::endl;
@@ -49,6 +55,11 @@ void Errors::ErrorWithLine(const std::string& msg, const std::string& filname, i
 }
 void Errors::Error(const std::string& msg)
 {
+    if (quiet)
+    {
+        errorCount++;
+        return;
+    }
     std::cout << "Error ";
     FileName();
     std::cout << msg << std::endl;
@@ -59,7 +70,7 @@ void Errors::Error(const std::string& msg)
 }
 void Errors::WarningWithLine(const std::string& msg, const std::string& filname, int lineno)
 {
-    if (showWarnings)
+    if (!quiet && showWarnings)
     {
         if (warningsAsErrors)
         {
@@ -77,7 +88,7 @@ void Errors::WarningWithLine(const std::string& msg, const std::string& filname,
 }
 void Errors::Warning(const std::string& msg)
 {
-    if (showWarnings)
+    if (!quiet && showWarnings)
     {
         if (warningsAsErrors)
         {
@@ -95,7 +106,7 @@ void Errors::Warning(const std::string& msg)
 }
 void Errors::TrivialWarningWithLine(const std::string& msg, const std::string& filname, int lineno)
 {
-    if (showTrivialWarnings)
+    if (!quiet && showTrivialWarnings)
     {
         if (warningsAsErrors)
         {
@@ -113,7 +124,7 @@ void Errors::TrivialWarningWithLine(const std::string& msg, const std::string& f
 }
 void Errors::TrivialWarning(const std::string& msg)
 {
-    if (showTrivialWarnings)
+    if (!quiet && showTrivialWarnings)
     {
         if (warningsAsErrors)
         {
@@ -131,6 +142,8 @@ void Errors::TrivialWarning(const std::string& msg)
 }
 void Errors::Previous(const std::string& name, int lineNo, const std::string& file)
 {
+    if (quiet)
+        return;
     std::cout << "Warning " << file << "(" << lineNo << "): Previous definition here" << std::endl;
 }
 bool Errors::ErrorCount()
@@ -54,6 +54,8 @@ class Errors
             showTrivialWarnings = flag;
     }
     static void WarningsAsErrors(bool flag) { warningsAsErrors = flag; }
+    // count errors without showing anything, e.g. while looking at a file a second time
+    static void SetQuiet(bool flag) { quiet = flag; }
     static bool ErrorCount();
     static void SetMaxErrors(int count) { maxErrors = count; }
     static void SetInclude(ppInclude* inc) { include = inc; }
@@ -76,5 +78,6 @@ class Errors
     static bool showWarnings;
     static bool showTrivialWarnings;
     static bool warningsAsErrors;
+    static bool quiet;
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,126 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#include "FileCache.h"
+#include <sys/stat.h>
+#include <cstdio>
+#include <ctime>
+
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#else
+#    include <direct.h>
+#endif
+
+bool FileCache::enabled;
+bool FileCache::fill;
+std::unordered_map<std::string, FileCache::Entry> FileCache::files;
+std::set<std::string> FileCache::misses;
+
+std::string FileCache::Key(const std::string& name)
+{
+    // the server's workers run in different directories so relative names can't be used as keys
+    if (name.empty() || name[0] == '/' || name[0] == '\\' || (name.size() > 1 && name[1] == ':'))
+        return name;
+    char buf[4096];
+    if (!getcwd(buf, sizeof(buf)))
+        return name;
+    return std::string(buf) + "/" + name;
+}
+bool FileCache::Stat(const std::string& name, Stamp& stamp)
+{
+    struct stat st;
+    if (stat(name.c_str(), &st) != 0 || (st.st_mode & S_IFMT) != S_IFREG)
+        return false;
+    stamp.size = st.st_size;
+#if defined(__APPLE__)
+    stamp.time = st.st_mtimespec.tv_sec * 1000000000LL + st.st_mtimespec.tv_nsec;
+    stamp.changed = st.st_ctimespec.tv_sec * 1000000000LL + st.st_ctimespec.tv_nsec;
+#elif defined(HAVE_UNISTD_H)
+    stamp.time = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+    stamp.changed = st.st_ctim.tv_sec * 1000000000LL + st.st_ctim.tv_nsec;
+#else
+    stamp.time = st.st_mtime * 1000000000LL;
+    stamp.changed = st.st_ctime * 1000000000LL;
+#endif
+    stamp.inode = st.st_ino;
+    return true;
+}
+bool FileCache::Read(const std::string& name, long long size, std::string& contents)
+{
+    FILE* fil = fopen(name.c_str(), "rb");
+    if (!fil)
+        return false;
+    contents.resize(size);
+    size_t n = size ? fread(&contents[0], 1, size, fil) : 0;
+    fclose(fil);
+    return n == size;
+}
+// true if the file changed so recently that it could change again without its time stamps moving
+bool FileCache::Recent(const Stamp& stamp)
+{
+    long long newest = stamp.time > stamp.changed ? stamp.time : stamp.changed;
+    return time(nullptr) <= newest / 1000000000LL + 1;
+}
+const std::string* FileCache::Get(const std::string& name)
+{
+    if (!enabled)
+        return nullptr;
+    std::string key = Key(name);
+    Stamp stamp;
+    if (!Stat(key, stamp))
+        return nullptr;
+    auto it = files.find(key);
+    if (it != files.end() && it->second.stamp == stamp)
+    {
+        if (!it->second.verify)
+            return &it->second.contents;
+        std::string contents;
+        if (Read(key, stamp.size, contents) && contents == it->second.contents)
+        {
+            it->second.verify = Recent(stamp);
+            return &it->second.contents;
+        }
+    }
+    if (!fill)
+    {
+        misses.insert(key);
+        return nullptr;
+    }
+    Load(key);
+    it = files.find(key);
+    return it != files.end() ? &it->second.contents : nullptr;
+}
+void FileCache::Load(const std::string& name)
+{
+    std::string key = Key(name);
+    Entry entry;
+    if (!Stat(key, entry.stamp) || !Read(key, entry.stamp.size, entry.contents))
+    {
+        files.erase(key);
+        return;
+    }
+    entry.verify = Recent(entry.stamp);
+    files[key] = std::move(entry);
+}
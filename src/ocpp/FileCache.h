@@ -0,0 +1,85 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#ifndef FileCache_h
+#define FileCache_h
+
+#include <string>
+#include <set>
+#include <unordered_map>
+
+// keeps the contents of source files in memory for long-lived processes such as the
+// compile server, or for a batch compile of several files in one process.   Entries are checked
+// against the file's size, identity and time stamps each time they are used so that a stale copy
+// is never handed out.   A file can change again within the resolution of its time stamps, so
+// one that was loaded right after it changed is compared by contents until that can't happen.
+class FileCache
+{
+  public:
+    // with 'fill' set a file that isn't cached is loaded when it is first asked for, otherwise
+    // it is only noted as a miss and the owner of the cache decides what to load
+    static void Enable(bool fill = false)
+    {
+        enabled = true;
+        FileCache::fill = fill;
+    }
+    static bool Enabled() { return enabled; }
+    // returns null if the file isn't in the cache or has changed since it was loaded
+    static const std::string* Get(const std::string& name);
+    static void Load(const std::string& name);
+    // names of files that were looked for but had to be read from disk
+    static const std::set<std::string>& Misses() { return misses; }
+    static void ClearMisses() { misses.clear(); }
+
+  private:
+    class Stamp
+    {
+      public:
+        bool operator==(const Stamp& right) const
+        {
+            return size == right.size && time == right.time && changed == right.changed && inode == right.inode;
+        }
+        long long size;
+        long long time;     // nanoseconds
+        long long changed;  // nanoseconds
+        unsigned long long inode;
+    };
+    class Entry
+    {
+      public:
+        Stamp stamp;
+        bool verify;
+        std::string contents;
+    };
+    static std::string Key(const std::string& name);
+    static bool Stat(const std::string& name, Stamp& stamp);
+    static bool Read(const std::string& name, long long size, std::string& contents);
+    static bool Recent(const Stamp& stamp);
+
+    static bool enabled;
+    static bool fill;
+    static std::unordered_map<std::string, Entry> files;
+    static std::set<std::string> misses;
+};
+#endif
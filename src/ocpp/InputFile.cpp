@@ -25,7 +25,9 @@
 #include "InputFile.h"
 #include "Errors.h"
 #include "PipeArbitrator.h"
+#include "FileCache.h"
 #include "UTF8.h"
+#include <climits>
 
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
@@ -39,7 +41,7 @@ std::set<std::string> InputFile::fileNameCache;
 
 InputFile::~InputFile()
 {
-    if (streamid >= 3)
+    if (streamid >= 3 && !cached)
         close(streamid);
     CheckErrors();
 }
@@ -53,6 +55,10 @@ bool InputFile::Open()
     {
         streamid = 0;
     }
+    else if ((cached = FileCache::Get(*name)))
+    {
+        streamid = INT_MAX;  // not a real handle, data comes from the cache
+    }
     else
         streamid = open(name->c_str(), 0);  // readonly
     if (streamid >= 0)
@@ -165,7 +171,7 @@ bool InputFile::ReadString(char* s, int len)
                 }
             }
         }
-        inputLen = read(streamid, inputBuffer, sizeof(inputBuffer));
+        inputLen = Read(inputBuffer, sizeof(inputBuffer));
         bufPtr = inputBuffer;
         if (inputLen <= 0)
         {
@@ -175,6 +181,18 @@ bool InputFile::ReadString(char* s, int len)
         }
     }
 }
+int InputFile::Read(char* buf, int len)
+{
+    if (cached)
+    {
+        if (len > cached->size() - cachedPos)
+            len = cached->size() - cachedPos;
+        memcpy(buf, cached->c_str() + cachedPos, len);
+        cachedPos += len;
+        return len;
+    }
+    return read(streamid, buf, len);
+}
 bool InputFile::ReadLine(char* line)
 {
     line[0] = 0;
@@ -198,7 +216,7 @@ void InputFile::CheckUTF8BOM()
     static unsigned char BOM2[] = {0xff, 0xfe};  // only LE version at this time...
     unsigned char buf[4];
     int l;
-    if (4 == (l = read(streamid, buf, 4)))
+    if (4 == (l = Read((char*)buf, 4)))
     {
         utf8BOM = !memcmp(BOM, buf, 3);
         if (utf8BOM)
@@ -55,6 +55,8 @@ class InputFile
         fileIndex(0),
         inputLen(0),
         bufPtr(inputBuffer),
+        cached(nullptr),
+        cachedPos(0),
         piper(Piper)
     {
     }
@@ -83,6 +85,7 @@ class InputFile
     bool ReadLine(char* line);
     void CheckUTF8BOM();
     bool ReadString(char* line, int width);
+    int Read(char* buf, int len);
     const std::string* cache(const std::string& name)
     {
         auto it = fileNameCache.find(name);
@@ -108,6 +111,8 @@ class InputFile
     int inputLen;
     char inputBuffer[32000];
     char* bufPtr;
+    const std::string* cached;
+    size_t cachedPos;
     int streamid;
     const std::string* name;
     const std::string* decoratedName;
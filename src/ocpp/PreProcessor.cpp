@@ -87,6 +87,32 @@ void PreProcessor::InitHash()
         hash["pop"] = kw::POP;
         hash["repl"] = kw::REPL;
     }
+    // the keys in 'hash' don't move once it is filled in, so the directive table can use them in place
+    directives.Clear();
+    for (auto&& h : hash)
+        directives.Add(h.first.c_str(), h.second);
+    directives.Build();
+}
+// recognizes the directive name starting at 'pos' directly from the line, without tokenizing it
+bool PreProcessor::FindDirective(const std::string& line, size_t pos, kw& token, std::string& rest)
+{
+    pos = line.find_first_not_of("\t \v", pos);
+    if (pos == std::string::npos || !Tokenizer::IsSymbolChar(line.c_str() + pos, true))
+        return false;
+    PerfectHash<kw>::Hasher hasher;
+    size_t end = pos;
+    while (end < line.size() && Tokenizer::IsSymbolChar(line.c_str() + end, false))
+    {
+        int n = UTF8::CharSpan(line.c_str() + end);
+        for (int i = 0; i < n && end < line.size(); i++)
+            hasher.Add(line[end++]);
+    }
+    const kw* found = directives.Lookup(line.c_str() + pos, end - pos, hasher.Value());
+    if (!found)
+        return false;
+    token = *found;
+    rest = line.substr(end);
+    return true;
 }
 bool PreProcessor::GetPreLine(std::string& line)
 {
@@ -191,11 +217,23 @@ bool PreProcessor::GetLine(std::string& line)
                     {
                         if (trigraphs)
                             line = StripDigraphs(line);
-                        Tokenizer tk(line.substr(n + 1), &hash);
-                        const Token* t = tk.Next();
-                        if (t->IsKeyword())
+                        kw token = kw::UNKNOWN;
+                        std::string rest;
+                        bool keyword = FindDirective(line, n + 1, token, rest);
+                        if (!keyword)
+                        {
+                            Tokenizer tk(line.substr(n + 1), &hash);
+                            const Token* t = tk.Next();
+                            keyword = t->IsKeyword();
+                            if (keyword)
+                            {
+                                token = t->GetKeyword();
+                                rest = tk.GetString();
+                            }
+                        }
+                        if (keyword)
                         {
-                            if (t->GetKeyword() == kw::ASSIGN || t->GetKeyword() == kw::IASSIGN)
+                            if (token == kw::ASSIGN || token == kw::IASSIGN)
                             {
                                 if (include.Skipping())
                                     line.erase(0, line.size());
@@ -222,8 +260,7 @@ bool PreProcessor::GetLine(std::string& line)
                             }
                             else
                             {
-                                line = tk.GetString();
-                                kw token = t->GetKeyword();
+                                line = rest;
                                 // must come first
                                 if (!include.Check(token, line))
                                 {
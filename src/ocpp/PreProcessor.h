@@ -33,6 +33,7 @@
 #include "ppMacro.h"
 #include "ppCtx.h"
 #include "ppExpr.h"
+#include "PerfectHash.h"
 
 class PreProcessor
 {
@@ -103,6 +104,8 @@ class PreProcessor
     bool IsOpen() const { return include.IsOpen(); }
 
   private:
+    bool FindDirective(const std::string& line, size_t pos, kw& token, std::string& rest);
+
     bool trigraphs;
     char ppStart;
     ppCtx ctx;
@@ -112,6 +115,7 @@ class PreProcessor
     ppError ppErr;
     ppPragma pragma;
     KeywordHash hash;
+    PerfectHash<kw> directives;
     int lineno;
     std::string preData;
     std::string origLine;
@@ -25,6 +25,7 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 #include "ppDefine.h"
+#include "ppExpand.h"
 #include "Token.h"
 #include "PreProcessor.h"
 #include "ppkw.h"
@@ -52,6 +53,7 @@ ppDefine::Definition& ppDefine::Definition::operator=(const ppDefine::Definition
     varargs = old.varargs;
     preprocessing = old.preprocessing;
     value = old.value;
+    tokens = old.tokens;
     if (old.argList)
     {
         argList = std::make_unique<DefinitionArgList>();
@@ -69,6 +71,7 @@ ppDefine::Definition::Definition(const Definition& old) : Symbol(old.GetName())
     varargs = old.varargs;
     preprocessing = old.preprocessing;
     value = old.value;
+    tokens = old.tokens;
     if (old.argList)
     {
         argList = std::make_unique<DefinitionArgList>();
@@ -85,7 +88,9 @@ ppDefine::ppDefine(bool UseExtensions, ppInclude* Include, bool C89, bool Asmpp)
         source_date_epoch = (time_t)strtoul(sde, nullptr, 10);
     SetDefaults();
     expr.SetDefine(this);
+    expand = std::make_unique<ppExpand>(this, C89);
 }
+ppDefine::~ppDefine() {}
 bool ppDefine::Check(kw token, std::string& line)
 {
     bool rv = true;
@@ -157,6 +162,7 @@ ppDefine::Definition* ppDefine::Define(const std::string& name, std::string& val
     }
     x += value.substr(last, pos - last);
     value = x;
+    std::string spelling = value;
     static char tk[2] = {REPLACED_TOKENIZING, 0};
 
     n = value.find("##");
@@ -185,6 +191,8 @@ ppDefine::Definition* ppDefine::Define(const std::string& name, std::string& val
     d->SetLocation(include->GetRealFile(), include->GetRealLineNo());
     if (varargs)
         d->SetHasVarArgs();
+    if (!asmpp)
+        expand->ParseDefinition(d, spelling);
     if (errors && old)
     {
         bool failed = false;
@@ -402,6 +410,13 @@ void ppDefine::SetDefaults()
 int ppDefine::LookupDefault(std::string& macro, int begin, int end, const std::string& name)
 {
     std::string insert;
+    if (!Builtin(name, insert))
+        return 0;
+    macro.replace(begin, end - begin, insert);
+    return insert.size();
+}
+bool ppDefine::Builtin(const std::string& name, std::string& insert)
+{
     if (name == "__FILE__")
     {
         std::string errfile = include->GetErrFile();
@@ -428,9 +443,8 @@ int ppDefine::LookupDefault(std::string& macro, int begin, int end, const std::s
         insert = Utils::NumberToString(counter_val++);
     }
     else
-        return 0;
-    macro.replace(begin, end - begin, insert);
-    return insert.size();
+        return false;
+    return true;
 }
 std::string ppDefine::defid(const std::string& macroname, int& i, int& j)
 /*
@@ -692,8 +706,7 @@ bool ppDefine::ReplaceArgs(std::string& macro, const DefinitionArgList& oldargs,
                 {
                     int sv;
                     std::string temp(varargs);
-                    ReplaceSegment(temp, 0, temp.size(), sv, p == macro.size(),
-                                                definitions, nullptr);
+                    ReplaceSegment(temp, 0, temp.size(), sv, p == macro.size(), definitions);
                     int rv;
                     if ((rv = InsertReplacementString(macro, p, q, temp, temp)) < -MACRO_REPLACE_SIZE)
                         return (false);
@@ -751,8 +764,7 @@ void ppDefine::SetupAlreadyReplaced(std::string& macro)
         }
     }
 }
-int ppDefine::ReplaceSegment(std::string& line, int begin, int end, int& pptr, bool eol, std::deque<Definition*>& definitions,
-                             std::deque<TokenPos>* positions)
+int ppDefine::ReplaceSegment(std::string& line, int begin, int end, int& pptr, bool eol, std::deque<Definition*>& definitions)
 {
     std::string name;
     int waiting = 0;
@@ -761,33 +773,23 @@ int ppDefine::ReplaceSegment(std::string& line, int begin, int end, int& pptr, b
     int rv;
     int p;
     int insize, rv1;
-    int origPos = begin;
     for (p = begin; p < end;)
     {
         int q = p;
         if (!waiting && (line[p] == '"' || line[p] == '\'') && NotSlashed(line, p))
         {
             waiting = line[p++];
-            origPos++;
         }
         else if (waiting)
         {
             if (line[p] == waiting && NotSlashed(line, p))
                 waiting = 0;
             p++;
-            origPos++;
         }
         else if (Tokenizer::IsSymbolChar(line.c_str() + p, true) &&
                  (p == begin || line[p - 1] == '$' || !Tokenizer::IsSymbolChar(line.c_str() + p - 1, false)))
         {
-            TokenPos tokenPos;
-            tokenPos.origStart = origPos;
-            tokenPos.newStart = q;
-            int origStart = origPos;
             name = defid(line, q, p);
-            origPos += p - q;
-            tokenPos.origEnd = origPos;
-            tokenPos.newEnd = q;
             Symbol* sym = symtab.Lookup(name);
             Definition* d = static_cast<Definition*>(sym);
             bool tokenized = false;
@@ -873,7 +875,7 @@ int ppDefine::ReplaceSegment(std::string& line, int begin, int end, int& pptr, b
                             int sv;
                             std::deque<Definition*> argDefinitions;
                             rv = ReplaceSegment(expandedargs[count], 0, expandedargs[count].size(), sv, p == line.size(),
-                                                argDefinitions, nullptr);
+                                                argDefinitions);
                             if (rv < -MACRO_REPLACE_SIZE)
                             {
                                 return rv;
@@ -972,8 +974,7 @@ int ppDefine::ReplaceSegment(std::string& line, int begin, int end, int& pptr, b
                 end += insize;
                 p += insize;
                 insize = 0;
-                tokenPos.newEnd += rv1;
-                rv = ReplaceSegment(line, q, p, p, false, definitions, nullptr);
+                rv = ReplaceSegment(line, q, p, p, false, definitions);
                 if (!tokenized)
                 {
                     if (definitions.size())
@@ -984,11 +985,8 @@ int ppDefine::ReplaceSegment(std::string& line, int begin, int end, int& pptr, b
                 {
                     return rv;
                 }
-                tokenPos.newEnd += rv;
                 end += rv;
                 insize = 0;
-                if (positions)
-                    positions->push_back(tokenPos);
             }
             else
             {
@@ -999,16 +997,12 @@ int ppDefine::ReplaceSegment(std::string& line, int begin, int end, int& pptr, b
                     end += insize;
                     p += insize;
                     insize = 0;
-                    tokenPos.newEnd += n;
-                    if (positions)
-                        positions->push_back(tokenPos);
                 }
             }
         }
         else
         {
             p++;
-            origPos++;
         }
     }
     pptr = p;
@@ -1212,76 +1206,25 @@ void ppDefine::replaceDefined(std::string& line)
 
 int ppDefine::Process(std::string& line, bool leavePlaceholder)
 {
-    if (asmpp)
+    tokenPositions.clear();
+    if (!asmpp)
     {
-        leavePlaceholder = false;
-        ParseAsmSubstitutions(line);
+        // only source lines gathered by the preprocessor itself can be continued on the next line
+        return expand->Process(line, leavePlaceholder, leavePlaceholder, tokenPositions);
     }
+    ParseAsmSubstitutions(line);
     int sv = 0;
     std::deque<Definition*> definitions;
-    tokenPositions.clear();
-    int rvi = ReplaceSegment(line, 0, line.size(), sv, true, definitions, asmpp ? nullptr : &tokenPositions);
+    int rvi = ReplaceSegment(line, 0, line.size(), sv, true, definitions);
     if (rvi == INT_MIN + 1)
         return rvi;
     std::string rv;
-    int p, last = 0;
-    int offset = 0;
-    TokenPos *current = nullptr, *next = nullptr;
-    auto it = tokenPositions.begin();
-    if (it != tokenPositions.end())
-    {
-        current = &(*it);
-        ++it;
-        if (it != tokenPositions.end())
-        {
-            next = &(*it);
-        }
-    }
-    for (p = 0; p < line.size(); p++)
-    {
-        if (next && p >= next->newStart)
-        {
-            next->newStart -= offset;
-            next->newEnd -= offset;
-            current = next;
-            ++it;
-            if (it == tokenPositions.end())
-            {
-                next = nullptr;
-            }
-            else
-            {
-                next = &(*it);
-            }
-        }
-        if (line[p] == REPLACED_TOKENIZING || (!leavePlaceholder && line[p] == MACRO_PLACEHOLDER) || line[p] == REPLACED_ALREADY)
-        {
-            int pos = p;
-            if (p != last)
-                rv += line.substr(last, p - last);
-            while ((!current || p <= current->newEnd) &&
-                   (line[p] == REPLACED_TOKENIZING || (!leavePlaceholder && line[p] == MACRO_PLACEHOLDER) ||
-                    line[p] == REPLACED_ALREADY))
-                p++;
-            last = p--;
-            if (current)
-                current->newEnd -= p - pos;
-            offset += p - pos;
-        }
-    }
-    if (last != p)
-        rv += line.substr(last, p - last);
-    while (it != tokenPositions.end())
-    {
-        it->newStart -= offset;
-        it->newEnd -= offset;
-        it = ++it;
-    }
+    rv.reserve(line.size());
+    for (auto c : line)
+        if (c != REPLACED_TOKENIZING && c != MACRO_PLACEHOLDER && c != REPLACED_ALREADY)
+            rv += c;
     line = rv;
-    if (asmpp)
-    {
-        ReplaceAsmMacros(line);
-    }
+    ReplaceAsmMacros(line);
     return rvi;
 }
 void ppDefine::PushPopMacro(std::string name, bool push)
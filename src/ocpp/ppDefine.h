@@ -42,6 +42,7 @@ typedef std::vector<std::string> DefinitionArgList;
 
 class ppInclude;
 class ppMacro;
+class ppExpand;
 
 class ppDefine
 {
@@ -54,6 +55,50 @@ class ppDefine
         short newStart;
         short newEnd;
     };
+    // a preprocessing token as seen by the macro expander.   Definition bodies are
+    // broken up into these once when the macro is defined
+    class MacroToken
+    {
+      public:
+        enum Type : char
+        {
+            IDENTIFIER,
+            NUMBER,
+            STRING,
+            PUNCT,
+            OTHER,
+            PARAM,      /* reference to a macro argument in a definition body */
+            STRINGIZE,  /* # applied to a macro argument in a definition body */
+            PASTE,      /* ## in a definition body */
+            PLACEMARKER /* an empty argument on either side of a ## */
+        };
+        MacroToken() :
+            type(OTHER), spaceBefore(false), avoidPaste(false), noExpand(false), arg(-1), hideSet(0), origStart(-1), origEnd(-1)
+        {
+        }
+        MacroToken(Type TokenType, const std::string& Text, bool SpaceBefore) :
+            text(Text),
+            type(TokenType),
+            spaceBefore(SpaceBefore),
+            avoidPaste(false),
+            noExpand(false),
+            arg(-1),
+            hideSet(0),
+            origStart(-1),
+            origEnd(-1)
+        {
+        }
+        std::string text;
+        Type type;
+        bool spaceBefore;
+        bool avoidPaste;
+        bool noExpand;
+        short arg;
+        int hideSet;
+        int origStart;
+        int origEnd;
+    };
+    typedef std::vector<MacroToken> MacroTokenList;
     class Definition : public Symbol
     {
       public:
@@ -92,6 +137,8 @@ class ppDefine
         }
         DefinitionArgList* GetArgList() const { return argList.get(); }
         std::string& GetValue() { return value; }
+        MacroTokenList& GetTokens() { return tokens; }
+        void SetTokens(MacroTokenList& list) { tokens = std::move(list); }
         bool IsCaseInsensitive() { return caseInsensitive; }
         void SetCaseInsensitive(bool flag) { caseInsensitive = flag; }
 
@@ -103,12 +150,13 @@ class ppDefine
         bool varargs;
         bool preprocessing;
         std::string value;
+        MacroTokenList tokens;
         std::unique_ptr<DefinitionArgList> argList;
     };
 
   public:
     ppDefine(bool UseExtensions, ppInclude* Include, bool C89, bool Asmpp);
-    ~ppDefine() {}
+    ~ppDefine();
 
     void SetParams(ppCtx* Ctx, ppMacro* Macro)
     {
@@ -146,6 +194,7 @@ class ppDefine
     void DoUndefine(std::string& line);
     void SetDefaults();
     int LookupDefault(std::string& macro, int begin, int end, const std::string& name);
+    bool Builtin(const std::string& name, std::string& value);
     void Stringize(std::string& macro);
     bool Tokenize(std::string& macro);
     int InsertReplacementString(std::string& macro, int end, int begin, std::string text, std::string etext);
@@ -154,8 +203,7 @@ class ppDefine
     bool ReplaceArgs(std::string& macro, const DefinitionArgList& oldargs, const DefinitionArgList& newArgs,
                      const DefinitionArgList& expandedargs, std::deque<Definition*>& definitions, const std::string varargs);
     void SetupAlreadyReplaced(std::string& macro);
-    int ReplaceSegment(std::string& line, int begin, int end, int& pptr, bool eol, std::deque<Definition*>& definitions,
-                       std::deque<TokenPos>* positions);
+    int ReplaceSegment(std::string& line, int begin, int end, int& pptr, bool eol, std::deque<Definition*>& definitions);
     void SyntaxError(const std::string& name);
     void ParseAsmSubstitutions(std::string& line);
     void ReplaceAsmMacros(std::string& line);
@@ -170,6 +218,7 @@ class ppDefine
     std::string time;
     std::unordered_map<std::string, std::stack<Definition*>> macroStacks;
     std::deque<TokenPos> tokenPositions;
+    std::unique_ptr<ppExpand> expand;
     static KeywordHash defTokens;
     bool c89;
     ppExpr expr;
@@ -0,0 +1,790 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#include "ppExpand.h"
+#include "Token.h"
+#include "UTF8.h"
+#include <algorithm>
+#include <climits>
+#include <cctype>
+#include <cstring>
+
+static const char* punctuators[] = {"%:%:", "...", "<<=", ">>=", "->*", "<=>", "##", "%:", "->", "++", "--", "<<",
+                                    ">>",   "<=",  ">=",  "==",  "!=",  "&&",  "||", "*=", "/=", "%=", "+=", "-=",
+                                    "&=",   "^=",  "|=",  "::",  ".*",  "<:",  ":>", "<%", "%>"};
+
+static int LexQuoted(const std::string& line, int p)
+{
+    int quote = line[p++];
+    while (p < line.size() && line[p] != quote)
+    {
+        if (line[p] == '\\' && p + 1 < line.size())
+            p++;
+        p++;
+    }
+    if (p < line.size())
+        p++;
+    return p;
+}
+static int LexRaw(const std::string& line, int p)
+{
+    // p is at the opening quote
+    int n = line.find('(', p);
+    if (n == std::string::npos)
+        return LexQuoted(line, p);
+    std::string terminator = ")" + line.substr(p + 1, n - p - 1) + "\"";
+    n = line.find(terminator, n + 1);
+    if (n == std::string::npos)
+        return line.size();
+    return n + terminator.size();
+}
+void ppExpand::Lex(const std::string& line, MacroTokenList& tokens, bool positions)
+{
+    bool space = false;
+    const char* str = line.c_str();
+    int size = line.size();
+    for (int p = 0; p < size;)
+    {
+        unsigned char ch = str[p];
+        if (isspace(ch) || (ch && ch <= ppDefine::MACRO_PLACEHOLDER))
+        {
+            space = true;
+            p++;
+            continue;
+        }
+        int start = p;
+        MacroToken::Type type;
+        if (Tokenizer::IsSymbolChar(str + p, true))
+        {
+            type = MacroToken::IDENTIFIER;
+            while (p < size && Tokenizer::IsSymbolChar(str + p, false))
+                p += UTF8::CharSpan(str + p);
+            if (p < size && (str[p] == '"' || str[p] == '\''))
+            {
+                int len = p - start;
+                if (str[p] == '"' && str[p - 1] == 'R' &&
+                    (len == 1 || (len == 2 && strchr("LuU", str[start])) || (len == 3 && !strncmp(str + start, "u8", 2))))
+                {
+                    p = LexRaw(line, p);
+                    type = MacroToken::STRING;
+                }
+                else if ((len == 1 && strchr("LuU", str[start])) || (len == 2 && !strncmp(str + start, "u8", 2)))
+                {
+                    p = LexQuoted(line, p);
+                    type = MacroToken::STRING;
+                }
+            }
+        }
+        else if (isdigit(ch) || (ch == '.' && isdigit((unsigned char)str[p + 1])))
+        {
+            type = MacroToken::NUMBER;
+            p++;
+            while (p < size)
+            {
+                if ((str[p] == '+' || str[p] == '-') && strchr("eEpP", str[p - 1]))
+                    p++;
+                else if (str[p] == '.' || Tokenizer::IsSymbolChar(str + p, false))
+                    p += UTF8::CharSpan(str + p);
+                else if (str[p] == '\'' && isalnum((unsigned char)str[p + 1]))
+                    p++;  // digit separator
+                else
+                    break;
+            }
+        }
+        else if (ch == '"' || ch == '\'')
+        {
+            type = MacroToken::STRING;
+            p = LexQuoted(line, p);
+        }
+        else
+        {
+            type = MacroToken::OTHER;
+            for (auto punct : punctuators)
+            {
+                int n = strlen(punct);
+                if (!strncmp(str + p, punct, n))
+                {
+                    type = MacroToken::PUNCT;
+                    p += n;
+                    break;
+                }
+            }
+            if (type == MacroToken::OTHER)
+            {
+                if (ch < 0x80)
+                {
+                    if (ispunct(ch))
+                        type = MacroToken::PUNCT;
+                    p++;
+                }
+                else
+                {
+                    p += UTF8::CharSpan(str + p);
+                }
+            }
+        }
+        if (p > size)
+            p = size;
+        tokens.push_back(MacroToken(type, line.substr(start, p - start), space));
+        if (positions)
+        {
+            tokens.back().origStart = start;
+            tokens.back().origEnd = p;
+        }
+        space = false;
+    }
+}
+void ppExpand::ParseDefinition(Definition* d, const std::string& body)
+{
+    MacroTokenList tokens;
+    Lex(body, tokens, false);
+    DefinitionArgList* args = d->GetArgList();
+    bool varargs = !c89 && d->HasVarArgs();
+    // returns -2 if not an argument, -1 for __VA_ARGS__ in a macro that has no variable arguments
+    auto argIndex = [&](const MacroToken& tk) {
+        if (tk.type != MacroToken::IDENTIFIER)
+            return -2;
+        if (!c89 && tk.text == "__VA_ARGS__")
+            return varargs ? (int)args->size() : -1;
+        for (int i = 0; i < args->size(); i++)
+            if ((*args)[i] == tk.text)
+                return i;
+        return -2;
+    };
+    MacroTokenList list;
+    for (int i = 0; i < tokens.size(); i++)
+    {
+        MacroToken& tk = tokens[i];
+        if (tk.type == MacroToken::PUNCT && (tk.text == "##" || tk.text == "%:%:"))
+        {
+            tk.type = MacroToken::PASTE;
+        }
+        else if (args)
+        {
+            if (tk.type == MacroToken::PUNCT && (tk.text == "#" || tk.text == "%:") && i + 1 < tokens.size())
+            {
+                int n = argIndex(tokens[i + 1]);
+                if (n != -2)
+                {
+                    tk.type = MacroToken::STRINGIZE;
+                    tk.arg = n;
+                    list.push_back(tk);
+                    i++;
+                    continue;
+                }
+            }
+            int n = argIndex(tk);
+            if (n != -2)
+            {
+                tk.type = MacroToken::PARAM;
+                tk.arg = n;
+            }
+        }
+        list.push_back(tk);
+    }
+    d->SetTokens(list);
+}
+bool ppExpand::Input::Next(MacroToken& tk)
+{
+    while (!contexts.empty())
+    {
+        Context& ctx = contexts.back();
+        if (ctx.pos < ctx.tokens.size())
+        {
+            tk = std::move(ctx.tokens[ctx.pos++]);
+            if (boundary)
+            {
+                tk.avoidPaste = true;
+                boundary = false;
+            }
+            return true;
+        }
+        contexts.pop_back();
+        boundary = true;
+    }
+    if (pos < base.size())
+    {
+        tk = base[pos++];
+        if (tk.origEnd >= 0)
+            lastEnd = tk.origEnd;
+        if (boundary)
+        {
+            tk.avoidPaste = true;
+            boundary = false;
+        }
+        return true;
+    }
+    return false;
+}
+const ppExpand::MacroToken* ppExpand::Input::Peek()
+{
+    for (auto it = contexts.rbegin(); it != contexts.rend(); ++it)
+        if (it->pos < it->tokens.size())
+            return &it->tokens[it->pos];
+    if (pos < base.size())
+        return &base[pos];
+    return nullptr;
+}
+void ppExpand::Input::Push(MacroTokenList& list)
+{
+    contexts.push_back(Context());
+    contexts.back().tokens = std::move(list);
+    contexts.back().pos = 0;
+}
+bool ppExpand::Input::InContext()
+{
+    while (!contexts.empty() && contexts.back().pos >= contexts.back().tokens.size())
+    {
+        contexts.pop_back();
+        boundary = true;
+    }
+    return !contexts.empty();
+}
+bool ppExpand::IsMacro(const std::string& name)
+{
+    if (define->Lookup(name))
+        return true;
+    if (name.size() > 4 && name[0] == '_' && name[1] == '_')
+        return name == "__FILE__" || name == "__LINE__" || name == "__DATE__" || name == "__TIME__" || name == "__DATEISO__" ||
+               name == "__COUNTER__";
+    return false;
+}
+bool ppExpand::HasMacro(const std::string& line)
+{
+    const char* str = line.c_str();
+    int size = line.size();
+    std::string name;
+    for (int p = 0; p < size;)
+    {
+        if (Tokenizer::IsSymbolChar(str + p, true))
+        {
+            int start = p;
+            while (p < size && Tokenizer::IsSymbolChar(str + p, false))
+                p += UTF8::CharSpan(str + p);
+            name.assign(str + start, p - start);
+            if (IsMacro(name))
+                return true;
+        }
+        else if (isdigit((unsigned char)str[p]))
+        {
+            // skip pp-numbers so suffixes don't look like identifiers
+            for (p++; p < size && (str[p] == '.' || str[p] == '\'' || Tokenizer::IsSymbolChar(str + p, false));)
+                p += UTF8::CharSpan(str + p);
+        }
+        else if (str[p] == '"' || str[p] == '\'')
+        {
+            p = LexQuoted(line, p);
+        }
+        else
+        {
+            p++;
+        }
+    }
+    return false;
+}
+bool ppExpand::WouldPaste(const std::string& left, const std::string& right)
+{
+    if (left.empty() || right.empty())
+        return false;
+    unsigned char l = left.back(), r = right.front();
+    if (l >= 0x80 || r >= 0x80)
+        return true;
+    if (l == '/' && (r == '/' || r == '*'))
+        return true;
+    char buf[3] = {(char)l, (char)r, 0};
+    MacroTokenList tokens;
+    Lex(buf, tokens, false);
+    return tokens.size() == 1;
+}
+bool ppExpand::Expand(Input& in, MacroTokenList& out, bool eol, std::vector<Range>* ranges)
+{
+    MacroToken tk;
+    bool inRange = false;
+    while (true)
+    {
+        if (inRange && !in.InContext())
+        {
+            ranges->back().outEnd = out.size();
+            ranges->back().origEnd = in.LastEnd();
+            inRange = false;
+        }
+        if (!in.Next(tk))
+            break;
+        if (tk.type != MacroToken::IDENTIFIER || tk.noExpand)
+        {
+            out.push_back(std::move(tk));
+            continue;
+        }
+        int outStart = out.size();
+        int origStart = tk.origStart;
+        int rv = ExpandMacro(in, tk, out, eol);
+        if (rv < 0)
+            return false;
+        if (rv > 0 && ranges && !inRange)
+        {
+            // the name came from the line itself, track everything it turns into
+            Range range;
+            range.outStart = range.outEnd = outStart;
+            range.origStart = origStart;
+            range.origEnd = in.LastEnd();
+            ranges->push_back(range);
+            inRange = true;
+        }
+    }
+    if (inRange)
+    {
+        ranges->back().outEnd = out.size();
+        ranges->back().origEnd = in.LastEnd();
+    }
+    return true;
+}
+// returns 1 if the name was expanded onto the input, 0 if it was copied to the output,
+// -1 if the arguments continue on the next line
+int ppExpand::ExpandMacro(Input& in, MacroToken& name, MacroTokenList& out, bool eol)
+{
+    MacroTokenList result;
+    Definition* d = define->Lookup(name.text);
+    if (!d)
+    {
+        std::string value;
+        if (!define->Builtin(name.text, value))
+        {
+            out.push_back(std::move(name));
+            return 0;
+        }
+        Lex(value, result, false);
+        for (auto&& tk : result)
+            tk.hideSet = name.hideSet;
+    }
+    else if (HideSetContains(name.hideSet, d))
+    {
+        // painted blue, it can never be expanded again
+        name.noExpand = true;
+        out.push_back(std::move(name));
+        return 0;
+    }
+    else if (!d->GetArgList())
+    {
+        std::vector<MacroTokenList> args;
+        Substitute(d, args, HideSetAdd(name.hideSet, d), result);
+    }
+    else
+    {
+        const MacroToken* next = in.Peek();
+        if (!next && eol)
+            return -1;
+        if (!next || !IsPunct(*next, "("))
+        {
+            out.push_back(std::move(name));
+            return 0;
+        }
+        std::vector<MacroTokenList> args;
+        int rparenHideSet = 0;
+        int rv = CollectArgs(in, d, args, rparenHideSet, eol);
+        if (rv <= 0)
+        {
+            if (rv == 0)
+            {
+                name.noExpand = true;
+                out.push_back(std::move(name));
+            }
+            return rv;
+        }
+        Substitute(d, args, HideSetAdd(HideSetIntersect(name.hideSet, rparenHideSet), d), result);
+    }
+    if (!result.empty())
+    {
+        result.front().spaceBefore = name.spaceBefore;
+        result.front().avoidPaste = true;
+    }
+    in.Push(result);
+    return 1;
+}
+int ppExpand::CollectArgs(Input& in, Definition* d, std::vector<MacroTokenList>& args, int& rparenHideSet, bool eol)
+{
+    int slots = d->GetArgCount() + (!c89 && d->HasVarArgs() ? 1 : 0);
+    MacroTokenList consumed;
+    MacroToken tk;
+    int level = 0;
+    in.Next(tk);  // the open paren
+    consumed.push_back(tk);
+    args.push_back(MacroTokenList());
+    while (true)
+    {
+        if (!in.Next(tk))
+        {
+            if (eol)
+                return -1;
+            define->SyntaxError(d->GetName());
+            in.Push(consumed);
+            return 0;
+        }
+        consumed.push_back(tk);
+        if (tk.type == MacroToken::PUNCT)
+        {
+            if (tk.text == "(")
+            {
+                level++;
+            }
+            else if (tk.text == ")")
+            {
+                if (!level)
+                {
+                    rparenHideSet = tk.hideSet;
+                    break;
+                }
+                level--;
+            }
+            else if (tk.text == "," && !level && args.size() < slots)
+            {
+                // once the named arguments are used up the variable arguments get the rest, commas and all
+                args.push_back(MacroTokenList());
+                continue;
+            }
+        }
+        args.back().push_back(std::move(tk));
+    }
+    bool ok;
+    if (slots == 0)
+        ok = args.size() == 1 && args[0].empty();
+    else if (args.size() == slots)
+        ok = true;
+    else if (args.size() == slots - 1 && !c89 && d->HasVarArgs())
+    {
+        args.push_back(MacroTokenList());
+        ok = true;
+    }
+    else
+        ok = false;
+    if (!ok)
+    {
+        define->SyntaxError(d->GetName());
+        consumed.erase(consumed.begin());
+        in.Push(consumed);
+        // put the paren back in front of what was consumed
+        MacroTokenList paren;
+        paren.push_back(MacroToken(MacroToken::PUNCT, "(", false));
+        in.Push(paren);
+        return 0;
+    }
+    return 1;
+}
+void ppExpand::Substitute(Definition* d, std::vector<MacroTokenList>& args, int hideSet, MacroTokenList& result)
+{
+    static MacroTokenList empty;
+    MacroTokenList& body = d->GetTokens();
+    // arguments are only fully expanded when they are used outside # and ##
+    std::vector<std::unique_ptr<MacroTokenList>> expanded(args.size());
+    bool boundary = false;
+    for (int i = 0; i < body.size(); i++)
+    {
+        const MacroToken& tk = body[i];
+        if (tk.type == MacroToken::PASTE)
+        {
+            // a ## at the end of the body just goes away
+            if (i + 1 < body.size())
+            {
+                const MacroToken& next = body[++i];
+                MacroTokenList right;
+                if (next.type == MacroToken::PARAM)
+                {
+                    if (next.arg >= 0)
+                        right = args[next.arg];
+                }
+                else if (next.type == MacroToken::STRINGIZE)
+                {
+                    right.push_back(Stringize(next.arg >= 0 ? args[next.arg] : empty, next.spaceBefore));
+                }
+                else
+                {
+                    right.push_back(next);
+                }
+                Paste(result, right);
+            }
+            continue;
+        }
+        bool pasteNext = i + 1 < body.size() && body[i + 1].type == MacroToken::PASTE;
+        if (tk.type == MacroToken::STRINGIZE)
+        {
+            result.push_back(Stringize(tk.arg >= 0 ? args[tk.arg] : empty, tk.spaceBefore));
+        }
+        else if (tk.type == MacroToken::PARAM)
+        {
+            const MacroTokenList* arg = &empty;
+            if (tk.arg >= 0)
+            {
+                if (pasteNext)
+                {
+                    arg = &args[tk.arg];
+                }
+                else
+                {
+                    if (!expanded[tk.arg])
+                    {
+                        expanded[tk.arg] = std::make_unique<MacroTokenList>();
+                        Input in(args[tk.arg]);
+                        Expand(in, *expanded[tk.arg], false, nullptr);
+                    }
+                    arg = expanded[tk.arg].get();
+                }
+            }
+            if (arg->empty())
+            {
+                if (pasteNext)
+                    result.push_back(MacroToken(MacroToken::PLACEMARKER, "", tk.spaceBefore));
+            }
+            else
+            {
+                int n = result.size();
+                result.insert(result.end(), arg->begin(), arg->end());
+                result[n].spaceBefore = tk.spaceBefore;
+                result[n].avoidPaste = true;
+                boundary = true;
+            }
+            continue;
+        }
+        else
+        {
+            result.push_back(tk);
+        }
+        if (boundary)
+        {
+            result.back().avoidPaste = true;
+            boundary = false;
+        }
+    }
+    int n = 0;
+    for (int i = 0; i < result.size(); i++)
+    {
+        if (result[i].type != MacroToken::PLACEMARKER)
+        {
+            if (n != i)
+                result[n] = std::move(result[i]);
+            result[n].hideSet = HideSetUnion(result[n].hideSet, hideSet);
+            n++;
+        }
+    }
+    result.resize(n);
+}
+void ppExpand::Paste(MacroTokenList& result, MacroTokenList& right)
+{
+    if (right.empty())
+        return;
+    if (result.empty() || right.front().type == MacroToken::PLACEMARKER)
+    {
+        result.insert(result.end(), result.empty() ? right.begin() : right.begin() + 1, right.end());
+        return;
+    }
+    MacroToken left = std::move(result.back());
+    result.pop_back();
+    if (left.type == MacroToken::PLACEMARKER)
+    {
+        result.insert(result.end(), right.begin(), right.end());
+        result[result.size() - right.size()].spaceBefore = left.spaceBefore;
+        return;
+    }
+    // the pasted text is lexed again, if it doesn't form a single token the pieces just sit next to each other
+    MacroTokenList pasted;
+    Lex(left.text + right.front().text, pasted, false);
+    int hideSet = HideSetIntersect(left.hideSet, right.front().hideSet);
+    for (auto&& tk : pasted)
+        tk.hideSet = hideSet;
+    if (!pasted.empty())
+    {
+        pasted.front().spaceBefore = left.spaceBefore;
+        pasted.front().avoidPaste = left.avoidPaste;
+    }
+    result.insert(result.end(), pasted.begin(), pasted.end());
+    result.insert(result.end(), right.begin() + 1, right.end());
+}
+ppExpand::MacroToken ppExpand::Stringize(const MacroTokenList& arg, bool spaceBefore)
+{
+    std::string text = "\"";
+    for (int i = 0; i < arg.size(); i++)
+    {
+        if (i && arg[i].spaceBefore)
+            text += " ";
+        if (arg[i].type == MacroToken::STRING)
+        {
+            for (auto ch : arg[i].text)
+            {
+                if (ch == '"' || ch == '\\')
+                    text += '\\';
+                text += ch;
+            }
+        }
+        else
+        {
+            text += arg[i].text;
+        }
+    }
+    text += "\"";
+    return MacroToken(MacroToken::STRING, text, spaceBefore);
+}
+int ppExpand::Process(std::string& line, bool leavePlaceholder, bool eol, std::deque<ppDefine::TokenPos>& positions)
+{
+    // most lines don't have macros on them, don't bother breaking those up
+    if (!HasMacro(line))
+        return 0;
+    MacroTokenList tokens;
+    tokens.reserve(line.size() / 4);
+    Lex(line, tokens, true);
+    ResetHideSets();
+    Input in(tokens);
+    MacroTokenList out;
+    std::vector<Range> ranges;
+    if (!Expand(in, out, eol, &ranges))
+        return INT_MIN + 1;
+
+    // now put the text back together.   Anything that didn't come from a macro is copied straight
+    // from the original line so that spacing and token positions are left alone
+    static const char placeholder[2] = {ppDefine::MACRO_PLACEHOLDER, 0};
+    std::string rv;
+    rv.reserve(line.size() * 2);
+    int pos = 0;
+    int r = 0;
+    for (int i = 0; i < out.size() || r < ranges.size();)
+    {
+        if (r < ranges.size() && ranges[r].outStart == i)
+        {
+            Range& range = ranges[r++];
+            rv += line.substr(pos, range.origStart - pos);
+            ppDefine::TokenPos tokenPos;
+            tokenPos.origStart = range.origStart;
+            tokenPos.origEnd = range.origEnd;
+            tokenPos.newStart = rv.size();
+            if (leavePlaceholder)
+                rv += placeholder;
+            for (int j = range.outStart; j < range.outEnd; j++)
+            {
+                const MacroToken& tk = out[j];
+                if (j != range.outStart && tk.spaceBefore)
+                    rv += " ";
+                else if (leavePlaceholder ? j != range.outStart && tk.avoidPaste : WouldPaste(rv, tk.text))
+                    rv += leavePlaceholder ? placeholder : " ";
+                rv += tk.text;
+            }
+            if (leavePlaceholder)
+                rv += placeholder;
+            else if (range.origEnd < line.size() && WouldPaste(rv, line.substr(range.origEnd, 1)))
+                rv += " ";
+            tokenPos.newEnd = rv.size();
+            positions.push_back(tokenPos);
+            pos = range.origEnd;
+            i = range.outEnd;
+        }
+        else
+        {
+            const MacroToken& tk = out[i++];
+            if (tk.origEnd >= pos)
+            {
+                rv += line.substr(pos, tk.origEnd - pos);
+                pos = tk.origEnd;
+            }
+            else
+            {
+                rv += " " + tk.text;
+            }
+        }
+    }
+    rv += line.substr(pos);
+    int n = rv.size() - line.size();
+    line = std::move(rv);
+    return n;
+}
+void ppExpand::ResetHideSets()
+{
+    if (hideSets.size() != 1)
+    {
+        hideSets.clear();
+        hideSetIds.clear();
+        hideSetUnions.clear();
+        hideSetIntersections.clear();
+        hideSetAdds.clear();
+        hideSets.push_back(std::vector<Definition*>());
+        hideSetIds[hideSets[0]] = 0;
+    }
+}
+int ppExpand::InternHideSet(std::vector<Definition*>& members)
+{
+    auto it = hideSetIds.find(members);
+    if (it != hideSetIds.end())
+        return it->second;
+    int rv = hideSets.size();
+    hideSets.push_back(members);
+    hideSetIds[members] = rv;
+    return rv;
+}
+int ppExpand::HideSetAdd(int hideSet, Definition* d)
+{
+    auto key = std::make_pair(hideSet, d);
+    auto it = hideSetAdds.find(key);
+    if (it != hideSetAdds.end())
+        return it->second;
+    std::vector<Definition*> members = hideSets[hideSet];
+    auto pos = std::lower_bound(members.begin(), members.end(), d);
+    if (pos == members.end() || *pos != d)
+        members.insert(pos, d);
+    int rv = InternHideSet(members);
+    hideSetAdds[key] = rv;
+    return rv;
+}
+int ppExpand::HideSetUnion(int left, int right)
+{
+    if (left == right || right == 0)
+        return left;
+    if (left == 0)
+        return right;
+    auto key = std::make_pair(std::min(left, right), std::max(left, right));
+    auto it = hideSetUnions.find(key);
+    if (it != hideSetUnions.end())
+        return it->second;
+    std::vector<Definition*> members;
+    std::set_union(hideSets[left].begin(), hideSets[left].end(), hideSets[right].begin(), hideSets[right].end(),
+                   std::back_inserter(members));
+    int rv = InternHideSet(members);
+    hideSetUnions[key] = rv;
+    return rv;
+}
+int ppExpand::HideSetIntersect(int left, int right)
+{
+    if (left == right)
+        return left;
+    if (left == 0 || right == 0)
+        return 0;
+    auto key = std::make_pair(std::min(left, right), std::max(left, right));
+    auto it = hideSetIntersections.find(key);
+    if (it != hideSetIntersections.end())
+        return it->second;
+    std::vector<Definition*> members;
+    std::set_intersection(hideSets[left].begin(), hideSets[left].end(), hideSets[right].begin(), hideSets[right].end(),
+                          std::back_inserter(members));
+    int rv = InternHideSet(members);
+    hideSetIntersections[key] = rv;
+    return rv;
+}
+bool ppExpand::HideSetContains(int hideSet, Definition* d) const
+{
+    return hideSet && std::binary_search(hideSets[hideSet].begin(), hideSets[hideSet].end(), d);
+}
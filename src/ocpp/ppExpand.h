@@ -0,0 +1,115 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#ifndef ppExpand_h
+#define ppExpand_h
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include "ppDefine.h"
+
+// token based macro expansion.   Source lines are broken into tokens, expanded over token lists
+// using hide sets to stop recursion (Prosser's algorithm) and only turned back into text once
+// the whole line is done.
+class ppExpand
+{
+  public:
+    typedef ppDefine::MacroToken MacroToken;
+    typedef ppDefine::MacroTokenList MacroTokenList;
+    typedef ppDefine::Definition Definition;
+
+    ppExpand(ppDefine* Define, bool C89) : define(Define), c89(C89) { ResetHideSets(); }
+    ~ppExpand() {}
+
+    int Process(std::string& line, bool leavePlaceholder, bool eol, std::deque<ppDefine::TokenPos>& positions);
+    void ParseDefinition(Definition* d, const std::string& body);
+
+    static void Lex(const std::string& line, MacroTokenList& tokens, bool positions);
+
+  protected:
+    class Context
+    {
+      public:
+        MacroTokenList tokens;
+        size_t pos;
+    };
+    // a source of tokens: the text being expanded, with the replacement lists of macros
+    // currently being rescanned stacked on top of it
+    class Input
+    {
+      public:
+        Input(const MacroTokenList& Base) : base(Base), pos(0), lastEnd(0), boundary(false) {}
+        bool Next(MacroToken& tk);
+        const MacroToken* Peek();
+        void Push(MacroTokenList& list);
+        bool InContext();
+        int LastEnd() const { return lastEnd; }
+
+      private:
+        const MacroTokenList& base;
+        size_t pos;
+        int lastEnd;
+        bool boundary;
+        std::vector<Context> contexts;
+    };
+    // the part of the output that came from expanding one macro found in the source line
+    class Range
+    {
+      public:
+        int outStart;
+        int outEnd;
+        int origStart;
+        int origEnd;
+    };
+    bool Expand(Input& in, MacroTokenList& out, bool eol, std::vector<Range>* ranges);
+    int ExpandMacro(Input& in, MacroToken& name, MacroTokenList& out, bool eol);
+    int CollectArgs(Input& in, Definition* d, std::vector<MacroTokenList>& args, int& rparenHideSet, bool eol);
+    void Substitute(Definition* d, std::vector<MacroTokenList>& args, int hideSet, MacroTokenList& result);
+    void Paste(MacroTokenList& result, MacroTokenList& right);
+    MacroToken Stringize(const MacroTokenList& arg, bool spaceBefore);
+    bool IsMacro(const std::string& name);
+    bool HasMacro(const std::string& line);
+    static bool WouldPaste(const std::string& left, const std::string& right);
+    static bool IsPunct(const MacroToken& tk, const char* text) { return tk.type == MacroToken::PUNCT && tk.text == text; }
+
+    void ResetHideSets();
+    int HideSetAdd(int hideSet, Definition* d);
+    int HideSetUnion(int left, int right);
+    int HideSetIntersect(int left, int right);
+    bool HideSetContains(int hideSet, Definition* d) const;
+    int InternHideSet(std::vector<Definition*>& members);
+
+  private:
+    ppDefine* define;
+    bool c89;
+    std::vector<std::vector<Definition*>> hideSets;
+    std::map<std::vector<Definition*>, int> hideSetIds;
+    std::map<std::pair<int, int>, int> hideSetUnions;
+    std::map<std::pair<int, int>, int> hideSetIntersections;
+    std::map<std::pair<int, Definition*>, int> hideSetAdds;
+};
+#endif
@@ -29,6 +29,7 @@
 #include "ppkw.h"
 #include "Errors.h"
 #include "CmdFiles.h"
+#include "Trace.h"
 #include <climits>
 #include <fstream>
 #include <iostream>
@@ -36,6 +37,7 @@
 #include <algorithm>
 bool ppInclude::system;
 std::string ppInclude::srchPath, ppInclude::sysSrchPath;
+std::unordered_map<std::string, bool> ppInclude::existingFiles;
 
 char ppInclude::commentChar = ';';
 
@@ -172,6 +174,7 @@ void ppInclude::pushFile(const std::string& name, const std::string& errname, bo
         // cached object.
         current = std::make_unique<ppFile>(fullname, trigraphs, extendedComment, name, define, *ctx, unsignedchar, c89, asmpp,
                                            piper, dirs_traversed);
+        Trace::Begin("preprocess", "include", name.c_str(), Trace::INCLUDES);
         // if (current)
         if (!current->Open())
         {
@@ -199,6 +202,8 @@ bool ppInclude::popFile()
 {
     if (systemNesting)
         systemNesting--;
+    if (current)
+        Trace::End(Trace::INCLUDES);
     if (!files.empty())
     {
         current = std::move(files.front());
@@ -376,7 +381,7 @@ std::string ppInclude::SrchPath(bool system, const std::string& name, const std:
         {
             *p = CmdFiles::DIR_SEP[0];
         }
-        if (Utils::FileExists(buf))
+        if (FileExists(buf))
         {
             if (filesSkipped > 0)  // we lie to ourselves about how many files we skip while searching so that we go past the
                                    // current file's directory
@@ -390,6 +395,15 @@ std::string ppInclude::SrchPath(bool system, const std::string& name, const std:
     } while (path);
     return "";
 }
+bool ppInclude::FileExists(const std::string& name)
+{
+    auto it = existingFiles.find(name);
+    if (it != existingFiles.end())
+        return it->second;
+    bool rv = Utils::FileExists(name.c_str());
+    existingFiles[name] = rv;
+    return rv;
+}
 const char* ppInclude::RetrievePath(char* buf, const char* path)
 {
     while (*path && *path != ';')
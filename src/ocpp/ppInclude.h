@@ -126,6 +126,8 @@ class ppInclude
     std::set<std::string>& GetSysIncludes() { return sysIncludes; }
 
     static void SetCommentChar(char ch) { commentChar = ch; }
+    // forget which include candidates were found, for a process that goes on to another compile
+    static void ClearFileCache() { existingFiles.clear(); }
     int AnonymousIndex() const
     {
         if (current)
@@ -148,6 +150,7 @@ class ppInclude
                          int& filesSkipped);
     const char* RetrievePath(char* buf, const char* path);
     void AddName(char* buf, const std::string& name);
+    static bool FileExists(const std::string& name);
 
   private:
     static bool system;
@@ -164,6 +167,10 @@ class ppInclude
     bool fullname;
     ppExpr expr;
     static std::string srchPath, sysSrchPath;
+    // include searches probe the same directories over and over, and in a batch compile the same
+    // headers are found for every file, so remember what was there for the life of the process.
+    // The compile server clears it for each request, so headers that appear later are found
+    static std::unordered_map<std::string, bool> existingFiles;
     ppCtx* ctx;
     std::string inProc;
     bool asmpp;
@@ -30,6 +30,11 @@
 #include <iomanip>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
 #else
@@ -125,7 +130,8 @@ void GrepMain::SetModes(void)
         displayHeaderFileName.SetValue(true);
     }
 }
-void GrepMain::DisplayMatch(const std::string& fileName, int& matchCount, int lineno, const char* startpos, const char* text)
+void GrepMain::DisplayMatch(std::ostream& out, const std::string& fileName, int& matchCount, int lineno, const char* startpos,
+                            const char* text)
 {
     if (quiet.GetValue())
     {
@@ -133,9 +139,9 @@ void GrepMain::DisplayMatch(const std::string& fileName, int& matchCount, int li
     }
     if (matchCount == 0 && displayHeaderFileName.GetValue())
     {
-        std::cout << "FILE: " << fileName;
+        out << "FILE: " << fileName;
         if (verboseMode.GetValue() || !displayMatchCount.GetValue())
-            std::cout << std::endl;
+            out << std::endl;
     }
     if (!displayFileNamesOnly.GetValue())
     {
@@ -146,7 +152,7 @@ void GrepMain::DisplayMatch(const std::string& fileName, int& matchCount, int li
         if (!q)
             q = p + strlen(p);
         if (showBefore.GetValue() || showAfter.GetValue())
-            std::cout << "--" << std::endl;
+            out << "--" << std::endl;
         for (int i = 0; i < showBefore.GetValue() + 1 && p > startpos;)
         {
             if (p[-1] == '\n')
@@ -170,24 +176,24 @@ void GrepMain::DisplayMatch(const std::string& fileName, int& matchCount, int li
             {
                 int n = fileName.size();
                 n = ((n + 8) / 8) * 8;
-                std::cout << std::setfill(' ') << std::setw(n) << std::left << fileName;
+                out << std::setfill(' ') << std::setw(n) << std::left << fileName;
             }
             if (displayLineNumbers.GetValue())
             {
-                std::cout << std::setfill(' ') << std::setw(8) << std::left << lineno++;
+                out << std::setfill(' ') << std::setw(8) << std::left << lineno++;
             }
             std::string buf(p + 1, s - p - 1);
-            std::cout << buf;
+            out << buf;
 
             p = s;
-            std::cout << std::endl;
+            out << std::endl;
         }
     }
     matchCount++;
-    std::cout.clear();
+    out.clear();
 }
-void GrepMain::FindLine(const std::string fileName, int& matchCount, int& matchLine, char** matchPos, char* startpos, char* curpos,
-                        bool matched)
+void GrepMain::FindLine(std::ostream& out, const std::string fileName, int& matchCount, int& matchLine, char** matchPos,
+                        char* startpos, char* curpos, bool matched)
 {
     char* p = *matchPos;
     do
@@ -199,7 +205,7 @@ void GrepMain::FindLine(const std::string fileName, int& matchCount, int& matchL
         {
             if (displayNonMatching.GetValue())
             {
-                DisplayMatch(fileName, matchCount, matchLine, startpos, p);
+                DisplayMatch(out, fileName, matchCount, matchLine, startpos, p);
             }
             if (*p)
             {
@@ -210,7 +216,7 @@ void GrepMain::FindLine(const std::string fileName, int& matchCount, int& matchL
     } while (p < curpos);
     if (matched && !displayNonMatching.GetValue())
     {
-        DisplayMatch(fileName, matchCount, matchLine, startpos, curpos);
+        DisplayMatch(out, fileName, matchCount, matchLine, startpos, curpos);
     }
     if (*p)
     {
@@ -219,19 +225,20 @@ void GrepMain::FindLine(const std::string fileName, int& matchCount, int& matchL
     }
     *matchPos = p;
 }
-int GrepMain::OneFile(RegExpContext& regexp, const std::string fileName, std::istream& fil, int& openCount)
+int GrepMain::OneFile(RegExpContext& regexp, const std::string fileName, std::istream& fil, std::ostream& out, int& openCount)
 {
     openCount++;
-    // couldn't do this as a straight definition as MSVC decided to treat it as a func
-    std::unique_ptr<std::string> str =
-        std::make_unique<std::string>(std::istreambuf_iterator<char>(fil), std::istreambuf_iterator<char>());
-    str->erase(std::remove(str->begin(), str->end(), '\r'), str->end());
-    std::string bufs = " " + *str;
-    bufs[0] = 0;
+    // the buffer starts with a null so the display code can always look one character back
+    std::string bufs(1, 0);
+    char block[32768];
+    while (fil.read(block, sizeof(block)) || fil.gcount())
+        bufs.append(block, fil.gcount());
+    bufs.erase(std::remove(bufs.begin() + 1, bufs.end(), '\r'), bufs.end());
     int matchCount = 0;
     int lineno = 0;
-    int length = bufs.size() - 1;
-    if (!fil.fail())
+    // nothing past a null in the file is searched
+    int length = strlen(bufs.c_str() + 1);
+    if (!fil.bad())
     {
         char* buf = const_cast<char*>(bufs.c_str());
         char* start = buf;
@@ -242,15 +249,15 @@ int GrepMain::OneFile(RegExpContext& regexp, const std::string fileName, std::is
         while (matched && matchCount < maxMatches.GetValue())
         {
             char* p = nullptr;
-            matched = regexp.Match(str - buf, length, buf);
+            matched = regexp.Match(str - buf, length + 1 - (str - buf), buf);
             if (matched)
             {
-                FindLine(fileName, matchCount, matchLine, &matchPos, start, buf + regexp.GetStart(), true);
+                FindLine(out, fileName, matchCount, matchLine, &matchPos, start, buf + regexp.GetStart(), true);
                 p = (char *)strchr((char*)buf + regexp.GetEnd(), '\n');
             }
             else
             {
-                FindLine(fileName, matchCount, matchLine, &matchPos, start, str + strlen(str), false);
+                FindLine(out, fileName, matchCount, matchLine, &matchPos, start, str + strlen(str), false);
             }
             if (!p)
                 p = str + strlen(str);
@@ -262,20 +269,71 @@ int GrepMain::OneFile(RegExpContext& regexp, const std::string fileName, std::is
         {
             if (displayNonMatching.GetValue())
             {
-                std::cout << matchCount << " Non-matching lines" << std::endl;
+                out << matchCount << " Non-matching lines" << std::endl;
             }
             else
             {
-                std::cout << matchCount << " Matching lines" << std::endl;
+                out << matchCount << " Matching lines" << std::endl;
             }
         }
         else if (matchCount && displayMatchCount.GetValue() && !quiet.GetValue())
         {
-            std::cout << ": " << matchCount << std::endl;
+            out << ": " << matchCount << std::endl;
         }
     }
     return matchCount;
 }
+int GrepMain::SearchFiles(const char* pattern, CmdFiles& files, int& openCount)
+{
+    // each file is searched by whichever thread gets to it first, into its own buffer, and the
+    // buffers are written out in command line order as they become ready.
+    struct Result
+    {
+        std::ostringstream out;
+        int matchCount = 0;
+        int openCount = 0;
+        bool done = false;
+    };
+    std::vector<std::string> names(files.FileNameBegin(), files.FileNameEnd());
+    std::vector<Result> results(names.size());
+    std::atomic<int> next(0);
+    std::mutex mutex;
+    std::condition_variable ready;
+    auto worker = [&]() {
+        RegExpContext regexp(pattern, regularExpressions.GetValue(), !caseInSensitive.GetValue(), completeWords.GetValue());
+        for (int i; (i = next++) < names.size();)
+        {
+            Result& result = results[i];
+            std::fstream fil(names[i], std::ios::in | std::ios::binary);
+            if (fil.is_open())
+                result.matchCount = OneFile(regexp, names[i], fil, result.out, result.openCount);
+            std::lock_guard<std::mutex> lock(mutex);
+            result.done = true;
+            ready.notify_all();
+        }
+    };
+    int jobs = std::max(1u, std::thread::hardware_concurrency());
+    if (jobs > names.size())
+        jobs = names.size();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < jobs; i++)
+        threads.push_back(std::thread(worker));
+    int matchCount = 0;
+    for (auto&& result : results)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [&result]() { return result.done; });
+        }
+        std::cout << result.out.str();
+        result.out.str(std::string());
+        matchCount += result.matchCount;
+        openCount += result.openCount;
+    }
+    for (auto&& t : threads)
+        t.join();
+    return matchCount;
+}
 void GrepMain::usage(const char* prog_name, const char* text, int retcode)
 {
     fprintf(stderr, "\nusage: %s %s", Utils::ShortName(prog_name), text);
@@ -329,15 +387,12 @@ int GrepMain::Run(int argc, char** argv)
     int matchCount = 0;
     if (!isatty(fileno(stdin)))
     {
-        matchCount += OneFile(regexp, "STDIN", std::cin, openCount);
+        matchCount += OneFile(regexp, "STDIN", std::cin, std::cout, openCount);
     }
     else
-        for (auto it = files.FileNameBegin(); it != files.FileNameEnd(); ++it)
-        {
-            std::fstream fil((*it), std::ios::in | std::ios::binary);
-            if (fil.is_open())
-                matchCount += OneFile(regexp, (*it), fil, openCount);
-        }
+    {
+        matchCount += SearchFiles(argv[1], files, openCount);
+    }
     if (openCount == 0)
     {
         if (!quiet.GetValue())
@@ -26,16 +26,21 @@
 #define GREPMAIN_H
 #include "RegExp.h"
 #include "CmdSwitch.h"
+#include <iostream>
+
+class CmdFiles;
 
 class GrepMain
 {
   public:
     int Run(int argc, char** argv);
     void SetModes();
-    void DisplayMatch(const std::string& fileName, int& matchCount, int lineno, const char* startpos, const char* text);
-    void FindLine(const std::string fileName, int& matchCount, int& matchLine, char** matchPos, char* startpos, char* curpos,
-                  bool matched);
-    int OneFile(RegExpContext& regexp, const std::string fileName, std::istream& file, int& openCount);
+    void DisplayMatch(std::ostream& out, const std::string& fileName, int& matchCount, int lineno, const char* startpos,
+                      const char* text);
+    void FindLine(std::ostream& out, const std::string fileName, int& matchCount, int& matchLine, char** matchPos, char* startpos,
+                  char* curpos, bool matched);
+    int OneFile(RegExpContext& regexp, const std::string fileName, std::istream& file, std::ostream& out, int& openCount);
+    int SearchFiles(const char* pattern, CmdFiles& files, int& openCount);
 
   private:
     static CmdSwitchParser SwitchParser;
@@ -341,6 +341,26 @@ int RegExpMatch::Matches(RegExpContext& context, const char* str)
     }
     return MatchOne(context, str);
 }
+int RegExpMatch::GetLiteral(bool caseSensitive) const
+{
+    // an element that always consumes exactly one character, which may come in either case
+    if (rl >= 0 || rh >= 0)
+        return -1;
+    int rv = -1;
+    for (int i = 0; i < 256; i++)
+    {
+        if (IsSet(i))
+        {
+            if (i >= 128)
+                return -1;
+            if (rv == -1)
+                rv = i;
+            else if (caseSensitive || toupper(i) != toupper(rv))
+                return -1;
+        }
+    }
+    return rv;
+}
 void RegExpContext::Clear()
 {
     matches.clear();
@@ -553,6 +573,112 @@ void RegExpContext::Parse(const char* exp, bool regular, bool CaseSensitive, boo
     {
         matches.push_back(std::make_unique<RegExpMatch>(RegExpMatch::RE_M_EWORD, caseSensitive));
     }
+    if (!invalid)
+        ExtractLiteral();
+    RegExpMatch::Init(caseSensitive);
+}
+void RegExpContext::ExtractLiteral()
+{
+    literal.clear();
+    std::string current;
+    for (auto& match : matches)
+    {
+        // the line a candidate is found on is where a match has to start, which only holds
+        // if nothing in the expression can cross a line end
+        if (match->CanMatchNewline())
+        {
+            literal.clear();
+            return;
+        }
+        int ch = match->GetLiteral(caseSensitive);
+        if (ch >= 0)
+        {
+            current += (char)ch;
+        }
+        else
+        {
+            if (current.size() > literal.size())
+                literal = current;
+            current.clear();
+        }
+    }
+    if (current.size() > literal.size())
+        literal = current;
+    // look for the character least likely to be common in text; when letter case is ignored a
+    // character that has no case saves searching for it twice
+    int best = -1;
+    for (int i = 0; i < literal.size(); i++)
+    {
+        UBYTE ch = literal[i];
+        int rank;
+        if (!caseSensitive && isalpha(ch))
+            rank = 0;
+        else if (ch == ' ' || islower(ch))
+            rank = 1;
+        else
+            rank = 2;
+        if (rank > best)
+        {
+            best = rank;
+            anchor = i;
+        }
+    }
+    anchorFolds = !caseSensitive && best == 0;
+}
+bool RegExpContext::CompareLiteral(const char* str) const
+{
+    if (caseSensitive)
+        return !memcmp(str, literal.c_str(), literal.size());
+    for (int i = 0; i < literal.size(); i++)
+        if (toupper((UBYTE)str[i]) != toupper((UBYTE)literal[i]))
+            return false;
+    return true;
+}
+const char* RegExpContext::FindLiteral(const char* str, const char* end)
+{
+    // memchr, which the C library does many bytes at a time, finds the anchor character and
+    // the rest of the literal is compared at each place it turns up
+    const char* last = end - literal.size();
+    const char* lower = nullptr;
+    const char* upper = nullptr;
+    bool lowerDone = false, upperDone = false;
+    while (str <= last)
+    {
+        const char* p = str + anchor;
+        size_t len = last - str + 1;
+        const char* q;
+        if (anchorFolds)
+        {
+            // remember where each case was found so neither is searched for twice
+            if (!lowerDone && (!lower || lower < p))
+            {
+                lower = (const char*)memchr(p, tolower((UBYTE)literal[anchor]), len);
+                lowerDone = !lower;
+            }
+            if (!upperDone && (!upper || upper < p))
+            {
+                upper = (const char*)memchr(p, toupper((UBYTE)literal[anchor]), len);
+                upperDone = !upper;
+            }
+            if (lowerDone)
+                q = upperDone ? nullptr : upper;
+            else if (upperDone)
+                q = lower;
+            else
+                q = lower < upper ? lower : upper;
+        }
+        else
+        {
+            q = (const char*)memchr(p, literal[anchor], len);
+        }
+        if (!q)
+            return nullptr;
+        q -= anchor;
+        if (CompareLiteral(q))
+            return q;
+        str = q + 1;
+    }
+    return nullptr;
 }
 int RegExpContext::MatchOne(const char* str)
 {
@@ -574,9 +700,24 @@ bool RegExpContext::Match(int start, int len, const char* Beginning)
     beginning = Beginning;
     const char* str = Beginning + start;
     const char* end = str + len;
+    const char* lineEnd = nullptr;
     matchStackTop = 0;
     while (*str && str < end)
     {
+        if (!literal.empty() && (!lineEnd || str > lineEnd))
+        {
+            // only the line holding the next copy of the literal can start a match
+            const char* found = FindLiteral(str, end);
+            if (!found)
+                return false;
+            const char* lineStart = found;
+            while (lineStart > str && lineStart[-1] != '\n')
+                lineStart--;
+            str = lineStart;
+            lineEnd = (const char*)memchr(found, '\n', end - found);
+            if (!lineEnd)
+                lineEnd = end;
+        }
         int n = MatchOne(str);
         if (n >= 0)
         {
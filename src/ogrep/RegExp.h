@@ -31,6 +31,7 @@ typedef unsigned char UBYTE;
 #include <cctype>
 #include <cstring>
 #include <memory>
+#include <string>
 class RegExpContext;
 
 class RegExpMatch
@@ -118,6 +119,8 @@ class RegExpMatch
     int GetMatchRange() const { return matchRange; }
     void SetInterval(int Rl, int Rh) { rl = Rl, rh = Rh; }
     int Matches(RegExpContext& context, const char* str);
+    int GetLiteral(bool caseSensitive) const;
+    bool CanMatchNewline() const { return IsSet('\n'); }
     static void Init(bool caseSensitive);
 
     static void Reset(bool caseSensitive) { Init(caseSensitive); }
@@ -151,7 +154,7 @@ class RegExpContext
 
   public:
     RegExpContext(const char* exp, bool regular, bool caseSensitive, bool matchesWord) :
-        caseSensitive(true), m_so(0), m_eo(0), invalid(false), beginning(nullptr)
+        caseSensitive(true), m_so(0), m_eo(0), invalid(false), beginning(nullptr), anchor(0), anchorFolds(false)
     {
         matchStackTop = 0;
         Parse(exp, regular, caseSensitive, matchesWord);
@@ -169,6 +172,9 @@ class RegExpContext
     int GetSpecial(char ch);
     int MatchOne(const char* str);
     void Clear();
+    void ExtractLiteral();
+    const char* FindLiteral(const char* str, const char* end);
+    bool CompareLiteral(const char* str) const;
 
   private:
     std::deque<std::unique_ptr<RegExpMatch>> matches;
@@ -181,6 +187,11 @@ class RegExpContext
     int matchStackTop;
     int matchOffsets[10][2];
     int matchCount;
+    // longest run of single characters every match has to contain, and the position in it
+    // that candidates are searched for
+    std::string literal;
+    int anchor;
+    bool anchorFolds;
 };
 
 #endif
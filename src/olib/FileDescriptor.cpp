@@ -25,6 +25,9 @@
 #include "LibFiles.h"
 #include "ObjFile.h"
 
-LibFiles::FileDescriptor::FileDescriptor(const ObjString& Name) : offset(0), name(Name), data(nullptr) {}
-LibFiles::FileDescriptor::FileDescriptor(const FileDescriptor& old) : name(old.name), offset(old.offset), data(nullptr) {}
+LibFiles::FileDescriptor::FileDescriptor(const ObjString& Name) : offset(0), index(-1), name(Name), data(nullptr) {}
+LibFiles::FileDescriptor::FileDescriptor(const FileDescriptor& old) :
+    name(old.name), offset(old.offset), index(old.index), data(nullptr)
+{
+}
 LibFiles::FileDescriptor::~FileDescriptor() {}
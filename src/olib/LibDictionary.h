@@ -28,6 +28,7 @@
 #include "ObjTypes.h"
 #include <cstdio>
 #include <unordered_map>
+#include <vector>
 
 class ObjFile;
 class LibFiles;
@@ -59,8 +60,12 @@ class LibDictionary
     LibDictionary(bool CaseSensitive = true) : caseSensitive(CaseSensitive) { DictCompare::caseSensitive = CaseSensitive; }
     ~LibDictionary() {}
     ObjInt Lookup(FILE* stream, ObjInt dictOffset, ObjInt dictPages, const ObjString& str);
+    bool Load(FILE* stream, ObjInt dictOffset);
     bool Write(FILE* stream);
     void CreateDictionary(LibFiles& files);
+    void AddModule(ObjFile* file, int index);
+    void Renumber(const std::vector<int>& newIndexes, std::vector<ObjString>& dropped);
+    bool Defines(const std::vector<ObjString>& names) const;
     void Clear() { dictionary.clear(); }
 
   protected:
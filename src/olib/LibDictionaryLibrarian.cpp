@@ -35,8 +35,6 @@
 
 void LibDictionary::CreateDictionary(LibFiles& files)
 {
-    int total = 0;
-    int symbols = 0;
     Clear();
     int i = 0;
     for (auto it = files.FileBegin(); it != files.FileEnd(); ++it)
@@ -44,36 +42,66 @@ void LibDictionary::CreateDictionary(LibFiles& files)
         const LibFiles::FileDescriptor* fd = (*it).get();
         if (fd->data)
         {
-            for (auto pi = fd->data->PublicBegin(); pi != fd->data->PublicEnd(); ++pi)
-            {
-                InsertInDictionary((*pi)->GetName().c_str(), i);
-            }
-            for (auto pi = fd->data->ImportBegin(); pi != fd->data->ImportEnd(); ++pi)
-            {
-                if (static_cast<ObjImportSymbol*>(*pi)->GetDllName().size())
-                    InsertInDictionary((*pi)->GetName().c_str(), i);
-            }
-            // support for virtual sections
-            for (auto si = fd->data->SectionBegin(); si != fd->data->SectionEnd(); ++si)
+            AddModule(fd->data, i);
+            i++;
+        }
+    }
+}
+void LibDictionary::AddModule(ObjFile* file, int index)
+{
+    for (auto pi = file->PublicBegin(); pi != file->PublicEnd(); ++pi)
+    {
+        InsertInDictionary((*pi)->GetName().c_str(), index);
+    }
+    for (auto pi = file->ImportBegin(); pi != file->ImportEnd(); ++pi)
+    {
+        if (static_cast<ObjImportSymbol*>(*pi)->GetDllName().size())
+            InsertInDictionary((*pi)->GetName().c_str(), index);
+    }
+    // support for virtual sections
+    for (auto si = file->SectionBegin(); si != file->SectionEnd(); ++si)
+    {
+        if ((*si)->GetQuals() & ObjSection::virt)
+        {
+            int j;
+            std::string name = (*si)->GetName();
+            for (j = 0; j < name.size(); j++)
+                if (name[j] == '@')
+                    break;
+            if (j < name.size())
             {
-                if ((*si)->GetQuals() & ObjSection::virt)
-                {
-                    int j;
-                    std::string name = (*si)->GetName();
-                    for (j = 0; j < name.size(); j++)
-                        if (name[j] == '@')
-                            break;
-                    if (j < name.size())
-                    {
-                        name = name.substr(j);
-                        InsertInDictionary(name.c_str(), i);
-                    }
-                }
+                name = name.substr(j);
+                InsertInDictionary(name.c_str(), index);
             }
-            i++;
         }
     }
 }
+// moves entries loaded from an existing library to the modules' new positions.  Entries
+// for modules that are gone (or are about to be replaced) have a new index of -1 and are dropped,
+// their names are returned in dropped
+void LibDictionary::Renumber(const std::vector<int>& newIndexes, std::vector<ObjString>& dropped)
+{
+    for (auto it = dictionary.begin(); it != dictionary.end();)
+    {
+        if (it->second < 0 || it->second >= newIndexes.size() || newIndexes[it->second] < 0)
+        {
+            dropped.push_back(it->first);
+            it = dictionary.erase(it);
+        }
+        else
+        {
+            it->second = newIndexes[it->second];
+            ++it;
+        }
+    }
+}
+bool LibDictionary::Defines(const std::vector<ObjString>& names) const
+{
+    for (auto&& name : names)
+        if (dictionary.find(name) == dictionary.end())
+            return false;
+    return true;
+}
 void LibDictionary::InsertInDictionary(const char* name, int index)
 {
     char buf[2048];
@@ -84,7 +112,10 @@ void LibDictionary::InsertInDictionary(const char* name, int index)
     std::string id = buf;
     if (!caseSensitive)
         id = UTF8::ToUpper(id);
-    dictionary[id] = index;
+    // when several modules define a name the last one wins, whatever order modules are added in
+    auto it = dictionary.find(id);
+    if (it == dictionary.end() || it->second <= index)
+        dictionary[id] = index;
 }
 bool LibDictionary::Write(FILE* stream)
 {
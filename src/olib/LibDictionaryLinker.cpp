@@ -53,43 +53,48 @@ ObjInt DictCompare::casecmp(const std::string& str1, const std::string& str2, in
 ObjInt LibDictionary::Lookup(FILE* stream, ObjInt dictionaryOffset, ObjInt dictionarySize, const ObjString& name)
 {
     if (dictionary.empty())
-    {
-        if (fseek(stream, 0, SEEK_END))
-            return -1;
-        int end = ftell(stream);
-        int size = end - dictionaryOffset;
-        std::unique_ptr<ObjByte[]> buf = std::make_unique<ObjByte[]>(size);
-        ObjByte* q = buf.get();
-        if (fseek(stream, dictionaryOffset, SEEK_SET))
-            return -1;
-        if (fread(q, size, 1, stream) != 1)
+        if (!Load(stream, dictionaryOffset))
             return -1;
-        // attempt to shut up coverity
-        if (feof(stream))
-            return -1;
-        char sig[4] = {'1', '0', 0, 0};
-        if (!memcmp(sig, q, 4))
-        {
-            int len;
-            q += 4;
-            len = *(short*)q;
-            while (len)
-            {
-                q += 2;
-                int fileNum = *(int*)(q + len);
-                q[len] = 0;
-                dictionary[(char*)q] = fileNum;
-                q += len + 4;
-                len = *(short*)q;
-            }
-        }
-        else
-        {
-            std::cout << "Old format library detected, please rebuild libraries" << std::endl;
-        }
-    }
     auto it = dictionary.find(name);
     if (it != dictionary.end())
         return it->second;
     return -1;
 }
+bool LibDictionary::Load(FILE* stream, ObjInt dictionaryOffset)
+{
+    if (fseek(stream, 0, SEEK_END))
+        return false;
+    int end = ftell(stream);
+    int size = end - dictionaryOffset;
+    std::unique_ptr<ObjByte[]> buf = std::make_unique<ObjByte[]>(size);
+    ObjByte* q = buf.get();
+    if (fseek(stream, dictionaryOffset, SEEK_SET))
+        return false;
+    if (fread(q, size, 1, stream) != 1)
+        return false;
+    // attempt to shut up coverity
+    if (feof(stream))
+        return false;
+    char sig[4] = {'1', '0', 0, 0};
+    if (!memcmp(sig, q, 4))
+    {
+        int len;
+        q += 4;
+        len = *(short*)q;
+        while (len)
+        {
+            q += 2;
+            int fileNum = *(int*)(q + len);
+            q[len] = 0;
+            dictionary[(char*)q] = fileNum;
+            q += len + 4;
+            len = *(short*)q;
+        }
+    }
+    else
+    {
+        std::cout << "Old format library detected, please rebuild libraries" << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -28,6 +28,7 @@
 #include <deque>
 #include <cstdio>
 #include <memory>
+#include <vector>
 class ObjFile;
 class ObjFactory;
 class LibFiles
@@ -40,6 +41,7 @@ class LibFiles
         ~FileDescriptor();
         ObjString name;
         ObjInt offset;
+        ObjInt index;  // position in the library this was loaded from, or -1
         ObjFile* data;
     };
     LibFiles(bool CaseSensitive = true, bool noexport = false) : caseSensitive(CaseSensitive), noExport(noexport) {}
@@ -57,8 +59,8 @@ class LibFiles
     bool WriteNames(FILE* stream);
     bool ReadOffsets(FILE* stream, int count);
     bool WriteOffsets(FILE* stream);
-    bool ReadFiles(FILE* stream, ObjFactory* factory);
-    bool WriteFiles(FILE* stream, ObjInt align);
+    bool ReadFiles(const ObjString& libName, std::vector<ObjFactory*>& factories, bool changedOnly = false);
+    bool WriteFiles(FILE* stream, ObjInt align, FILE* library = nullptr);
 
     ObjFile* LoadModule(FILE* stream, ObjInt FileIndex, ObjFactory* factory);
 
@@ -69,6 +71,7 @@ class LibFiles
   protected:
     ObjFile* ReadData(FILE* stream, const ObjString& name, ObjFactory* factory);
     bool WriteData(FILE* stream, ObjFile* file, const ObjString& name);
+    bool CopyData(FILE* stream, FILE* library, ObjInt offset);
     bool Align(FILE* stream, ObjInt align);
 
   private:
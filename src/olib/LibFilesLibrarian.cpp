@@ -30,6 +30,11 @@
 #include "CmdFiles.h"
 #include <iostream>
 #include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <set>
+#include <thread>
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
 #else
@@ -88,7 +93,7 @@ void LibFiles::Extract(FILE* stream, const ObjString& Name)
         internalName = Name.substr(npos + 1);
     int count = 0;
     ObjIeeeIndexManager im1;
-    ObjFactory fact1(&im1);
+    ObjFactory fact1(&im1, true);
     for (auto it = FileBegin(); it != FileEnd(); ++it)
     {
         if ((*it)->name == internalName)
@@ -172,10 +177,34 @@ void LibFiles::Replace(const ObjString& Name)
 bool LibFiles::WriteData(FILE* stream, ObjFile* file, const ObjString& name)
 {
     ObjIeeeIndexManager im1;
-    ObjFactory fact1(&im1);
+    ObjFactory fact1(&im1, true);
     ObjIeee ieee(name.c_str());
     return ieee.Write(stream, file, &fact1);
 }
+// copies a module from the library being rebuilt without parsing it.  A module is a run of
+// records, each a command byte and a two byte big endian length that counts the whole record,
+// and it ends with the module end record.  Nothing in a module depends on where it sits in
+// the library
+bool LibFiles::CopyData(FILE* stream, FILE* library, ObjInt offset)
+{
+    if (fseek(library, offset, SEEK_SET))
+        return false;
+    std::vector<ObjByte> buf(0x10000);
+    while (true)
+    {
+        if (fread(buf.data(), 3, 1, library) != 1)
+            return false;
+        int len = (buf[1] << 8) + buf[2];
+        if (len < 3)
+            return false;
+        if (len > 3 && fread(buf.data() + 3, len - 3, 1, library) != 1)
+            return false;
+        if (fwrite(buf.data(), len, 1, stream) != 1)
+            return false;
+        if (buf[0] == ecME)
+            return true;
+    }
+}
 bool LibFiles::WriteNames(FILE* stream)
 {
     for (auto it = FileBegin(); it != FileEnd(); ++it)
@@ -216,78 +245,120 @@ bool LibFiles::Align(FILE* stream, int align)
             return false;
     return true;
 }
-bool LibFiles::ReadFiles(FILE* stream, ObjFactory* factory)
+// modules are parsed on a pool of threads, each with its own object factory and its own
+// handle on the library.   With changedOnly set, members that are already in the library
+// and haven't been replaced are left unparsed.
+bool LibFiles::ReadFiles(const ObjString& libName, std::vector<ObjFactory*>& factories, bool changedOnly)
 {
-    bool rv = true;
-    bool done = false;
-    while (!done)
+    enum
     {
-        done = true;
-        for (auto it = FileBegin(); it != FileEnd();)
+        READ_OK,
+        READ_SYNTAX,
+        READ_MISSING
+    };
+    std::vector<FileDescriptor*> work;
+    for (auto it = FileBegin(); it != FileEnd(); ++it)
+        if (!(*it)->data && (!changedOnly || !(*it)->offset))
+            work.push_back((*it).get());
+    std::vector<int> status(work.size(), READ_OK);
+    std::vector<std::exception_ptr> exceptions(factories.size());
+    std::atomic<size_t> next(0);
+    auto reader = [&](int n) {
+        FILE* lib = nullptr;
+        try
         {
-            auto itn = it;
-            ++it;
-            if (!(*itn)->data)
+            for (size_t i; (i = next++) < work.size();)
             {
-                if ((*itn)->offset)
+                FileDescriptor* fd = work[i];
+                if (fd->offset)
                 {
-                    if (fseek(stream, (*itn)->offset, SEEK_SET))
-                        return false;
-                    (*itn)->data = ReadData(stream, (*itn)->name, factory);
-                    if (!(*itn)->data)
-                    {
-                        std::cout << "Error: Syntax error in module '" << (*itn)->name << "'" << std::endl;
-                        files.erase(itn);
-                        done = false;
-                        rv = false;
-                        break;
-                    }
+                    if (!lib)
+                        lib = fopen(libName.c_str(), "rb");
+                    if (lib && !fseek(lib, fd->offset, SEEK_SET))
+                        fd->data = ReadData(lib, fd->name, factories[n]);
+                    if (!fd->data)
+                        status[i] = READ_SYNTAX;
                     // leaving export records alone if they were added previosly without --noexport
                 }
                 else
                 {
-                    FILE* istr = fopen((*itn)->name.c_str(), "rb");
+                    FILE* istr = fopen(fd->name.c_str(), "rb");
                     if (istr != nullptr)
                     {
-                        (*itn)->data = ReadData(istr, (*itn)->name, factory);
+                        fd->data = ReadData(istr, fd->name, factories[n]);
                         fclose(istr);
-                        if (!(*itn)->data)
-                        {
-                            std::cout << "Error: Syntax error in module '" << (*itn)->name << "'" << std::endl;
-                            files.erase(itn);
-                            done = false;
-                            rv = false;
-                            break;
-                        }
+                        if (!fd->data)
+                            status[i] = READ_SYNTAX;
                         else if (noExport)
-                        {
-                            (*itn)->data->ExportClear();
-                        }
+                            fd->data->ExportClear();
                     }
                     else
                     {
-                        std::cout << "Error: Module '" << (*itn)->name << "' does not exist" << std::endl;
-                        files.erase(itn);
-                        done = false;
-                        rv = false;
-                        break;
+                        status[i] = READ_MISSING;
                     }
                 }
             }
         }
+        catch (...)
+        {
+            exceptions[n] = std::current_exception();
+            next = work.size();
+        }
+        if (lib)
+            fclose(lib);
+    };
+    int jobs = std::min(factories.size(), work.size());
+    std::vector<std::thread> threads;
+    for (int i = 1; i < jobs; i++)
+        threads.push_back(std::thread(reader, i));
+    if (jobs)
+        reader(0);
+    for (auto&& t : threads)
+        t.join();
+    for (auto&& e : exceptions)
+        if (e)
+            std::rethrow_exception(e);
+    bool rv = true;
+    std::set<FileDescriptor*> failed;
+    for (size_t i = 0; i < work.size(); i++)
+    {
+        if (status[i] == READ_OK)
+            continue;
+        if (status[i] == READ_SYNTAX)
+            std::cout << "Error: Syntax error in module '" << work[i]->name << "'" << std::endl;
+        else
+            std::cout << "Error: Module '" << work[i]->name << "' does not exist" << std::endl;
+        failed.insert(work[i]);
+        rv = false;
     }
+    if (!rv)
+        files.erase(std::remove_if(files.begin(), files.end(),
+                                   [&failed](std::unique_ptr<FileDescriptor>& fd) { return failed.count(fd.get()) != 0; }),
+                    files.end());
     return rv;
 }
-bool LibFiles::WriteFiles(FILE* stream, ObjInt align)
+// with a library to copy from, members that came from it are copied across as they are.
+// Without one, members that weren't read are being kept where they are in an updated library
+bool LibFiles::WriteFiles(FILE* stream, ObjInt align, FILE* library)
 {
-    int i = 0;
     for (auto it = FileBegin(); it != FileEnd(); ++it)
     {
+        bool copy = library && (*it)->offset;
+        if (!copy && !(*it)->data)
+            continue;
         if (!Align(stream, align))
             return false;
+        ObjInt offset = (*it)->offset;
         (*it)->offset = ftell(stream);
-        if (!WriteData(stream, (*it)->data, (*it)->name))
+        if (copy)
+        {
+            if (!CopyData(stream, library, offset))
+                return false;
+        }
+        else if (!WriteData(stream, (*it)->data, (*it)->name))
+        {
             return false;
+        }
     }
     return true;
 }
@@ -53,6 +53,7 @@ bool LibFiles::ReadNames(FILE* stream, int count)
         } while (c != 0);
         ObjString name = buf;
         files.push_back(std::make_unique<FileDescriptor>(name));
+        files.back()->index = i;
     }
     return true;
 }
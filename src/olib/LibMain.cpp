@@ -57,15 +57,21 @@ CmdSwitchBool LibMain::caseSensitiveSwitch(SwitchParser, 'c', true);
 CmdSwitchOutput LibMain::OutputFile(SwitchParser, 'o', ".a");
 CmdSwitchFile LibMain::File(SwitchParser, '@');
 CmdSwitchBool LibMain::noExport(SwitchParser, 0, false, {"noexports"});
+CmdSwitchBool LibMain::update(SwitchParser, 'u', false, {"update"});
+CmdSwitchBool LibMain::compact(SwitchParser, 0, false, {"compact"});
+CmdSwitchInt LibMain::jobs(SwitchParser, 'j', 0, 1, 256);
 const char* LibMain::usageText =
     "[options] libfile [+ files] [- files] [* files]\n"
     "\n"
     "/c-            Case insensitive library\n"
+    "/jn            Parse modules with n threads\n"
     "/oxxx          Set output file name\n"
+    "/u, --update   Update library in place\n"
     "/V, --version  Show version and date\n"
     "/!, --nologo   No logo\n"
     "@xxx           Read commands from file\n"
     "\n"
+    "--compact      Rebuild library, reclaiming space left by updates\n"
     "--noexports    Remove export records\n"
     "\n"
     "Time: " __TIME__ "  Date: " __DATE__;
@@ -147,7 +153,7 @@ int LibMain::Run(int argc, char** argv)
         Utils::usage(argv[0], usageText);
     }
     int fileCount = argc - 1 + File.GetCount() + !!OutputFile.GetValue().size();
-    if (fileCount < 2)
+    if (fileCount < (compact.GetValue() ? 1 : 2))
     {
         Utils::usage(argv[0], usageText);
     }
@@ -180,6 +186,7 @@ int LibMain::Run(int argc, char** argv)
     }
 
     LibManager librarian(outputFile, noExport.GetValue(), caseSensitiveSwitch.GetValue());
+    librarian.SetJobs(jobs.GetValue());
     if (librarian.IsOpen())
         if (!librarian.LoadLibrary())
         {
@@ -198,8 +205,8 @@ int LibMain::Run(int argc, char** argv)
     {
         librarian.ReplaceFile((*it));
     }
-    if (modified)
-        switch (librarian.SaveLibrary())
+    if (modified || compact.GetValue())
+        switch (update.GetValue() && !compact.GetValue() ? librarian.UpdateLibrary() : librarian.SaveLibrary())
         {
             case LibManager::CANNOT_CREATE:
                 std::cout << "Cannot open library file for 'write' access" << std::endl;
@@ -58,6 +58,9 @@ class LibMain
     static CmdSwitchOutput OutputFile;
     static CmdSwitchFile File;
     static CmdSwitchBool noExport;
+    static CmdSwitchBool update;
+    static CmdSwitchBool compact;
+    static CmdSwitchInt jobs;
 
     static const char* usageText;
 };
@@ -47,7 +47,7 @@ class LibManager
         SUCCESS = 0
     };
     LibManager(const ObjString& Name, bool noexport, bool CaseSensitive = true) :
-        dictionary(CaseSensitive), name(Name), files(CaseSensitive, noexport)
+        dictionary(CaseSensitive), name(Name), files(CaseSensitive, noexport), jobs(0)
     {
         stream = fopen(Name.c_str(), "rb");
         InitHeader();
@@ -65,12 +65,16 @@ class LibManager
     ObjFile* LoadModule(ObjInt index, ObjFactory* factory) { return files.LoadModule(stream, index, factory); }
     bool LoadLibrary();
     int SaveLibrary();
+    int UpdateLibrary();
+    // number of threads used to parse modules, zero for one per processor
+    void SetJobs(int Jobs) { jobs = Jobs; }
     bool fail() const { return false; }  // stream.fail(); }
     bool IsOpen() const { return stream != nullptr; }
     void Close()
     {
         if (stream)
             fclose(stream);
+        stream = nullptr;
     }
     enum
     {
@@ -94,6 +98,9 @@ class LibManager
 
   protected:
     bool Align(FILE* ostr, ObjInt align = ALIGN);
+    int RebuildLibrary();
+    bool UpdateDictionary(std::vector<ObjFactory*>& factories, bool& complete);
+    int WriteTables(FILE* ostr);
     void InitHeader();
     bool WriteHeader()
     {
@@ -118,5 +125,6 @@ class LibManager
     LibFiles files;
     LibDictionary dictionary;
     ObjString name;
+    int jobs;
 };
 #endif
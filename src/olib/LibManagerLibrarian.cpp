@@ -25,19 +25,48 @@
 #include "LibManager.h"
 #include "ObjIeee.h"
 #include "ObjFactory.h"
+#include "Utils.h"
 #include <cstring>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// object factories for the threads that parse modules.  The factories own what is read, so
+// they have to stay around until the library is written
+class LibReaders
+{
+  public:
+    LibReaders(int jobs)
+    {
+        if (jobs <= 0)
+            jobs = std::max(1u, std::thread::hardware_concurrency());
+        for (int i = 0; i < jobs; i++)
+        {
+            indexManagers.push_back(std::make_unique<ObjIeeeIndexManager>());
+            factories.push_back(std::make_unique<ObjFactory>(indexManagers.back().get(), true));
+            list.push_back(factories.back().get());
+        }
+    }
+    std::vector<ObjFactory*>& Factories() { return list; }
+
+  private:
+    std::vector<std::unique_ptr<ObjIeeeIndexManager>> indexManagers;
+    std::vector<std::unique_ptr<ObjFactory>> factories;
+    std::vector<ObjFactory*> list;
+};
 
 int LibManager::SaveLibrary()
 {
+    if (stream && header.sig == LibHeader::LIB_SIG)
+        return RebuildLibrary();
     InitHeader();
-    ObjIeeeIndexManager im1;
-    ObjFactory fact1(&im1);
-    if (!files.ReadFiles(stream, &fact1))
+    LibReaders readers(jobs);
+    if (!files.ReadFiles(name, readers.Factories()))
         return CANNOT_READ;
     dictionary.CreateDictionary(files);
     // can't do more reading
     Close();
-    header.filesInModule = files.size();
     FILE* ostr = fopen(name.c_str(), "wb");
     if (!ostr)
     {
@@ -48,62 +77,152 @@ int LibManager::SaveLibrary()
         fclose(ostr);
         return CANNOT_WRITE;
     }
-    if (!Align(ostr, 16))
+    if (!files.WriteFiles(ostr, ALIGN))
     {
         fclose(ostr);
         return CANNOT_WRITE;
     }
-    header.namesOffset = ftell(ostr);
-    if (!files.WriteNames(ostr))
+    int rv = WriteTables(ostr);
+    fclose(ostr);
+    return rv;
+}
+// the dictionary of the existing library has been loaded.  Reads the new and replaced modules
+// and adds their names to it.  The names of removed and replaced modules drop out of it first;
+// a new module usually defines them again, and since the dictionary keeps the last definition
+// of a name that one is right.  If a dropped name isn't defined again some other module may
+// still define it, then complete is false and the caller has to build the dictionary from every
+// module.  Returns false if a module can't be read
+bool LibManager::UpdateDictionary(std::vector<ObjFactory*>& factories, bool& complete)
+{
+    std::vector<int> newIndexes(header.filesInModule, -1);
+    int i = 0;
+    for (auto it = files.FileBegin(); it != files.FileEnd(); ++it, ++i)
+        if ((*it)->index >= 0 && (*it)->offset)
+            newIndexes[(*it)->index] = i;
+    std::vector<ObjString> dropped;
+    dictionary.Renumber(newIndexes, dropped);
+    if (!files.ReadFiles(name, factories, true))
+        return false;
+    i = 0;
+    for (auto it = files.FileBegin(); it != files.FileEnd(); ++it, ++i)
+        if ((*it)->data)
+            dictionary.AddModule((*it)->data, i);
+    complete = dictionary.Defines(dropped);
+    return true;
+}
+// rewrites an existing library.  Only new modules are parsed; modules that are kept are
+// copied across from the old library as they are, and so is the dictionary unless removing
+// or replacing modules took a name out of it that no new module defines.  Then everything is
+// read and the dictionary is rebuilt.  The new library is written to a temporary file which
+// then replaces the old one
+int LibManager::RebuildLibrary()
+{
+    LibReaders readers(jobs);
+    bool complete = false;
+    if (dictionary.Load(stream, header.dictionaryOffset) && !UpdateDictionary(readers.Factories(), complete))
+        return CANNOT_READ;
+    if (!complete)
     {
-        fclose(ostr);
-        return CANNOT_WRITE;
+        if (!files.ReadFiles(name, readers.Factories()))
+            return CANNOT_READ;
+        dictionary.CreateDictionary(files);
     }
-    if (!Align(ostr))
+    InitHeader();
+    std::string tempName = name + "." + Utils::NumberToString(Utils::Random(1 << 30));
+    FILE* ostr = fopen(tempName.c_str(), "wb");
+    if (!ostr)
+    {
+        return CANNOT_CREATE;
+    }
+    int rv = SUCCESS;
+    if (fwrite(&header, sizeof(header), 1, ostr) != 1 || !files.WriteFiles(ostr, ALIGN, stream))
+        rv = CANNOT_WRITE;
+    else
+        rv = WriteTables(ostr);
+    fclose(ostr);
+    Close();
+    if (rv != SUCCESS)
+    {
+        remove(tempName.c_str());
+        return rv;
+    }
+    if (rename(tempName.c_str(), name.c_str()))
+    {
+        // rename won't replace an existing file everywhere.  If it still fails the new
+        // library is left in the temporary file
+        remove(name.c_str());
+        if (rename(tempName.c_str(), name.c_str()))
+            return CANNOT_CREATE;
+    }
+    return SUCCESS;
+}
+// replaced and added modules are appended to the existing library, followed by new copies
+// of the tables.  The space used by old versions of modules isn't reclaimed until the library
+// is rebuilt with SaveLibrary.  The header is written last, so if anything goes wrong
+// the library still describes its old contents
+int LibManager::UpdateLibrary()
+{
+    if (!stream || header.sig != LibHeader::LIB_SIG)
+        return SaveLibrary();
+    if (!dictionary.Load(stream, header.dictionaryOffset))
+        return CANNOT_READ;
+    LibReaders readers(jobs);
+    bool complete;
+    if (!UpdateDictionary(readers.Factories(), complete))
+        return CANNOT_READ;
+    // a name dropped out of the dictionary and no new module defines it.  Another module may
+    // still define it, so the dictionary has to be built again from every module
+    if (!complete)
+        return RebuildLibrary();
+    Close();
+    FILE* ostr = fopen(name.c_str(), "r+b");
+    if (!ostr)
+    {
+        return CANNOT_CREATE;
+    }
+    if (fseek(ostr, 0, SEEK_END))
     {
         fclose(ostr);
         return CANNOT_WRITE;
     }
-    header.filesOffset = ftell(ostr);
     if (!files.WriteFiles(ostr, ALIGN))
     {
         fclose(ostr);
         return CANNOT_WRITE;
     }
+    int rv = WriteTables(ostr);
+    fclose(ostr);
+    return rv;
+}
+// writes the module names, module offsets and dictionary after the modules, then the header
+int LibManager::WriteTables(FILE* ostr)
+{
+    header.filesInModule = files.size();
+    // the modules start after the header, although an update can leave unused space in front of them
+    header.filesOffset = 0;
+    for (auto it = files.FileBegin(); it != files.FileEnd(); ++it)
+        if ((*it)->offset && (!header.filesOffset || (*it)->offset < header.filesOffset))
+            header.filesOffset = (*it)->offset;
+    if (!Align(ostr))
+        return CANNOT_WRITE;
+    header.namesOffset = ftell(ostr);
+    if (!files.WriteNames(ostr))
+        return CANNOT_WRITE;
     if (!Align(ostr))
-    {
-        fclose(ostr);
         return CANNOT_WRITE;
-    }
     header.offsetsOffset = ftell(ostr);
     if (!files.WriteOffsets(ostr))
-    {
-        fclose(ostr);
         return CANNOT_WRITE;
-    }
     if (!Align(ostr))
-    {
-        fclose(ostr);
         return CANNOT_WRITE;
-    }
     header.dictionaryOffset = ftell(ostr);
     header.dictionaryBlocks = 0;
     if (!dictionary.Write(ostr))
-    {
-        fclose(ostr);
         return CANNOT_WRITE;
-    }
     if (fseek(ostr, 0, SEEK_SET))
-    {
-        fclose(ostr);
         return CANNOT_WRITE;
-    }
     if (fwrite(&header, sizeof(header), 1, ostr) != 1)
-    {
-        fclose(ostr);
         return CANNOT_WRITE;
-    }
-    fclose(ostr);
     return SUCCESS;
 }
 bool LibManager::Align(FILE* ostr, ObjInt align)
@@ -41,6 +41,7 @@
 #include <cctype>
 #include <iostream>
 #include <algorithm>
+#include <thread>
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
 #endif
@@ -53,7 +54,11 @@ static int version_ok;
 // speed things up for individual tables, but when you are writing as database the
 // disk writes are the limiting factor.  Nonetheless I remain with the virtual table
 // approach because the codelooks much prettier...
-const char* LinkDebugFile::pragmas = {"PRAGMA journal_mode=MEMORY; PRAGMA temp_store=MEMORY;"};
+// The database is always created from scratch and thrown away if the link fails, so
+// there is no point in syncing to disk after each table or letting anyone else in.
+const char* LinkDebugFile::pragmas = {
+    "PRAGMA journal_mode=MEMORY; PRAGMA temp_store=MEMORY; PRAGMA synchronous=OFF; "
+    "PRAGMA locking_mode=EXCLUSIVE; PRAGMA cache_size=-65536;"};
 const char* LinkDebugFile::tables = {
     "BEGIN; "
     "CREATE TABLE dbPropertyBag ("
@@ -238,11 +243,9 @@ bool LinkDebugFile::WriteFileNames()
     v.clear();
     return true;
 }
-bool LinkDebugFile::WriteLineNumbers()
+void LinkDebugFile::GatherLineNumbers(ObjSection** begin, ObjSection** end, std::vector<LineRow>& rows)
 {
-    std::vector<sqlite3_int64> v;
-    //    std::vector<sqlite3_int64> a;
-    for (auto it = file->SectionBegin(); it != file->SectionEnd(); ++it)
+    for (auto it = begin; it != end; ++it)
     {
         ObjMemoryManager& m = (*it)->GetMemoryManager();
         ObjInt address = m.GetBase();
@@ -251,41 +254,61 @@ bool LinkDebugFile::WriteLineNumbers()
             if ((*it1)->HasDebugTags())
             {
                 ObjLineNo* ln = nullptr;
-                // full list of line numbers needed for symbol data...
                 for (auto it2 = (*it1)->DebugTagBegin(); it2 != (*it1)->DebugTagEnd(); ++it2)
                 {
                     ObjLineNo* ln2 = (*it2)->GetLineNo();
                     if (ln2)
-                    {
-                        //                        int line = ln2->GetLineNumber();
-                        //                        int fileId = ln2->GetFile()->GetIndex();
-                        //                        a.push_back(address);
-                        //                        a.push_back(fileId);
-                        //                        a.push_back(line);
                         ln = ln2;
-                    }
                 }
                 // pick the last line number in the list for this address...
                 if (ln)
-                {
-                    int line = ln->GetLineNumber();
-                    int fileId = ln->GetFile()->GetIndex();
-                    v.push_back(address);
-                    v.push_back(fileId);
-                    v.push_back(line);
-                }
+                    rows.push_back({address, ln->GetFile()->GetIndex(), ln->GetLineNumber()});
             }
             address += (*it1)->GetSize();
         }
     }
+}
+void LinkDebugFile::StartLineNumbers(std::vector<std::vector<LineRow>>& rows, std::vector<std::thread>& threads)
+{
+    // the line numbers only depend on the section contents, so each thread
+    // walks its own run of sections into its own row list.
+    int count = file->SectionEnd() - file->SectionBegin();
+    int n = std::thread::hardware_concurrency();
+    if (n > count)
+        n = count;
+    if (n < 1)
+        n = 1;
+    rows.resize(n);
+    ObjSection** base = count ? &*file->SectionBegin() : nullptr;
+    for (int i = 0; i < n; i++)
+    {
+        ObjSection** begin = base + count * i / n;
+        ObjSection** end = base + count * (i + 1) / n;
+        std::vector<LineRow>* list = &rows[i];
+        threads.push_back(std::thread([begin, end, list]() { GatherLineNumbers(begin, end, *list); }));
+    }
+}
+bool LinkDebugFile::WriteLineNumbers(std::vector<std::vector<LineRow>>& rows)
+{
+    std::vector<LineRow> all;
+    for (auto&& list : rows)
+        all.insert(all.end(), list.begin(), list.end());
+    rows.clear();
+    // the address is the primary key, loading in key order keeps sqlite appending to the tree
+    std::stable_sort(all.begin(), all.end(), [](const LineRow& left, const LineRow& right) { return left.address < right.address; });
+    std::vector<sqlite3_int64> v;
+    v.reserve(all.size() * 3);
+    for (auto&& row : all)
+    {
+        v.push_back(row.address);
+        v.push_back(row.fileId);
+        v.push_back(row.line);
+    }
+    all.clear();
     IntegerColumnsVirtualTable lines(v, 3);
     lines.Start(dbPointer);
     lines.InsertIntoFrom("linenumbers");
     lines.Stop();
-    //    IntegerColumnsVirtualTable linesfull(a, 3);
-    //    linesfull.Start(dbPointer);
-    //    linesfull.InsertIntoFrom("linenumbersfull");
-    //    linesfull.Stop();
     return true;
 }
 void LinkDebugFile::PushCPPName(const ObjString& name, int n)
@@ -684,9 +707,15 @@ class context
     ObjLineNo* currentLine;
     std::map<ObjSymbol*, ObjLineNo*> vars;
 };
-bool LinkDebugFile::WriteAutosTable()
+template <class T>
+static int LookupId(const std::map<T, int>& map, const T& key)
 {
-    std::vector<sqlite3_int64> v;
+    auto it = map.find(key);
+    return it == map.end() ? 0 : it->second;
+}
+void LinkDebugFile::GatherAutos(std::vector<sqlite3_int64>& v)
+{
+    // runs on a worker thread while other tables are written, so the maps are only read
     std::deque<std::unique_ptr<context>> contexts;
     std::unique_ptr<context> currentContext;
     int funcId = 0;
@@ -706,7 +735,10 @@ bool LinkDebugFile::WriteAutosTable()
                     switch ((*it2)->GetType())
                     {
                         case ObjDebugTag::eLineNo:
-                            if ((*it2)->GetLineNo() > currentLine)  // e.g. for statements can have their first statement last
+                            // e.g. for statements can have their first statement last
+                            // line numbers only order lines within one file, so stay with the file we started in
+                            if (!currentLine || ((*it2)->GetLineNo()->GetFile() == currentLine->GetFile() &&
+                                                 (*it2)->GetLineNo()->GetLineNumber() > currentLine->GetLineNumber()))
                                 currentLine = (*it2)->GetLineNo();
                             break;
                         default:
@@ -726,7 +758,7 @@ bool LinkDebugFile::WriteAutosTable()
                             break;
                         case ObjDebugTag::eVirtualFunctionStart: {
                             ObjSection* func = (*it2)->GetSection();
-                            funcId = sectionMap[func->GetName()];
+                            funcId = LookupId(sectionMap, func->GetName());
                         }
                             // fall through
                         case ObjDebugTag::eFunctionStart:
@@ -735,11 +767,11 @@ bool LinkDebugFile::WriteAutosTable()
                                 ObjSymbol* func = (*it2)->GetSymbol();
                                 if (func->GetType() == ObjSymbol::ePublic)
                                 {
-                                    funcId = publicMap[func->GetIndex()];
+                                    funcId = LookupId(publicMap, func->GetIndex());
                                 }
                                 else
                                 {
-                                    funcId = localMap[func->GetIndex()];
+                                    funcId = LookupId(localMap, func->GetIndex());
                                 }
                             }
                             // fallthrough
@@ -760,7 +792,7 @@ bool LinkDebugFile::WriteAutosTable()
                             {
                                 ObjSymbol* s = obj.first;
                                 int startLine = obj.second->GetLineNumber();
-                                v.push_back(autoMap[s->GetIndex()]);
+                                v.push_back(LookupId(autoMap, s->GetIndex()));
                                 v.push_back(GetTypeIndex(s->GetBaseType()));
                                 v.push_back(funcId);
                                 v.push_back(fileId);
@@ -782,12 +814,14 @@ bool LinkDebugFile::WriteAutosTable()
             address += (*it1)->GetSize();
         }
     }
+    contexts.clear();
+}
+bool LinkDebugFile::WriteAutosTable(std::vector<sqlite3_int64>& v)
+{
     IntegerColumnsVirtualTable autos(v, 7);
     autos.Start(dbPointer);
     autos.InsertIntoFrom("autos");
     autos.Stop();
-    contexts.clear();
-
     return true;
 }
 bool LinkDebugFile::WriteTypeNamesTable()
@@ -815,18 +849,33 @@ bool LinkDebugFile::CreateOutput()
     if (ok)
     {
         ok = false;
-        //        Begin();
+        // the row lists for the line numbers and autos are built on worker threads while
+        // the tables that hand out name ids are written; only this thread talks to sqlite.
+        std::vector<std::vector<LineRow>> lines;
+        std::vector<std::thread> threads;
+        std::vector<sqlite3_int64> autos;
+        StartLineNumbers(lines, threads);
         if (WriteFileNames())
-            if (WriteLineNumbers())
-                if (WriteVariableTypes())
-                    if (WriteVariableNames())
-                        if (WriteGlobalsTable())
-                            if (WriteAutosTable())
-                                if (WriteTypeNamesTable())
-                                    if (WriteNamesTable())
-                                        if (CreateIndexes())
-                                            ok = true;
-        //        End();
+            if (WriteVariableTypes())
+                if (WriteVariableNames())
+                    if (WriteGlobalsTable())
+                    {
+                        threads.push_back(std::thread([this, &autos]() { GatherAutos(autos); }));
+                        ok = true;
+                    }
+        if (ok)
+            ok = WriteTypeNamesTable();
+        for (auto&& t : threads)
+            t.join();
+        if (ok)
+        {
+            ok = false;
+            if (WriteLineNumbers(lines))
+                if (WriteAutosTable(autos))
+                    if (WriteNamesTable())
+                        if (CreateIndexes())
+                            ok = true;
+        }
     }
     if (dbPointer)
         sqlite3_close(dbPointer);
@@ -30,6 +30,7 @@
 #include <vector>
 #include "sqlvt.h"
 #include <deque>
+#include <thread>
 class ObjFile;
 class ObjField;
 
@@ -51,8 +52,16 @@ class LinkDebugFile
     bool CreateTables(void);
     bool CreateIndexes(void);
     bool DBOpen(char* name);
+    struct LineRow
+    {
+        ObjInt address;
+        int fileId;
+        int line;
+    };
     bool WriteFileNames();
-    bool WriteLineNumbers();
+    static void GatherLineNumbers(ObjSection** begin, ObjSection** end, std::vector<LineRow>& rows);
+    void StartLineNumbers(std::vector<std::vector<LineRow>>& rows, std::vector<std::thread>& threads);
+    bool WriteLineNumbers(std::vector<std::vector<LineRow>>& rows);
     void PushCPPName(const ObjString& name, int n);
     int GetSQLNameId(const ObjString& name);
     bool WriteNamesTable();
@@ -61,7 +70,8 @@ class LinkDebugFile
     ObjInt GetSectionBase(ObjExpression* e);
     bool WriteGlobalsTable();
     bool WriteVirtualsTable();
-    bool WriteAutosTable();
+    void GatherAutos(std::vector<sqlite3_int64>& v);
+    bool WriteAutosTable(std::vector<sqlite3_int64>& v);
     bool WriteTypeNamesTable();
     int GetTypeIndex(ObjType* Type)
     {
@@ -42,9 +42,11 @@
 #include <fstream>
 #include <cstdio>
 #include <climits>
+#include <unordered_map>
 
 int LinkManager::errors;
 int LinkManager::warnings;
+std::mutex LinkManager::errorMutex;
 
 void HookError(int aa) {}
 
@@ -59,7 +61,9 @@ LinkManager::LinkManager(ObjString Specification, bool CaseSensitive, const ObjS
     ioBase(nullptr),
     caseSensitive(CaseSensitive),
     debugPassThrough(DebugPassThrough),
-    debugFile(DebugFile)
+    debugFile(DebugFile),
+    removeUnused(false),
+    foldIdentical(false)
 {
 }
 
@@ -347,6 +351,8 @@ bool LinkManager::HasVirtual(std::string name)
         auto it = virtsections.find(&test);
         if (it != virtsections.end())
         {
+            if (removeUnused && liveVirtuals.find(name) == liveVirtuals.end())
+                return false;
             return (*it)->GetUsed();
         }
     }
@@ -398,6 +404,343 @@ bool LinkManager::ScanVirtuals()
     }
     return rv;
 }
+// sections which only matter if something refers to them.   Anything else, e.g. the startup and rundown
+// tables, is kept
+static bool Collectable(ObjSection* sect)
+{
+    static const char* names[] = {"code", "const", "data", "bss", "string"};
+    for (auto name : names)
+        if (sect->GetName() == name)
+            return true;
+    return false;
+}
+static ObjString VirtualName(const ObjString& sectionName)
+{
+    size_t n = sectionName.find('@');
+    if (n == std::string::npos)
+        return "";
+    return sectionName.substr(n);
+}
+void LinkManager::MarkVirtual(const ObjString& name, std::deque<ObjSection*>& pending)
+{
+    auto it = virtualCopies.find(name);
+    if (it != virtualCopies.end() && liveVirtuals.insert(name).second)
+    {
+        // the copy which gets used isn't chosen until the sections are placed, so keep whatever any of them uses
+        for (auto sect : it->second)
+            pending.push_back(sect);
+    }
+}
+void LinkManager::MarkSection(ObjSection* sect, std::deque<ObjSection*>& pending)
+{
+    if (sect->GetQuals() & ObjSection::virt)
+        MarkVirtual(VirtualName(sect->GetName()), pending);
+    else if (liveSections.insert(sect).second)
+        pending.push_back(sect);
+}
+void LinkManager::MarkName(const ObjString& name, std::deque<ObjSection*>& pending)
+{
+    ObjSymbol sym(name, ObjSymbol::ePublic, -1);
+    LinkSymbolData test(&sym);
+    auto it = publics.find(&test);
+    if (it != publics.end())
+    {
+        if ((*it)->GetSymbol()->GetOffset())
+            MarkExpression((*it)->GetSymbol()->GetOffset(), pending);
+    }
+    else if (virtsections.find(&test) != virtsections.end())
+    {
+        MarkVirtual(name, pending);
+    }
+    else
+    {
+        ObjString virtualName = VirtualName(name);
+        if (!virtualName.empty())
+            MarkVirtual(virtualName, pending);
+    }
+}
+void LinkManager::MarkExpression(ObjExpression* exp, std::deque<ObjSection*>& pending)
+{
+    switch (exp->GetOperator())
+    {
+        case ObjExpression::eSection:
+            MarkSection(exp->GetSection(), pending);
+            break;
+        case ObjExpression::eSymbol:
+            if (exp->GetSymbol()->GetType() == ObjSymbol::eExternal)
+                MarkName(exp->GetSymbol()->GetName(), pending);
+            else if (exp->GetSymbol()->GetOffset())
+                MarkExpression(exp->GetSymbol()->GetOffset(), pending);
+            break;
+        default:
+            if (exp->GetLeft())
+                MarkExpression(exp->GetLeft(), pending);
+            if (exp->GetRight())
+                MarkExpression(exp->GetRight(), pending);
+            break;
+    }
+}
+// walk the references from the sections that have to be kept, the start address and the exports.
+// Code and data sections that can't be reached that way are left out of the image, as are virtual sections.
+void LinkManager::RemoveUnusedSections()
+{
+    std::deque<ObjSection*> pending;
+    for (auto file : fileData)
+    {
+        for (auto it = file->SectionBegin(); it != file->SectionEnd(); ++it)
+        {
+            if ((*it)->GetQuals() & ObjSection::virt)
+                virtualCopies[VirtualName((*it)->GetName())].push_back(*it);
+            else if (!Collectable(*it))
+                MarkSection(*it, pending);
+        }
+    }
+    if (ioBase->GetStartAddress())
+        MarkExpression(ioBase->GetStartAddress(), pending);
+    for (auto exp : exports)
+        MarkName(exp->GetSymbol()->GetName(), pending);
+    while (!pending.empty())
+    {
+        ObjSection* sect = pending.front();
+        pending.pop_front();
+        ObjMemoryManager& memManager = sect->GetMemoryManager();
+        for (auto it = memManager.MemoryBegin(); it != memManager.MemoryEnd(); ++it)
+            if ((*it)->GetFixup())
+                MarkExpression((*it)->GetFixup(), pending);
+    }
+    for (auto file : fileData)
+        for (auto it = file->SectionBegin(); it != file->SectionEnd(); ++it)
+            if (!((*it)->GetQuals() & ObjSection::virt) && liveSections.find(*it) == liveSections.end())
+                discarded.insert(*it);
+    for (auto it = publics.begin(); it != publics.end();)
+    {
+        if (IsDiscarded((*it)->GetSymbol()))
+        {
+            delete (*it);
+            publics.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+bool LinkManager::IsDiscarded(ObjSymbol* sym)
+{
+    if (discarded.empty() || !sym->GetOffset())
+        return false;
+    for (ObjExpression* exp = sym->GetOffset(); exp;)
+    {
+        if (exp->GetOperator() == ObjExpression::eSection)
+            return IsDiscarded(exp->GetSection());
+        if (exp->GetOperator() == ObjExpression::eSymbol)
+            return false;
+        exp = exp->GetLeft() ? exp->GetLeft() : exp->GetRight();
+    }
+    return false;
+}
+ObjString LinkManager::FoldedName(ObjString name)
+{
+    for (auto it = foldedVirtuals.find(name); it != foldedVirtuals.end(); it = foldedVirtuals.find(name))
+        name = it->second;
+    return name;
+}
+ObjSection* LinkManager::FoldedVirtual(const ObjString& sectionName)
+{
+    if (foldedVirtuals.empty())
+        return nullptr;
+    ObjString name = VirtualName(sectionName);
+    if (foldedVirtuals.find(name) == foldedVirtuals.end())
+        return nullptr;
+    ObjSymbol sym(FoldedName(name), ObjSymbol::ePublic, -1);
+    LinkSymbolData test(&sym);
+    auto it = virtsections.find(&test);
+    if (it == virtsections.end())
+        return nullptr;
+    // this is the copy LinkRegion::ArrangeOverlayed places, it takes the largest and the first one of that size the same way
+    return (ObjSection*)(*it)->GetAuxData();
+}
+// describe what a fixup refers to in a way that doesn't depend on which of two identical sections it is in
+void LinkManager::FixupContents(ObjExpression* exp, const ObjString& self, std::string& contents)
+{
+    switch (exp->GetOperator())
+    {
+        case ObjExpression::eValue:
+            contents += "v" + std::to_string(exp->GetValue()) + ";";
+            break;
+        case ObjExpression::ePC:
+            contents += "p;";
+            break;
+        case ObjExpression::eSection: {
+            ObjSection* sect = exp->GetSection();
+            if (sect->GetQuals() & ObjSection::virt)
+            {
+                ObjString name = FoldedName(VirtualName(sect->GetName()));
+                contents += name == self ? ObjString(".;") : "s" + name + ";";
+            }
+            else
+            {
+                contents += "S" + std::to_string((size_t)sect) + ";";
+            }
+            break;
+        }
+        case ObjExpression::eSymbol: {
+            ObjSymbol* sym = exp->GetSymbol();
+            if (sym->GetType() == ObjSymbol::eExternal)
+            {
+                ObjSymbol test(sym->GetName(), ObjSymbol::ePublic, -1);
+                LinkSymbolData data(&test);
+                if (virtsections.find(&data) != virtsections.end())
+                {
+                    ObjString name = FoldedName(sym->GetName());
+                    contents += name == self ? ObjString(".;") : "s" + name + ";";
+                }
+                else
+                {
+                    contents += "x" + sym->GetName() + ";";
+                }
+            }
+            else if (sym->GetOffset())
+            {
+                contents += "(";
+                FixupContents(sym->GetOffset(), self, contents);
+                contents += ")";
+            }
+            else
+            {
+                contents += "x" + sym->GetName() + ";";
+            }
+            break;
+        }
+        default:
+            contents += "o" + std::to_string((int)exp->GetOperator()) + "(";
+            if (exp->GetLeft())
+                FixupContents(exp->GetLeft(), self, contents);
+            contents += ")(";
+            if (exp->GetRight())
+                FixupContents(exp->GetRight(), self, contents);
+            contents += ")";
+            break;
+    }
+}
+void LinkManager::SectionContents(ObjSection* sect, std::string& contents)
+{
+    ObjString self = FoldedName(VirtualName(sect->GetName()));
+    contents = std::to_string(sect->GetAlignment()) + ";";
+    ObjMemoryManager& memManager = sect->GetMemoryManager();
+    for (auto it = memManager.MemoryBegin(); it != memManager.MemoryEnd(); ++it)
+    {
+        ObjMemory* mem = *it;
+        if (mem->GetFixup())
+        {
+            contents += "F" + std::to_string(mem->GetSize()) + ":";
+            FixupContents(mem->GetFixup(), self, contents);
+        }
+        else if (mem->IsEnumerated())
+        {
+            contents += "E" + std::to_string(mem->GetSize()) + ":" + std::to_string(mem->GetFill()) + ";";
+        }
+        else if (mem->GetData())
+        {
+            contents += "D" + std::to_string(mem->GetSize()) + ":";
+            contents.append((char*)mem->GetData(), mem->GetSize());
+        }
+    }
+}
+static bool UsesPC(ObjExpression* exp)
+{
+    if (exp->GetOperator() == ObjExpression::ePC)
+        return true;
+    return (exp->GetLeft() && UsesPC(exp->GetLeft())) || (exp->GetRight() && UsesPC(exp->GetRight()));
+}
+// collect the virtual sections a fixup refers to by address.   Calls and jumps are relative to the
+// program counter, anything else stores the address where it can be compared with another one
+void LinkManager::AddressesTaken(ObjExpression* exp, bool relative, std::set<ObjString>& names)
+{
+    switch (exp->GetOperator())
+    {
+        case ObjExpression::eSection:
+            if (!relative && (exp->GetSection()->GetQuals() & ObjSection::virt))
+                names.insert(VirtualName(exp->GetSection()->GetName()));
+            break;
+        case ObjExpression::eSymbol:
+            if (exp->GetSymbol()->GetType() == ObjSymbol::eExternal)
+            {
+                if (!relative)
+                    names.insert(exp->GetSymbol()->GetName());
+            }
+            else if (exp->GetSymbol()->GetOffset())
+            {
+                AddressesTaken(exp->GetSymbol()->GetOffset(), relative, names);
+            }
+            break;
+        default:
+            if (exp->GetLeft())
+                AddressesTaken(exp->GetLeft(), relative, names);
+            if (exp->GetRight())
+                AddressesTaken(exp->GetRight(), relative, names);
+            break;
+    }
+}
+// fold virtual code sections, e.g. template functions instantiated for types with the same representation,
+// into one copy when their code and the things their fixups refer to match.   Folding some sections can make
+// the references in others match, so this repeats until nothing changes.   Functions whose address is taken
+// are left alone, two of them have to compare unequal even if their code is the same.
+void LinkManager::FoldIdenticalCode()
+{
+    std::set<ObjString> addressTaken;
+    for (auto file : fileData)
+    {
+        for (auto it = file->SectionBegin(); it != file->SectionEnd(); ++it)
+        {
+            ObjMemoryManager& memManager = (*it)->GetMemoryManager();
+            for (auto itm = memManager.MemoryBegin(); itm != memManager.MemoryEnd(); ++itm)
+                if ((*itm)->GetFixup())
+                    AddressesTaken((*itm)->GetFixup(), UsesPC((*itm)->GetFixup()), addressTaken);
+        }
+    }
+    if (ioBase->GetStartAddress())
+        AddressesTaken(ioBase->GetStartAddress(), false, addressTaken);
+    for (auto exp : exports)
+        addressTaken.insert(exp->GetSymbol()->GetName());
+    std::vector<LinkSymbolData*> candidates;
+    for (auto v : virtsections)
+    {
+        ObjSection* sect = (ObjSection*)v->GetAuxData();
+        if (v->GetUsed() && sect && sect->GetName().compare(0, 4, "vsc@") == 0 &&
+            (!removeUnused || liveVirtuals.find(v->GetSymbol()->GetName()) != liveVirtuals.end()) &&
+            addressTaken.find(v->GetSymbol()->GetName()) == addressTaken.end())
+            candidates.push_back(v);
+    }
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        std::unordered_map<unsigned, std::vector<std::pair<LinkSymbolData*, std::string>>> found;
+        for (auto v : candidates)
+        {
+            const ObjString& name = v->GetSymbol()->GetName();
+            if (foldedVirtuals.find(name) != foldedVirtuals.end())
+                continue;
+            std::string contents;
+            SectionContents((ObjSection*)v->GetAuxData(), contents);
+            unsigned crc = LinkRemapper::crc32((unsigned char*)contents.c_str(), contents.size(), 0xffffffff);
+            auto& matches = found[crc];
+            bool folded = false;
+            for (auto& match : matches)
+            {
+                if (match.second == contents)
+                {
+                    foldedVirtuals[name] = match.first->GetSymbol()->GetName();
+                    folded = changed = true;
+                    break;
+                }
+            }
+            if (!folded)
+                matches.push_back(std::pair<LinkSymbolData*, std::string>(v, std::move(contents)));
+        }
+    }
+}
 FILE* LinkManager::GetLibraryPath(const std::string& stem, std::string& name)
 {
     FILE* infile = fopen(name.c_str(), "rb");
@@ -712,6 +1055,11 @@ void LinkManager::CreatePartitions()
     {
         for (auto its = file->SectionBegin(); its != file->SectionEnd(); ++its)
         {
+            if (IsDiscarded(*its))
+            {
+                (*its)->SetUtilityFlag(true);
+                continue;
+            }
             ObjString name = (*its)->GetName();
             auto itr = createdRegions.find(name);
             if (itr == createdRegions.end())
@@ -898,6 +1246,10 @@ void LinkManager::Link()
                 ScanLibraries();
             } while (ScanVirtuals());
         }
+        if (removeUnused)
+            RemoveUnusedSections();
+        if (foldIdentical)
+            FoldIdenticalCode();
     }
     if (specName.empty())
     {
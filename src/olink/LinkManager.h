@@ -36,6 +36,8 @@
 #include <map>
 #include <memory>
 #include <deque>
+#include <vector>
+#include <mutex>
 #include <stdio.h>
 
 class LibManager;
@@ -142,14 +144,17 @@ class LinkManager
     FileIterator FileBegin() { return fileData.begin(); }
     FileIterator FileEnd() { return fileData.end(); }
 
+    // these may be called from the threads that relocate sections
     static void LinkError(const ObjString& error)
     {
+        std::lock_guard<std::mutex> lock(errorMutex);
         HookError(0);
         std::cout << "Error: " << error << std::endl;
         errors++;
     }
     static void LinkWarning(const ObjString& error)
     {
+        std::lock_guard<std::mutex> lock(errorMutex);
         HookError(1);
         std::cout << "Warning: " << error << std::endl;
         warnings++;
@@ -170,6 +175,12 @@ class LinkManager
     int WarnCount() const { return warnings; }
     bool HasVirtual(std::string name);
 
+    void SetRemoveUnused(bool flag) { removeUnused = flag; }
+    void SetFoldIdentical(bool flag) { foldIdentical = flag; }
+    bool IsDiscarded(ObjSection* sect) { return discarded.find(sect) != discarded.end(); }
+    bool IsDiscarded(ObjSymbol* sym);
+    ObjSection* FoldedVirtual(const ObjString& sectionName);
+
   private:
     void LoadExterns(ObjFile* file, ObjExpression* exp);
     void LoadSectionExternals(ObjFile* file, ObjSection* section);
@@ -191,6 +202,16 @@ class LinkManager
     bool ExternalErrors();
     void AddGlobalsForVirtuals(ObjFile* file);
     void CreateOutputFile();
+    void MarkName(const ObjString& name, std::deque<ObjSection*>& pending);
+    void MarkExpression(ObjExpression* exp, std::deque<ObjSection*>& pending);
+    void MarkSection(ObjSection* sect, std::deque<ObjSection*>& pending);
+    void MarkVirtual(const ObjString& name, std::deque<ObjSection*>& pending);
+    void RemoveUnusedSections();
+    ObjString FoldedName(ObjString name);
+    void FixupContents(ObjExpression* exp, const ObjString& self, std::string& contents);
+    void SectionContents(ObjSection* sect, std::string& contents);
+    void AddressesTaken(ObjExpression* exp, bool relative, std::set<ObjString>& names);
+    void FoldIdenticalCode();
     ObjString outputFile;
     LinkTokenizer specification;
     PartitionData partitions;
@@ -206,6 +227,11 @@ class LinkManager
     std::deque<std::unique_ptr<LinkLibrary>> dictionaries;
     std::vector<ObjSection*> virtualSections;
     std::map<ObjSection*, ObjSection*> parentSections;
+    std::set<ObjSection*> liveSections;
+    std::set<ObjSection*> discarded;
+    std::map<ObjString, std::vector<ObjSection*>> virtualCopies;  // every loaded copy of each virtual section
+    std::set<ObjString> liveVirtuals;
+    std::map<ObjString, ObjString> foldedVirtuals;  // virtual section to the identical one used in its place
     ObjIOBase* ioBase;
     ObjIndexManager* indexManager;
     ObjFactory* factory;
@@ -215,7 +241,10 @@ class LinkManager
     bool completeLink;
     bool caseSensitive;
     bool debugPassThrough;
+    bool removeUnused;
+    bool foldIdentical;
     static int errors;
     static int warnings;
+    static std::mutex errorMutex;
 };
 #endif
@@ -226,7 +226,7 @@ void LinkRegion::AddData(SectionData& data, LookasideBuf& lookaside, ObjFile* fi
     ns->sections.push_back(OneSection(file, section));
 }
 
-void LinkRegion::AddFile(ObjFile* file)
+void LinkRegion::AddFile(LinkManager* manager, ObjFile* file)
 {
     LinkNameLogic logic(name);
     for (auto it = file->SectionBegin(); it != file->SectionEnd(); ++it)
@@ -235,10 +235,12 @@ void LinkRegion::AddFile(ObjFile* file)
         if (logic.Matches(sect->GetName()))
         {
             ObjInt quals = sect->GetQuals();
-            if (attribs.GetAlign() < sect->GetAlignment())
-                attribs.SetAlign(new LinkExpression(sect->GetAlignment()));
             // using section::utility flag to for placed regions
             sect->SetUtilityFlag(true);
+            if (manager->IsDiscarded(sect))
+                continue;
+            if (attribs.GetAlign() < sect->GetAlignment())
+                attribs.SetAlign(new LinkExpression(sect->GetAlignment()));
             if (quals & ObjSection::now)
             {
                 if (quals & ObjSection::postpone)
@@ -263,13 +265,13 @@ void LinkRegion::AddSection(LinkManager* manager)
     {
         ObjFile* file = *it;
         if (sourceFiles.empty())
-            AddFile(file);
+            AddFile(manager, file);
         else
             for (auto srcFile : sourceFiles)
             {
                 if (srcFile == file->GetInputName())
                 {
-                    AddFile(file);
+                    AddFile(manager, file);
                     break;
                 }
             }
@@ -405,6 +407,16 @@ ObjInt LinkRegion::ArrangeOverlayed(LinkManager* manager, NamedSection* data, Ob
         data->sections.clear();
         return 0;
     }
+    ObjSection* folded = manager->FoldedVirtual(test2->GetName());
+    if (folded)
+    {
+        // identical code folding found another section with the same contents, use that one instead
+        for (auto item : data->sections)
+            item.section->SetAliasFor(folded);
+        data->sections.clear();
+        VirtualPublic(manager, test2, folded);
+        return 0;
+    }
     ObjSection* curSection = nullptr;
     ObjFile* curFile = nullptr;
     for (auto item : data->sections)
@@ -431,29 +443,31 @@ ObjInt LinkRegion::ArrangeOverlayed(LinkManager* manager, NamedSection* data, Ob
         curSection->SetVirtualOffset(attribs.GetVirtualOffset());
     // make a public for virtual sections (C++)
     if (curSection->GetQuals() & ObjSection::virt)
+        VirtualPublic(manager, curSection, curSection);
+    return curSection->GetAbsSize();
+}
+void LinkRegion::VirtualPublic(LinkManager* manager, ObjSection* sect, ObjSection* target)
+{
+    int i;
+    for (i = 0; i < sect->GetName().size(); i++)
     {
-        int i;
-        for (i = 0; i < curSection->GetName().size(); i++)
+        if (sect->GetName()[i] == '@' || sect->GetName()[i] == '_')
+            break;
+    }
+    if (i < sect->GetName().size())
+    {
+        std::string pubName = sect->GetName().substr(i);
+        LinkExpressionSymbol* esym = new LinkExpressionSymbol(pubName, new LinkExpression(target));
+        if (!LinkExpression::EnterSymbol(esym))
         {
-            if (curSection->GetName()[i] == '@' || curSection->GetName()[i] == '_')
-                break;
+            delete esym;
+            LinkManager::LinkError("Symbol " + pubName + " redefined");
         }
-        if (i < curSection->GetName().size())
+        else if (sect == target)
         {
-            std::string pubName = curSection->GetName().substr(i);
-            LinkExpressionSymbol* esym = new LinkExpressionSymbol(pubName, new LinkExpression(curSection));
-            if (!LinkExpression::EnterSymbol(esym))
-            {
-                delete esym;
-                LinkManager::LinkError("Symbol " + pubName + " redefined");
-            }
-            else
-            {
-                manager->EnterVirtualSection(curSection);
-            }
+            manager->EnterVirtualSection(sect);
         }
     }
-    return curSection->GetAbsSize();
 }
 ObjInt LinkRegion::ArrangeSections(LinkManager* manager)
 {
@@ -113,7 +113,8 @@ class LinkRegion
   private:
     std::map<std::string, int> equalSections;
     ObjInt ArrangeOverlayed(LinkManager* manager, NamedSection* data, ObjInt address);
-    void AddFile(ObjFile* file);
+    void VirtualPublic(LinkManager* manager, ObjSection* sect, ObjSection* target);
+    void AddFile(LinkManager* manager, ObjFile* file);
     bool ParseFiles(CmdFiles& files, LinkTokenizer& spec);
     bool ParseName(LinkTokenizer& spec);
     bool ParseAttributes(LinkTokenizer& spec);
@@ -33,6 +33,9 @@
 #include <ctime>
 #include <cstdio>
 #include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 unsigned LinkRemapper::crc_table[256] = {
     0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4,
@@ -78,9 +81,7 @@ ObjInt LinkRemapper::RenumberSection(LinkRegion* region, ObjSection* dest, LinkR
     sect->SetIndex(group);
     sect->SetOffset(new ObjExpression(region->GetParent()->GetAttribs().GetAddress()));
     ObjMemoryManager& memManager = sect->GetMemoryManager();
-    LinkSymbolData d;
     manager->MapSectionToParent(source->section, dest);
-    d.SetFile(source->file);
     // now copy all the data from the old section to the new one
     if (!(dest->GetQuals() & ObjSection::common) || dest->GetMemoryManager().MemoryBegin() == dest->GetMemoryManager().MemoryEnd())
     {
@@ -101,15 +102,44 @@ ObjInt LinkRemapper::RenumberSection(LinkRegion* region, ObjSection* dest, LinkR
             n += (*it)->GetSize();
             // redo source file indexes
             dest->Add(*it);
-            if ((*it)->GetFixup())
-            {
-                (*it)->SetFixup(ScanExpression((*it)->GetFixup(), &d));
-            }
         }
+        // the fixups get rewritten later by RelocateSections
+        relocations.push_back(*source);
         rv = n;
     }
     return rv;
 }
+void LinkRemapper::RelocateSections()
+{
+    // rewriting a fixup only looks up symbols and the bases of sections, which are all settled
+    // once the sections have been placed, and each fixup tree belongs to one section.   So the
+    // sections are handed out to a few threads.
+    std::atomic<int> next(0);
+    auto worker = [this, &next]() {
+        LinkSymbolData d;
+        for (int i; (i = next++) < relocations.size();)
+        {
+            d.SetFile(relocations[i].file);
+            ObjMemoryManager& memManager = relocations[i].section->GetMemoryManager();
+            for (auto it = memManager.MemoryBegin(); it != memManager.MemoryEnd(); ++it)
+            {
+                if ((*it)->GetFixup())
+                {
+                    (*it)->SetFixup(ScanExpression((*it)->GetFixup(), &d));
+                }
+            }
+        }
+    };
+    int jobs = std::max(1u, std::thread::hardware_concurrency());
+    if (jobs > relocations.size())
+        jobs = relocations.size();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < jobs; i++)
+        threads.push_back(std::thread(worker));
+    for (auto&& t : threads)
+        t.join();
+    relocations.clear();
+}
 bool LinkRemapper::OptimizeRight(ObjExpression* exp, ObjExpression* right)
 {
     bool rv = false;
@@ -321,6 +351,31 @@ ObjInt LinkRemapper::RegisterType(ObjFile* file, ObjType* type, char* name)
     // type->SetIndex(n);
     return n;
 }
+ObjInt LinkRemapper::RegisterType(ObjFile* file, ObjType* type, unsigned long long signature)
+{
+    // the compiler gave the type a signature which is the same in every module,
+    // so there is no need to build a name for it from its base types.   But a typedef
+    // may have renamed the type, and those are kept apart so the name isn't lost
+    for (auto c : type->GetName())
+    {
+        signature ^= (unsigned char)c;
+        signature *= 0x100000001b3ULL;
+    }
+    int n;
+    auto sny = signedTypes.find(signature);
+    if (sny != signedTypes.end())
+    {
+        n = sny->second;
+    }
+    else
+    {
+        file->Add(type);
+        n = indexManager->NextType();
+        signedTypes[signature] = n;
+    }
+    fileTypes[type->GetIndex()] = n;
+    return n;
+}
 ObjInt LinkRemapper::MapType(ObjFile* file, ObjType* type)
 {
     char name[4096];
@@ -397,7 +452,10 @@ void LinkRemapper::RenumberType(ObjFile* file, ObjType* type)
     int n = LookupFileType(type->GetIndex());
     if (!n)
     {
-        MapType(file, type);
+        if (type->GetSignature())
+            RegisterType(file, type, type->GetSignature());
+        else
+            MapType(file, type);
     }
     else
     {
@@ -441,7 +499,8 @@ ObjFile* LinkRemapper::Remap()
             file->SetBigEndian(true);
         for (auto its = (*it)->PublicBegin(); its != (*it)->PublicEnd(); ++its)
         {
-            RenumberSymbol(file, *its, indexManager->NextPublic());
+            if (!manager->IsDiscarded(*its))
+                RenumberSymbol(file, *its, indexManager->NextPublic());
         }
         for (auto its = (*it)->ExternalBegin(); its != (*it)->ExternalEnd(); ++its)
         {
@@ -467,7 +526,8 @@ ObjFile* LinkRemapper::Remap()
         }
         for (auto its = (*it)->LocalBegin(); its != (*it)->LocalEnd(); ++its)
         {
-            RenumberSymbol(file, *its, indexManager->NextLocal());
+            if (!manager->IsDiscarded(*its))
+                RenumberSymbol(file, *its, indexManager->NextLocal());
         }
         for (auto its = (*it)->AutoBegin(); its != (*it)->AutoEnd(); ++its)
         {
@@ -565,6 +625,7 @@ ObjFile* LinkRemapper::Remap()
             }
         }
     }
+    RelocateSections();
     ObjExpression* sa = manager->GetObjIo()->GetStartAddress();
     if (sa)
     {
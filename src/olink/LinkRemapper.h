@@ -28,6 +28,7 @@
 #include "ObjTypes.h"
 #include "LinkRegion.h"
 #include <vector>
+#include <unordered_map>
 
 class LinkManager;
 class LinkSymbolData;
@@ -52,9 +53,11 @@ class LinkRemapper
     }
     ~LinkRemapper() {}
     ObjFile* Remap();
+    static unsigned crc32(unsigned char* buf, int len, unsigned crc);
 
   private:
     ObjInt RenumberSection(LinkRegion* region, ObjSection* dest, LinkRegion::OneSection* source, int group, int base);
+    void RelocateSections();
     bool OptimizeRight(ObjExpression* exp, ObjExpression* right);
     ObjExpression* Optimize(ObjExpression* exp, ObjExpression* right);
     ObjExpression* RewriteExpression(LinkExpression* exp, LinkExpressionSymbol* sym);
@@ -64,6 +67,7 @@ class LinkRemapper
     ObjInt GetTypeIndex(ObjType* type);
     void SetTypeIndex(ObjType* type);
     ObjInt RegisterType(ObjFile* file, ObjType* type, char* name);
+    ObjInt RegisterType(ObjFile* file, ObjType* type, unsigned long long signature);
     ObjInt MapType(ObjFile* file, ObjType* type);
     void RenumberType(ObjFile* file, ObjType* type);
     void RenumberSourceFile(ObjFile* file, ObjSourceFile* sourceFile);
@@ -73,9 +77,10 @@ class LinkRemapper
     ObjIndexManager* indexManager;
     bool completeLink;
     std::vector<ObjSection*> sections;
+    std::vector<LinkRegion::OneSection> relocations;
     std::map<ObjString, ObjInt> newTypes;
-    std::map<ObjInt, ObjInt> fileTypes;
+    std::unordered_map<unsigned long long, ObjInt> signedTypes;
+    std::unordered_map<ObjInt, ObjInt> fileTypes;
     static unsigned crc_table[256];
-    unsigned crc32(unsigned char* buf, int len, unsigned crc);
 };
 #endif
@@ -85,6 +85,8 @@ CmdSwitchOutput LinkerMain::OutputFile(SwitchParser, 'o', ".rel");
 CmdSwitchBool LinkerMain::Verbosity(SwitchParser, 'y');
 CmdSwitchCombineString LinkerMain::OutputDefFile(SwitchParser, 0, 0, {"output-def"});
 CmdSwitchCombineString LinkerMain::PrintFileName(SwitchParser, 0, 0, {"print-file-name"});
+CmdSwitchBool LinkerMain::RemoveUnused(SwitchParser, 0, false, {"gc-sections"});
+CmdSwitchBool LinkerMain::FoldIdentical(SwitchParser, 0, false, {"icf"});
 
 SwitchConfig LinkerMain::TargetConfig(SwitchParser, 'T');
 const char* LinkerMain::usageText =
@@ -98,6 +100,8 @@ const char* LinkerMain::usageText =
     "/r+       Relative output file       /sxxx          Read specification file\n"
     "/y[...]   Verbose                    /!, --nologo   No logo\n"
     "\n"
+    " --gc-sections            leave out code and data nothing refers to\n"
+    " --icf                    fold identical template and inline functions that are only called\n"
     " --output-def filename    create a .def file for DLLs\n"
     " --shared                 create a dll\n"
     "@xxx      Read commands from file\n"
@@ -340,7 +344,7 @@ int LinkerMain::Run(int argc, char** argv)
     // object ordering is important to allow proper deconstruction
     ObjIeeeIndexManager im1;
     ObjIeeeIndexManager im2;
-    ObjFactory fact1(&im2);
+    ObjFactory fact1(&im2, true);
     if (DebugInfo.GetValue() || DebugInfo2.GetValue())
         debugFile = Utils::QualifiedFile(outputFile.c_str(), ".odx");
     char* lpath = getenv("LIBRARY_PATH");
@@ -353,6 +357,8 @@ int LinkerMain::Run(int argc, char** argv)
     LinkManager linker(SpecFileContents(specificationFile), CaseSensitive.GetValue(), outputFile,
                        !RelFile.GetValue() && !TargetConfig.GetRelFile(), TargetConfig.GetDebugPassThrough(), debugFile);
     linker.SetLibPath(LibPath.GetValue());
+    linker.SetRemoveUnused(RemoveUnused.GetValue());
+    linker.SetFoldIdentical(FoldIdentical.GetValue());
     ParseSpecifiedLibFiles(files, linker);
     if (DoPrintFileName(linker))
         exit(0);
@@ -62,6 +62,8 @@ class LinkerMain
     static CmdSwitchBool Verbosity;
     static CmdSwitchCombineString OutputDefFile;
     static CmdSwitchCombineString PrintFileName;
+    static CmdSwitchBool RemoveUnused;
+    static CmdSwitchBool FoldIdentical;
     static SwitchConfig TargetConfig;
     static const char* usageText;
 };
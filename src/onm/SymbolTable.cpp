@@ -151,7 +151,7 @@ void SymbolTable::Load(CmdFiles& files)
             {
                 FILE* stream = fopen((*it).c_str(), "rb");
                 ObjIeeeIndexManager im1;
-                ObjFactory factory(&im1);
+                ObjFactory factory(&im1, true);
                 ObjIeee ieee((*it).c_str(), true);
                 ObjFile* f = ieee.Read(stream, ObjIeee::eAll, &factory);
                 if (!f)
@@ -168,7 +168,7 @@ void SymbolTable::Load(CmdFiles& files)
                 for (int i = 0; i < librarian.Files().size(); ++i)
                 {
                     ObjIeeeIndexManager im1;
-                    ObjFactory factory(&im1);
+                    ObjFactory factory(&im1, true);
                     ProcessObjectFile(librarian.LoadModule(i, &factory));
                 }
             }
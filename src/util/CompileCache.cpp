@@ -0,0 +1,283 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#include "CompileCache.h"
+#include "CmdFiles.h"
+#include "Utils.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <algorithm>
+#ifdef HAVE_UNISTD_H
+#    include <dirent.h>
+#    include <utime.h>
+#    include <unistd.h>
+#else
+#    include <io.h>
+#    include <sys/utime.h>
+#endif
+
+static const unsigned roundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be,
+    0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa,
+    0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85,
+    0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f,
+    0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+static inline unsigned Rotate(unsigned value, int bits) { return (value >> bits) | (value << (32 - bits)); }
+
+CompileCache::Key::Key() : length(0)
+{
+    static const unsigned initial[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    memcpy(state, initial, sizeof(state));
+}
+void CompileCache::Key::Block(const unsigned char* data)
+{
+    unsigned w[64];
+    for (int i = 0; i < 16; i++)
+        w[i] = (data[i * 4] << 24) | (data[i * 4 + 1] << 16) | (data[i * 4 + 2] << 8) | data[i * 4 + 3];
+    for (int i = 16; i < 64; i++)
+    {
+        unsigned s0 = Rotate(w[i - 15], 7) ^ Rotate(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        unsigned s1 = Rotate(w[i - 2], 17) ^ Rotate(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    unsigned a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; i++)
+    {
+        unsigned t1 = h + (Rotate(e, 6) ^ Rotate(e, 11) ^ Rotate(e, 25)) + ((e & f) ^ (~e & g)) + roundConstants[i] + w[i];
+        unsigned t2 = (Rotate(a, 2) ^ Rotate(a, 13) ^ Rotate(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+void CompileCache::Key::Add(const void* data, size_t len)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    while (len)
+    {
+        size_t used = length % 64;
+        size_t n = std::min(len, 64 - used);
+        memcpy(buffer + used, p, n);
+        length += n;
+        p += n;
+        len -= n;
+        if (used + n == 64)
+            Block(buffer);
+    }
+}
+std::string CompileCache::Key::Value() const
+{
+    // padding is added to a copy so more can still be added to this key
+    Key copy = *this;
+    unsigned long long bits = length * 8;
+    unsigned char pad[72] = {0x80};
+    size_t padLength = (length % 64 < 56 ? 56 : 120) - length % 64;
+    for (int i = 0; i < 8; i++)
+        pad[padLength + i] = bits >> (56 - i * 8);
+    copy.Add(pad, padLength + 8);
+    std::string rv;
+    char buf[16];
+    for (auto v : copy.state)
+    {
+        sprintf(buf, "%08x", v);
+        rv += buf;
+    }
+    return rv;
+}
+CompileCache::CompileCache(const std::string& Directory, unsigned long long MaxSize) : directory(Directory), maxSize(MaxSize)
+{
+    if (directory.size() && directory.back() != '/' && directory.back() != '\\')
+#ifdef HAVE_UNISTD_H
+        directory += "/";
+#else
+        directory += CmdFiles::DIR_SEP;
+#endif
+}
+std::string CompileCache::FileStamp(const std::string& name)
+{
+    struct stat st;
+    if (stat(name.c_str(), &st))
+        return "0;0";
+    return Utils::NumberToString(st.st_size) + ";" + Utils::NumberToString((int)st.st_mtime);
+}
+bool CompileCache::Copy(const std::string& from, const std::string& to)
+{
+    FILE* in = fopen(from.c_str(), "rb");
+    if (!in)
+        return false;
+    FILE* out = fopen(to.c_str(), "wb");
+    if (!out)
+    {
+        fclose(in);
+        return false;
+    }
+    bool rv = true;
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0)
+        if (fwrite(buf, 1, n, out) != n)
+        {
+            rv = false;
+            break;
+        }
+    fclose(in);
+    if (fclose(out))
+        rv = false;
+    if (!rv)
+        remove(to.c_str());
+    return rv;
+}
+bool CompileCache::Lookup(const std::string& key, const std::string& outputFile)
+{
+    std::string name = EntryName(key);
+    if (!Copy(name, outputFile))
+        return false;
+    // the modification time of an entry is the time it was last used
+    utime(name.c_str(), nullptr);
+    return true;
+}
+bool CompileCache::Store(const std::string& key, const std::string& inputFile)
+{
+    std::string name = EntryName(key);
+    if (Utils::FileExists(name.c_str()))
+    {
+        utime(name.c_str(), nullptr);
+        return true;
+    }
+    // other compiles may be looking at the cache, so entries only appear once they are complete
+    std::string temp = name + "." + Utils::NumberToString(Utils::Random(1 << 30));
+    if (!Copy(inputFile, temp))
+        return false;
+    if (rename(temp.c_str(), name.c_str()))
+    {
+        remove(temp.c_str());
+        return Utils::FileExists(name.c_str());
+    }
+    return true;
+}
+void CompileCache::Entries(std::vector<Entry>& list)
+{
+#ifdef HAVE_UNISTD_H
+    DIR* dir = opendir(directory.c_str());
+    if (dir)
+    {
+        struct dirent* ent;
+        while ((ent = readdir(dir)) != nullptr)
+        {
+            std::string name = ent->d_name;
+            struct stat st;
+            if (name.size() > 4 && name.substr(name.size() - 4) == ".occ" && !stat((directory + name).c_str(), &st))
+                list.push_back(Entry{directory + name, (unsigned long long)st.st_size, st.st_mtime});
+        }
+        closedir(dir);
+    }
+#else
+    struct _finddata_t find;
+    std::string match = directory + "*.occ";
+    long handle;
+    if ((handle = _findfirst(const_cast<char*>(match.c_str()), &find)) != -1)
+    {
+        do
+        {
+            list.push_back(Entry{directory + find.name, (unsigned long long)find.size, find.time_write});
+        } while (_findnext(handle, &find) != -1);
+        _findclose(handle);
+    }
+#endif
+}
+void CompileCache::Trim()
+{
+    if (!maxSize)
+        return;
+    std::vector<Entry> list;
+    Entries(list);
+    unsigned long long size = 0;
+    for (auto&& e : list)
+        size += e.size;
+    if (size <= maxSize)
+        return;
+    std::sort(list.begin(), list.end(), [](const Entry& left, const Entry& right) { return left.used < right.used; });
+    // go a bit under the limit so the next few stores don't each have to scan the directory again
+    unsigned long long target = maxSize / 10 * 9;
+    for (auto&& e : list)
+    {
+        if (size <= target)
+            break;
+        if (!remove(e.name.c_str()))
+            size -= e.size;
+    }
+}
+void CompileCache::Count(int hits, int misses)
+{
+    std::string name = directory + "stats";
+    int oldHits = 0, oldMisses = 0;
+    FILE* fil = fopen(name.c_str(), "r");
+    if (fil)
+    {
+        if (fscanf(fil, "%d %d", &oldHits, &oldMisses) != 2)
+            oldHits = oldMisses = 0;
+        fclose(fil);
+    }
+    fil = fopen(name.c_str(), "w");
+    if (fil)
+    {
+        fprintf(fil, "%d %d\n", oldHits + hits, oldMisses + misses);
+        fclose(fil);
+    }
+}
+void CompileCache::Statistics(int& hits, int& misses, int& entries, unsigned long long& size)
+{
+    hits = misses = 0;
+    FILE* fil = fopen((directory + "stats").c_str(), "r");
+    if (fil)
+    {
+        if (fscanf(fil, "%d %d", &hits, &misses) != 2)
+            hits = misses = 0;
+        fclose(fil);
+    }
+    std::vector<Entry> list;
+    Entries(list);
+    entries = list.size();
+    size = 0;
+    for (auto&& e : list)
+        size += e.size;
+}
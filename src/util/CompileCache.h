@@ -0,0 +1,84 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#ifndef CompileCache_h
+#define CompileCache_h
+
+#include <string>
+#include <vector>
+#include <time.h>
+
+// a directory of compiler output files, each named after a hash of everything that went into making
+// it.   When the directory grows past its size limit the entries that were used least recently are
+// removed.
+class CompileCache
+{
+  public:
+    // SHA-256 of everything added.   A hit reuses the object file without looking at the inputs
+    // again, so the key has to be one that different inputs won't collide on
+    class Key
+    {
+      public:
+        Key();
+        void Add(const void* data, size_t len);
+        void Add(const std::string& data) { Add(data.c_str(), data.size() + 1); }
+        void Add(long long value) { Add(&value, sizeof(value)); }
+        std::string Value() const;
+
+      private:
+        void Block(const unsigned char* data);
+
+        unsigned state[8];
+        unsigned long long length;
+        unsigned char buffer[64];
+    };
+    CompileCache(const std::string& Directory, unsigned long long MaxSize = 0);
+
+    // copies the entry for 'key' to 'outputFile', returns false if there isn't one
+    bool Lookup(const std::string& key, const std::string& outputFile);
+    bool Store(const std::string& key, const std::string& inputFile);
+    // remove the least recently used entries until the cache fits in its limit again
+    void Trim();
+    void Count(int hits, int misses);
+    void Statistics(int& hits, int& misses, int& entries, unsigned long long& size);
+    const std::string& Directory() const { return directory; }
+
+    // size and modification time of a file, zeros if it isn't there
+    static std::string FileStamp(const std::string& name);
+
+  private:
+    struct Entry
+    {
+        std::string name;
+        unsigned long long size;
+        time_t used;
+    };
+    std::string EntryName(const std::string& key) const { return directory + key + ".occ"; }
+    void Entries(std::vector<Entry>& list);
+    static bool Copy(const std::string& from, const std::string& to);
+
+    std::string directory;
+    unsigned long long maxSize;
+};
+#endif
@@ -29,6 +29,74 @@
 #    include <windows.h>
 #    include "io.h"
 #    include "fcntl.h"
+#else
+#    include <unistd.h>
+#    include <cstring>
+#    include <sys/socket.h>
+#    include <sys/un.h>
+#    include <sys/stat.h>
+#    include <sys/types.h>
+#    include <stdint.h>
+#endif
+
+#ifdef HAVE_UNISTD_H
+// a bare pipe name goes in a directory only the current user can get into, $XDG_RUNTIME_DIR if
+// there is one, otherwise /tmp/occ-<uid>.   Someone else may have made the latter first, so it
+// has to be checked before it is used
+static bool PipeDirectory(std::string& dir, bool create)
+{
+    const char* runtime = getenv("XDG_RUNTIME_DIR");
+    if (runtime && runtime[0])
+        dir = runtime;
+    else
+        dir = "/tmp/occ-" + std::to_string(geteuid());
+    if (create)
+        mkdir(dir.c_str(), 0700);
+    struct stat st;
+    return lstat(dir.c_str(), &st) == 0 && S_ISDIR(st.st_mode) && st.st_uid == geteuid() && !(st.st_mode & 077);
+}
+// on posix systems pipe names map to unix domain sockets
+static bool PipeAddress(struct sockaddr_un* addr, const std::string& pipeName, bool create)
+{
+    std::string path = pipeName;
+    if (pipeName.find('/') == std::string::npos)
+    {
+        std::string dir;
+        if (!PipeDirectory(dir, create))
+            return false;
+        path = dir + "/" + pipeName;
+    }
+    if (path.size() >= sizeof(addr->sun_path))
+        return false;
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    strcpy(addr->sun_path, path.c_str());
+    return true;
+}
+static bool WriteAll(int fileno, const char* data, size_t n)
+{
+    while (n)
+    {
+        int l = write(fileno, data, n);
+        if (l <= 0)
+            return false;
+        data += l;
+        n -= l;
+    }
+    return true;
+}
+static bool ReadAll(int fileno, char* data, size_t n)
+{
+    while (n)
+    {
+        int l = read(fileno, data, n);
+        if (l <= 0)
+            return false;
+        data += l;
+        n -= l;
+    }
+    return true;
+}
 #endif
 
 bool Utils::NamedPipe(int* fds, const std::string& pipeName)
@@ -44,9 +112,72 @@ bool Utils::NamedPipe(int* fds, const std::string& pipeName)
         *fds = _open_osfhandle((long)(intptr_t)handle, O_RDWR);
         return true;
     }
+#else
+    struct sockaddr_un addr;
+    if (!PipeAddress(&addr, pipeName, false))
+        return false;
+    int handle = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (handle >= 0)
+    {
+        if (connect(handle, (struct sockaddr*)&addr, sizeof(addr)) == 0)
+        {
+            *fds = handle;
+            return true;
+        }
+        close(handle);
+    }
 #endif
     return false;
 }
+int Utils::NamedPipeServer(const std::string& pipeName)
+{
+#ifdef HAVE_UNISTD_H
+    struct sockaddr_un addr;
+    if (!PipeAddress(&addr, pipeName, true))
+        return -1;
+    unlink(addr.sun_path);
+    int handle = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (handle >= 0)
+    {
+        // nobody else gets to connect, even if the socket is given an explicit path in a shared directory
+        mode_t old = umask(077);
+        bool bound = bind(handle, (struct sockaddr*)&addr, sizeof(addr)) == 0;
+        umask(old);
+        if (bound && chmod(addr.sun_path, 0600) == 0 && listen(handle, 64) == 0)
+            return handle;
+        close(handle);
+    }
+#endif
+    return -1;
+}
+int Utils::NamedPipeAccept(int server)
+{
+#ifdef HAVE_UNISTD_H
+    int handle = accept(server, nullptr, nullptr);
+    if (handle < 0)
+        return -1;
+    // only take requests from processes running as the same user as the server
+    uid_t uid = (uid_t)-1;
+#    ifdef SO_PEERCRED
+    struct ucred cred;
+    socklen_t len = sizeof(cred);
+    if (getsockopt(handle, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0)
+        uid = cred.uid;
+#    else
+    gid_t gid;
+    if (getpeereid(handle, &uid, &gid) != 0)
+        uid = (uid_t)-1;
+#    endif
+    if (uid != geteuid())
+    {
+        close(handle);
+        return -1;
+    }
+    return handle;
+#else
+    return -1;
+#endif
+}
 bool Utils::PipeWrite(int fileno, const std::string& data)
 {
 #ifndef HAVE_UNISTD_H
@@ -55,10 +186,10 @@ bool Utils::PipeWrite(int fileno, const std::string& data)
     return WriteFile((HANDLE)_get_osfhandle(fileno), &n, sizeof(DWORD), &read, NULL) &&
            WriteFile((HANDLE)_get_osfhandle(fileno), data.c_str(), n, &read, NULL);
 #else
-    return false;
+    uint32_t n = data.size();
+    return WriteAll(fileno, (const char*)&n, sizeof(n)) && WriteAll(fileno, data.c_str(), n);
 #endif
 }
-
 #ifndef HAVE_UNISTD_H
 static void WaitForPipeData(HANDLE hPipe, int size)
 {
@@ -98,6 +229,58 @@ std::string Utils::PipeRead(int fileno)
         }
         free(buffer);
     }
+#else
+    uint32_t n;
+    if (ReadAll(fileno, (char*)&n, sizeof(n)))
+    {
+        std::string rv(n, 0);
+        if (ReadAll(fileno, &rv[0], n))
+            return rv;
+    }
 #endif
     return "";
 }
+// pass open file handles to the other end of the pipe, only possible with unix domain sockets
+bool Utils::PipeWriteHandles(int fileno, const int* handles, int count)
+{
+#ifdef HAVE_UNISTD_H
+    char data = 0;
+    struct iovec iov = {&data, 1};
+    std::string control(CMSG_SPACE(sizeof(int) * count), 0);
+    struct msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = &control[0];
+    msg.msg_controllen = control.size();
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * count);
+    memcpy(CMSG_DATA(cmsg), handles, sizeof(int) * count);
+    return sendmsg(fileno, &msg, 0) == 1;
+#else
+    return false;
+#endif
+}
+bool Utils::PipeReadHandles(int fileno, int* handles, int count)
+{
+#ifdef HAVE_UNISTD_H
+    char data;
+    struct iovec iov = {&data, 1};
+    std::string control(CMSG_SPACE(sizeof(int) * count), 0);
+    struct msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = &control[0];
+    msg.msg_controllen = control.size();
+    if (recvmsg(fileno, &msg, 0) != 1)
+        return false;
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (!cmsg || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(sizeof(int) * count))
+        return false;
+    memcpy(handles, CMSG_DATA(cmsg), sizeof(int) * count);
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,190 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#ifndef PERFECTHASH_H
+#define PERFECTHASH_H
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+// a collision free hash table over a fixed set of names, built once at startup.
+// Names are hashed in a single forward pass so callers can hash text while they scan it,
+// without copying it anywhere.   The table is built by hash and displace: names are sorted
+// into buckets by one part of the hash, then each bucket, largest first, is given the
+// displacement that puts all its names into free slots.   A lookup is one bucket read,
+// one slot read and one compare.
+template <class T>
+class PerfectHash
+{
+  public:
+    class Hasher
+    {
+      public:
+        Hasher() : value(14695981039346656037ULL) {}
+        void Add(unsigned char c) { value = (value ^ c) * 1099511628211ULL; }
+        unsigned long long Value() const { return value; }
+
+      private:
+        unsigned long long value;
+    };
+    static unsigned long long Hash(const char* name, size_t len)
+    {
+        Hasher h;
+        for (size_t i = 0; i < len; i++)
+            h.Add(name[i]);
+        return h.Value();
+    }
+
+    PerfectHash() : bucketBits(0), slotMask(0) {}
+
+    void Clear()
+    {
+        pending.clear();
+        Reset();
+    }
+    // the name isn't copied, it has to stay around as long as the table does.  If a name
+    // is added more than once the last value wins
+    void Add(const char* name, const T& value)
+    {
+        size_t len = strlen(name);
+        for (auto&& p : pending)
+            if (p.len == len && !memcmp(p.name, name, len))
+            {
+                p.value = value;
+                return;
+            }
+        pending.push_back(Pending{name, len, value});
+    }
+    bool Build()
+    {
+        size_t size = 1;
+        while (size < pending.size() * 2)
+            size <<= 1;
+        // a failure means two names agree in every hash bit the table is using, so give it more bits
+        for (; size <= (1 << 20); size <<= 1)
+            if (Build(size))
+            {
+                pending.clear();
+                return true;
+            }
+        Clear();
+        return false;
+    }
+    const T* Lookup(const char* name, size_t len, unsigned long long hash) const
+    {
+        if (displacements.empty())
+            return nullptr;
+        unsigned slot = Slot(hash, displacements[Bucket(hash)]);
+        if (!names[slot] || lengths[slot] != len || memcmp(names[slot], name, len) != 0)
+            return nullptr;
+        return &values[slot];
+    }
+    const T* Lookup(const char* name, size_t len) const { return Lookup(name, len, Hash(name, len)); }
+
+  private:
+    struct Pending
+    {
+        const char* name;
+        size_t len;
+        T value;
+    };
+    unsigned Bucket(unsigned long long hash) const
+    {
+        return bucketBits ? (unsigned)((hash * 0x9e3779b97f4a7c15ULL) >> (64 - bucketBits)) : 0;
+    }
+    unsigned Slot(unsigned long long hash, unsigned displacement) const
+    {
+        return ((unsigned)hash + displacement * ((unsigned)(hash >> 32) | 1)) & slotMask;
+    }
+    void Reset()
+    {
+        names.clear();
+        lengths.clear();
+        values.clear();
+        displacements.clear();
+        slotMask = 0;
+    }
+    bool Build(size_t size)
+    {
+        Reset();
+        bucketBits = 0;
+        while (((size_t)1 << bucketBits) * 4 < pending.size())
+            bucketBits++;
+        slotMask = size - 1;
+        names.resize(size);
+        lengths.resize(size);
+        values.resize(size);
+        displacements.resize((size_t)1 << bucketBits);
+        std::vector<std::vector<size_t>> buckets(displacements.size());
+        std::vector<unsigned long long> hashes;
+        for (size_t i = 0; i < pending.size(); i++)
+        {
+            hashes.push_back(Hash(pending[i].name, pending[i].len));
+            buckets[Bucket(hashes.back())].push_back(i);
+        }
+        std::vector<size_t> order;
+        for (size_t i = 0; i < buckets.size(); i++)
+            order.push_back(i);
+        std::stable_sort(order.begin(), order.end(),
+                         [&buckets](size_t left, size_t right) { return buckets[left].size() > buckets[right].size(); });
+        std::vector<unsigned> placed;
+        for (auto b : order)
+        {
+            unsigned d;
+            for (d = 0; d < size; d++)
+            {
+                placed.clear();
+                for (auto i : buckets[b])
+                {
+                    unsigned slot = Slot(hashes[i], d);
+                    if (names[slot] || std::find(placed.begin(), placed.end(), slot) != placed.end())
+                        break;
+                    placed.push_back(slot);
+                }
+                if (placed.size() == buckets[b].size())
+                    break;
+            }
+            if (d == size)
+                return false;
+            displacements[b] = d;
+            for (size_t j = 0; j < placed.size(); j++)
+            {
+                const Pending& p = pending[buckets[b][j]];
+                names[placed[j]] = p.name;
+                lengths[placed[j]] = p.len;
+                values[placed[j]] = p.value;
+            }
+        }
+        return true;
+    }
+    std::vector<Pending> pending;
+    std::vector<const char*> names;
+    std::vector<size_t> lengths;
+    std::vector<T> values;
+    std::vector<unsigned> displacements;
+    int bucketBits;
+    unsigned slotMask;
+};
+#endif
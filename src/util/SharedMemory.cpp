@@ -29,15 +29,32 @@
 #include <random>
 #include <algorithm>
 #include <functional>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
 
 #ifdef _WIN32
 #    include <Windows.h>
+#else
+#    include <fcntl.h>
+#    include <unistd.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
 #endif
 
-#define USE_PAGING_FILE
+// views are placed on this boundary, which is the allocation granularity on windows
+static const unsigned long long ViewAlign = 64 * 1024;
 
-SharedMemory::SharedMemory(unsigned max, std::string name, unsigned window) :
-    max_(max), windowSize_(window), current_(0), regionStart(0), regionHandle(nullptr), fileHandle_(nullptr), regionBase_(0)
+SharedMemory::SharedMemory(std::string name, unsigned window) :
+    windowSize_(window),
+    chunkSize_(16ULL * window),
+    current_(0),
+    fileHandle_(nullptr),
+    fd_(-1),
+    owner_(false),
+    regionBase_(0),
+    regionHandle(nullptr),
+    regionStart(nullptr)
 {
     if (!name.empty())
         name_ = name;
@@ -47,90 +64,160 @@ SharedMemory::SharedMemory(unsigned max, std::string name, unsigned window) :
 
 SharedMemory::~SharedMemory()
 {
-#ifdef _WIN32
-    //    Flush();
     CloseMapping();
-    CloseHandle(regionHandle);
-    CloseHandle(fileHandle_);
+#ifdef _WIN32
+    if (regionHandle)
+        CloseHandle(regionHandle);
+    // the owner opened the file delete-on-close, so it goes away with the last handle
+    if (fileHandle_)
+        CloseHandle(fileHandle_);
+#else
+    if (fd_ >= 0)
+        close(fd_);
+    if (owner_)
+        unlink(FileName().c_str());
+#endif
+}
+std::string SharedMemory::FileName()
+{
+    std::string name = name_;
+    std::replace(name.begin(), name.end(), ':', '_');
+#ifdef _WIN32
+    char path[MAX_PATH];
+    if (!GetTempPath(sizeof(path), path))
+        strcpy(path, ".\\");
+    return std::string(path) + name;
+#else
+    const char* path = getenv("TMPDIR");
+    if (!path || !path[0])
+        path = "/tmp";
+    return std::string(path) + "/" + name;
 #endif
 }
-
 bool SharedMemory::Open()
 {
 #ifdef _WIN32
-    regionHandle = OpenFileMapping(FILE_MAP_ALL_ACCESS, false, name_.c_str());
+    fileHandle_ = CreateFile(FileName().c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                             nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_TEMPORARY, nullptr);
+    if (fileHandle_ == INVALID_HANDLE_VALUE)
+    {
+        fileHandle_ = nullptr;
+        return false;
+    }
+#else
+    fd_ = open(FileName().c_str(), O_RDWR);
+    if (fd_ < 0)
+        return false;
 #endif
-    return !!regionHandle;
+    return EnsureCommitted(chunkSize_);
 }
 
+// the backing file is always a new one.   If the name is already taken, by another region or by
+// something planted in the temporary directory, a different random name is tried
 bool SharedMemory::Create()
 {
+    for (int tries = 0;; tries++)
+    {
 #ifdef _WIN32
-#    ifdef USE_PAGING_FILE
-    fileHandle_ = INVALID_HANDLE_VALUE;
-#    else
-    fileHandle_ = CreateFile(name_.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
-                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
-#    endif
-    regionHandle = CreateFileMapping(fileHandle_, NULL, PAGE_READWRITE | SEC_RESERVE, 0, max_, name_.c_str());
+        fileHandle_ = CreateFile(FileName().c_str(), GENERIC_READ | GENERIC_WRITE,
+                                 FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, CREATE_NEW,
+                                 FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+        if (fileHandle_ != INVALID_HANDLE_VALUE)
+            break;
+        fileHandle_ = nullptr;
+        if (GetLastError() != ERROR_FILE_EXISTS || tries == 10)
+            return false;
+#else
+        fd_ = open(FileName().c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd_ >= 0)
+            break;
+        if (errno != EEXIST || tries == 10)
+            return false;
 #endif
-    return !!regionHandle && GetMapping();
+        SetName();
+    }
+    owner_ = true;
+    return EnsureCommitted(chunkSize_) && GetMapping();
 }
 void SharedMemory::Flush()
 {
 #ifdef _WIN32
-    if (current_)
-    {
-        FlushViewOfFile(regionStart, current_);
-        FlushFileBuffers(fileHandle_);
-    }
+    if (regionStart)
+        FlushViewOfFile(regionStart, 0);
+#else
+    if (regionStart)
+        msync(regionStart, ViewWindowSize() * 2, MS_ASYNC);
 #endif
 }
-unsigned char* SharedMemory::GetMapping(unsigned pos)
+unsigned char* SharedMemory::GetMapping(unsigned long long pos)
 {
-#ifdef _WIN32
-    regionBase_ = pos & -4096;
     CloseMapping();
-    regionStart = (unsigned char*)MapViewOfFile(regionHandle, FILE_MAP_ALL_ACCESS, 0, regionBase_, ViewWindowSize() * 2);
-    if (regionStart)
-        return regionStart - regionBase_;
+    regionBase_ = pos & ~(ViewAlign - 1);
+    if (!EnsureCommitted(regionBase_ + ViewWindowSize() * 2))
+        return nullptr;
+#ifdef _WIN32
+    regionStart = (unsigned char*)MapViewOfFile(regionHandle, FILE_MAP_ALL_ACCESS, (DWORD)(regionBase_ >> 32), (DWORD)regionBase_,
+                                                ViewWindowSize() * 2);
+#else
+    void* p = mmap(nullptr, ViewWindowSize() * 2, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, (off_t)regionBase_);
+    regionStart = p == MAP_FAILED ? nullptr : (unsigned char*)p;
 #endif
-    return 0;
+    // callers index the mapping with absolute positions
+    if (regionStart)
+        return regionStart - (size_t)regionBase_;
+    return nullptr;
 }
 void SharedMemory::CloseMapping()
 {
-#ifdef _WIN32
     if (regionStart)
     {
+#ifdef _WIN32
         UnmapViewOfFile(regionStart);
+#else
+        munmap(regionStart, ViewWindowSize() * 2);
+#endif
         regionStart = nullptr;
     }
+}
+// make the backing file at least 'size' bytes long.   It is grown a chunk at a time; another
+// process may have grown it already, in which case we just pick up the new size
+bool SharedMemory::EnsureCommitted(unsigned long long size)
+{
+    if (size <= current_)
+        return true;
+#ifdef _WIN32
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle_, &fileSize))
+        return false;
+    unsigned long long end = fileSize.QuadPart;
+#else
+    struct stat st;
+    if (fstat(fd_, &st))
+        return false;
+    unsigned long long end = st.st_size;
 #endif
+    if (end < size)
+        end = (size + chunkSize_ - 1) / chunkSize_ * chunkSize_;
+    return Remap(end);
 }
-bool SharedMemory::EnsureCommitted(int size)
+bool SharedMemory::Remap(unsigned long long size)
 {
-    int end = size;
-    end += 4095;
-    end = (end / 4096) * 4096;
-    // remove next two lines???
-//    current_ = end;
-//    return true;
 #ifdef _WIN32
-    if (end > current_)
-    {
-        unsigned char* temp = (unsigned char*)MapViewOfFile(regionHandle, FILE_MAP_ALL_ACCESS, 0, current_, end - current_);
-        if (!VirtualAlloc(temp, end - current_, MEM_COMMIT, PAGE_READWRITE))
-        {
-            UnmapViewOfFile(temp);
-            return false;
-        }
-        UnmapViewOfFile(temp);
-        current_ = end;
-    }
-    return true;
+    // views that are already open stay valid when the old mapping handle is closed
+    if (regionHandle)
+        CloseHandle(regionHandle);
+    regionHandle = CreateFileMapping(fileHandle_, nullptr, PAGE_READWRITE, (DWORD)(size >> 32), (DWORD)size, nullptr);
+    if (!regionHandle)
+        return false;
 #else
-    return false;
+    struct stat st;
+    if (fstat(fd_, &st))
+        return false;
+    if ((unsigned long long)st.st_size < size && ftruncate(fd_, (off_t)size))
+        return false;
 #endif
+    current_ = size;
+    return true;
 }
 void SharedMemory::SetName()
 {
@@ -140,4 +227,4 @@ void SharedMemory::SetName()
 
     // the lssm: is an attempt to prevent the RNG from choosing someone else's name accidentally...
     name_ = "lssm:" + std::string(rnd.begin(), rnd.end());
-}
\ No newline at end of file
+}
@@ -23,30 +23,39 @@
  */
 
 #include <string>
+
+// a region of memory shared between the compiler processes.   It is backed by a temporary file
+// that grows a chunk at a time as it is written, so there is no limit on the size of the
+// intermediate code and only the current window of it needs to be resident.   Positions are
+// 64 bit so that regions larger than 4GB can be addressed.
 class SharedMemory
 {
   public:
-    SharedMemory(unsigned max, std::string name = "", unsigned window = 1024 * 1024);
+    SharedMemory(std::string name = "", unsigned window = 1024 * 1024);
     ~SharedMemory();
 
     bool Open();
     bool Create();
     unsigned ViewWindowSize() const { return windowSize_; }
     std::string Name() { return name_; }
-    unsigned char* GetMapping(unsigned pos = 0);
+    unsigned char* GetMapping(unsigned long long pos = 0);
     void CloseMapping();
-    bool EnsureCommitted(int size);
+    bool EnsureCommitted(unsigned long long size);
     void Flush();
 
   private:
     void SetName();
+    std::string FileName();
+    bool Remap(unsigned long long size);
     std::string name_;
 
-    unsigned max_;
     unsigned windowSize_;
-    unsigned current_;
+    unsigned long long chunkSize_;
+    unsigned long long current_;
     void* fileHandle_;
-    unsigned regionBase_;
+    int fd_;
+    bool owner_;
+    unsigned long long regionBase_;
     void* regionHandle;
     unsigned char* regionStart;
 };
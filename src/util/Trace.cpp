@@ -0,0 +1,169 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#include "Trace.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#else
+#    include <process.h>
+#endif
+
+bool Trace::enabled;
+
+struct OpenSpan
+{
+    long long start;
+    const char* category;
+    const char* name;
+    std::string detail;
+};
+static std::string traceFile;
+static std::string events;
+static std::vector<OpenSpan> spans[Trace::TRACKS];
+static const char* trackNames[Trace::TRACKS] = {"compiler", "includes"};
+static int processId;
+
+enum
+{
+    FLUSH_SIZE = 1024 * 1024
+};
+static long long Now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+static void AddString(const char* str)
+{
+    events += '"';
+    for (; *str; str++)
+    {
+        unsigned char c = *str;
+        if (c == '"' || c == '\\')
+        {
+            events += '\\';
+            events += c;
+        }
+        else if (c < ' ')
+        {
+            char buf[8];
+            sprintf(buf, "\\u%04x", c);
+            events += buf;
+        }
+        else
+        {
+            events += c;
+        }
+    }
+    events += '"';
+}
+
+void Trace::Open(const std::string& fileName, const char* processName, bool create)
+{
+    if (enabled)
+        return;
+    traceFile = fileName;
+    processId = getpid();
+    FILE* fil = create ? nullptr : fopen(traceFile.c_str(), "rb");
+    if (fil)
+    {
+        fclose(fil);
+    }
+    else
+    {
+        fil = fopen(traceFile.c_str(), "wb");
+        if (!fil)
+            return;
+        fputs("[\n", fil);
+        fclose(fil);
+    }
+    enabled = true;
+    events += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + std::to_string(processId) + ",\"args\":{\"name\":";
+    AddString(processName);
+    events += "}},\n";
+    for (int i = 0; i < TRACKS; i++)
+    {
+        events += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + std::to_string(processId) +
+                  ",\"tid\":" + std::to_string(i + 1) + ",\"args\":{\"name\":";
+        AddString(trackNames[i]);
+        events += "}},\n";
+    }
+    atexit(Close);
+}
+void Trace::Close()
+{
+    if (!enabled)
+        return;
+    // spans still open when the process ends, e.g. because of a fatal error
+    for (int i = 0; i < TRACKS; i++)
+        while (!spans[i].empty())
+            End((Track)i);
+    Flush();
+    enabled = false;
+}
+void Trace::Begin(const char* category, const char* name, const char* detail, Track track)
+{
+    if (!enabled)
+        return;
+    spans[track].push_back(OpenSpan{Now(), category, name, detail ? detail : ""});
+}
+void Trace::End(Track track)
+{
+    if (spans[track].empty())
+        return;
+    OpenSpan& span = spans[track].back();
+    long long now = Now();
+    events += "{\"name\":";
+    AddString(span.name);
+    events += ",\"cat\":";
+    AddString(span.category);
+    events += ",\"ph\":\"X\",\"ts\":" + std::to_string(span.start) + ",\"dur\":" + std::to_string(now - span.start) +
+              ",\"pid\":" + std::to_string(processId) + ",\"tid\":" + std::to_string(track + 1);
+    if (!span.detail.empty())
+    {
+        events += ",\"args\":{\"detail\":";
+        AddString(span.detail.c_str());
+        events += "}";
+    }
+    events += "},\n";
+    spans[track].pop_back();
+    if (events.size() >= FLUSH_SIZE)
+        Flush();
+}
+// one unbuffered write per block, so blocks from processes running at the same time don't get mixed up
+void Trace::Flush()
+{
+    if (events.empty())
+        return;
+    FILE* fil = fopen(traceFile.c_str(), "ab");
+    if (fil)
+    {
+        setvbuf(fil, nullptr, _IONBF, 0);
+        fwrite(events.c_str(), 1, events.size(), fil);
+        fclose(fil);
+    }
+    events.clear();
+}
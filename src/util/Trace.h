@@ -0,0 +1,87 @@
+/* Software License Agreement
+ *
+ *     Copyright(C) 1994-2022 David Lindauer, (LADSoft)
+ *
+ *     This file is part of the Orange C Compiler package.
+ *
+ *     The Orange C Compiler package is free software: you can redistribute it and/or modify
+ *     it under the terms of the GNU General Public License as published by
+ *     the Free Software Foundation, either version 3 of the License, or
+ *     (at your option) any later version.
+ *
+ *     The Orange C Compiler package is distributed in the hope that it will be useful,
+ *     but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *     GNU General Public License for more details.
+ *
+ *     You should have received a copy of the GNU General Public License
+ *     along with Orange C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *     contact information:
+ *         email: TouchStone222@runbox.com <David Lindauer>
+ *
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <string>
+
+// writes a profile of the compiler in the Chrome trace event format, which chrome://tracing
+// and Perfetto can display.   Each process keeps the spans it has finished in memory and appends
+// them to the trace file a block at a time, so occ, occparse and occopt all add to the same file
+// and show up as separate processes on one timeline.   The file is a JSON array with no closing
+// bracket, the trace viewers accept that.
+class Trace
+{
+  public:
+    // spans are kept on separate tracks when they don't nest inside each other, e.g. an include
+    // file can start in one declaration and end in another
+    enum Track
+    {
+        MAIN,
+        INCLUDES,
+        TRACKS
+    };
+    // 'create' starts a new trace file; otherwise events are added to the file if it exists
+    static void Open(const std::string& fileName, const char* processName, bool create = false);
+    static void Close();
+    static bool Enabled() { return enabled; }
+
+    // spans on a track nest, End finishes the most recent one
+    static void Begin(const char* category, const char* name, const char* detail = nullptr, Track track = MAIN);
+    static void End(Track track = MAIN);
+
+  private:
+    static void Flush();
+    static bool enabled;
+};
+
+// a span which lasts until the end of the enclosing block.   Start does nothing when tracing
+// is off, so callers can check Trace::Enabled() before going to the trouble of making a detail
+class TraceSpan
+{
+  public:
+    TraceSpan() : active(false) {}
+    TraceSpan(const char* category, const char* name, const char* detail = nullptr) : active(false)
+    {
+        Start(category, name, detail);
+    }
+    ~TraceSpan()
+    {
+        if (active)
+            Trace::End();
+    }
+    void Start(const char* category, const char* name, const char* detail = nullptr)
+    {
+        if (Trace::Enabled() && !active)
+        {
+            Trace::Begin(category, name, detail);
+            active = true;
+        }
+    }
+
+  private:
+    bool active;
+};
+#endif
@@ -133,8 +133,12 @@ class Utils
         return std::string(intStr, sz);
     }
     static bool NamedPipe(int* fds, const std::string& name);
+    static int NamedPipeServer(const std::string& name);
+    static int NamedPipeAccept(int server);
     static bool PipeWrite(int fileno, const std::string& data);
     static std::string PipeRead(int fileno);
+    static bool PipeWriteHandles(int fileno, const int* handles, int count);
+    static bool PipeReadHandles(int fileno, int* handles, int count);
 
     static unsigned PartialCRC32(unsigned crc, const unsigned char* data, size_t len);
     static unsigned CRC32(const unsigned char* data, size_t len) { return PartialCRC32(0, data, len); };
@@ -0,0 +1,19 @@
+/* constant arrays are read into packed blocks when they can be, and the parser backs up when
+   an initializer turns out to need the general code.  Backing up must not lose the line
+   information for the code that follows */
+char str[] = {1, 2, 0};
+int mixed[] = {1, 2, 3 + 4, 5};
+int f(int a) { return a + mixed[1]; }
+short spread[] = {1,
+                  2,
+                  -3 * 2,
+                  4};
+int g(int a)
+{
+    int b = a + spread[2];
+    return b * 2;
+}
+int main()
+{
+    return f(1) + g(2);
+}
@@ -0,0 +1,42 @@
+/* n_paste.c:  ## operator with empty arguments and with the # operator.  */
+
+#include    "defs.h"
+
+#define glue( a, b)     a ## b
+#define xglue( a, b)    glue( a, b)
+#define glue3( a, b, c) a ## b ## c
+#define str( a)         # a
+#define xstr( a)        str( a)
+#define HIGH            glue( HI, GH)
+#define HIGH_LOW        "hl"
+
+main( void)
+{
+    int     ab = 3, a = 1, b = 2;
+
+    fputs( "started\n", stderr);
+
+/* paste.1:    An empty argument leaves the other operand alone.   */
+    assert( glue( a, ) == 1);
+    assert( glue( , b) == 2);
+    assert( glue3( a, , b) == 3);
+
+/* paste.2:    The operands aren't macro expanded before they are pasted.  */
+    assert( strcmp( xstr( glue( HIGH, _LOW)), "\"hl\"") == 0);
+
+/* paste.3:    Pasted operands are rescanned as one token. */
+    assert( strcmp( xstr( xglue( HIGH, LOW)), "HIGHLOW") == 0);
+
+/* paste.4:    # and ## in the same replacement list.  */
+#define hash_hash   # ## #
+#define mkstr( a)   # a
+#define in_between( a)  mkstr( a)
+#define join( c, d) in_between( c hash_hash d)
+    assert( strcmp( join( x, y), "x ## y") == 0);
+
+/* paste.5:    Numbers pasted into one preprocessing number.   */
+    assert( glue3( 1, 2, 3) == 123);
+
+    fputs( "success\n", stderr);
+    return  0;
+}
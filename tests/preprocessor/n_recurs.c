@@ -0,0 +1,36 @@
+/* n_recurs.c:  A macro isn't replaced again inside its own expansion.  */
+
+#include    "defs.h"
+
+main( void)
+{
+    int     x = 1, y = 2, z = 3, AA = 10;
+
+    fputs( "started\n", stderr);
+
+/* recurs.1:    Object-like macro which refers to itself.   */
+#define x       (4 + x)
+    assert( x == 5);
+#undef  x
+
+/* recurs.2:    Macros which refer to each other.   */
+#define y       z + y
+#define z       y * 2
+    assert( y == 2 * 2 + 2);
+#undef  y
+#undef  z
+
+/* recurs.3:    A function-like macro used in its own argument is replaced,
+        since the argument is expanded first.   */
+#define f( a)   ((a) * 2)
+    assert( f( f( 3)) == 12);
+
+/* recurs.4:    A function-like macro which comes back to itself through
+        another one leaves its name alone.  */
+#define AA( n)  BB( n) + 1
+#define BB( n)  AA
+    assert( AA( 1) == 11);
+
+    fputs( "success\n", stderr);
+    return  0;
+}
@@ -0,0 +1,35 @@
+/* n_strize.c:  # operator in macro definition.  */
+
+#include    "defs.h"
+
+#define str( a)     # a
+#define xstr( a)    str( a)
+#define NUM         123
+
+main( void)
+{
+    fputs( "started\n", stderr);
+
+/* strize.1:    White space between tokens becomes one space, leading and
+        trailing white space is dropped.    */
+    assert( strcmp( str(   a  +    b   ), "a + b") == 0);
+
+/* strize.2:    " and \ in string literals and character constants are
+        escaped.    */
+    assert( strcmp( str( "abc\n"), "\"abc\\n\"") == 0);
+    assert( strcmp( str( '"'), "'\"'") == 0);
+
+/* strize.3:    The argument isn't macro expanded before it is stringized,
+        unless it goes through another macro first.  */
+    assert( strcmp( str( NUM), "NUM") == 0);
+    assert( strcmp( xstr( NUM), "123") == 0);
+
+/* strize.4:    An empty argument gives an empty string.    */
+    assert( strcmp( str(), "") == 0);
+
+/* strize.5:    Parentheses and commas inside them are part of the argument. */
+    assert( strcmp( str( f( x, y)), "f( x, y)") == 0);
+
+    fputs( "success\n", stderr);
+    return  0;
+}
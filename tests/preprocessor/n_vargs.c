@@ -0,0 +1,38 @@
+/* n_vargs.c:  Macros with variable arguments.  */
+
+#include    "defs.h"
+
+#define debug( ...)         fprintf( stderr, __VA_ARGS__)
+#define showlist( ...)      # __VA_ARGS__
+#define report( test, ...)  ((test) ? strlen( # test) : sprintf( buf, __VA_ARGS__))
+#define count( ...)         count_( __VA_ARGS__, 3, 2, 1, 0)
+#define count_( a, b, c, n, ...)    n
+#define first( a, ...)      a
+
+main( void)
+{
+    int     x = 1, y = 2;
+    char    buf[ 16];
+
+    fputs( "started\n", stderr);
+
+/* vargs.1:    The variable arguments are passed on with their commas.  */
+    debug( "%s", "");
+    assert( count( a, b, c) == 3);
+    assert( count( a) == 1);
+
+/* vargs.2:    # __VA_ARGS__ stringizes all the variable arguments.    */
+    assert( strcmp( showlist( The first, second, and third items.),
+            "The first, second, and third items.") == 0);
+
+/* vargs.3:    Named parameter followed by variable arguments.  */
+    assert( report( x < y, "%d%d", x, y) == 5);
+    assert( report( x > y, "%d%d", x, y) == 2);
+
+/* vargs.4:    Variable arguments may be left out entirely.    */
+    assert( first( 5) == 5);
+    assert( first( 5,) == 5);
+
+    fputs( "success\n", stderr);
+    return  0;
+}
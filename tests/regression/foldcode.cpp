@@ -0,0 +1,28 @@
+#include <stdio.h>
+
+template <class T>
+T sum(T n)
+{
+    T rv = 0;
+    for (T i = 0; i < n; i++)
+        rv += i;
+    return rv;
+}
+template <class T>
+T count(T n)
+{
+    T rv = 0;
+    for (T i = 0; i < n; i++)
+        rv++;
+    return rv;
+}
+typedef int (*ifunc)(int);
+typedef long (*lfunc)(long);
+
+int main()
+{
+    ifunc a = count<int>;
+    lfunc b = count<long>;
+    printf("%d %ld %d %ld %d\n", sum<int>(4), sum<long>(5), a(6), b(7), (void*)a != (void*)b);
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <string.h>
+
+/* constant arrays of literals are stored as one packed block of bytes, check the values come out
+   the same as they would element by element */
+signed char sc[] = {1, -1, 127, -128, 0};
+unsigned char uc[] = {0, 1, 200, 255};
+char pc[] = {'a', 'b', 0, 'c'};
+short ss[] = {-1, 32767, -32768, 1000};
+unsigned short us[] = {0, 65535, 40000};
+int si[] = {-1, 2147483647, -2147483648, 123456};
+unsigned ui[] = {0, 4294967295, 3000000000};
+long long sll[] = {-1, 9223372036854775807, -5000000000};
+unsigned long long ull[] = {0, 9223372036854775807, 10000000000};
+float fl[] = {0.5, -1.25, 3, 0.375, -0.0, 16777215, -65504};
+double db[] = {0.5, -1.25, 3, 0.1, -0.0, 1e300, 9007199254740991};
+
+/* the rest of a partly initialized array is zero */
+int pad[8] = {1, -2, 3};
+short spad[6] = {-7};
+double dpad[4] = {2.5};
+
+/* these fall back to the general code */
+int mixed[] = {1, 2, 3 + 4, -5};
+unsigned suffixed[] = {1u, 4294967295u};
+float conv[] = {1, 2.5, 16777217};
+
+int fbits(float f)
+{
+    unsigned v;
+    memcpy(&v, &f, sizeof(v));
+    return printf(" %08x", v);
+}
+int dbits(double d)
+{
+    unsigned long long v;
+    memcpy(&v, &d, sizeof(v));
+    return printf(" %016llx", v);
+}
+int main()
+{
+    static short local[] = {3, -3, 300};
+    int i;
+    printf("sc %d:", (int)sizeof(sc));
+    for (i = 0; i < sizeof(sc) / sizeof(sc[0]); i++)
+        printf(" %d", sc[i]);
+    printf("\nuc %d:", (int)sizeof(uc));
+    for (i = 0; i < sizeof(uc) / sizeof(uc[0]); i++)
+        printf(" %d", uc[i]);
+    printf("\npc %d:", (int)sizeof(pc));
+    for (i = 0; i < sizeof(pc) / sizeof(pc[0]); i++)
+        printf(" %d", pc[i]);
+    printf("\nss %d:", (int)sizeof(ss));
+    for (i = 0; i < sizeof(ss) / sizeof(ss[0]); i++)
+        printf(" %d", ss[i]);
+    printf("\nus %d:", (int)sizeof(us));
+    for (i = 0; i < sizeof(us) / sizeof(us[0]); i++)
+        printf(" %u", us[i]);
+    printf("\nsi %d:", (int)sizeof(si));
+    for (i = 0; i < sizeof(si) / sizeof(si[0]); i++)
+        printf(" %d", si[i]);
+    printf("\nui %d:", (int)sizeof(ui));
+    for (i = 0; i < sizeof(ui) / sizeof(ui[0]); i++)
+        printf(" %u", ui[i]);
+    printf("\nsll %d:", (int)sizeof(sll));
+    for (i = 0; i < sizeof(sll) / sizeof(sll[0]); i++)
+        printf(" %lld", sll[i]);
+    printf("\null %d:", (int)sizeof(ull));
+    for (i = 0; i < sizeof(ull) / sizeof(ull[0]); i++)
+        printf(" %llu", ull[i]);
+    printf("\nfl %d:", (int)sizeof(fl));
+    for (i = 0; i < sizeof(fl) / sizeof(fl[0]); i++)
+        fbits(fl[i]);
+    printf("\ndb %d:", (int)sizeof(db));
+    for (i = 0; i < sizeof(db) / sizeof(db[0]); i++)
+        dbits(db[i]);
+    printf("\npad %d:", (int)sizeof(pad));
+    for (i = 0; i < sizeof(pad) / sizeof(pad[0]); i++)
+        printf(" %d", pad[i]);
+    printf("\nspad %d:", (int)sizeof(spad));
+    for (i = 0; i < sizeof(spad) / sizeof(spad[0]); i++)
+        printf(" %d", spad[i]);
+    printf("\ndpad %d:", (int)sizeof(dpad));
+    for (i = 0; i < sizeof(dpad) / sizeof(dpad[0]); i++)
+        dbits(dpad[i]);
+    printf("\nmixed %d:", (int)sizeof(mixed));
+    for (i = 0; i < sizeof(mixed) / sizeof(mixed[0]); i++)
+        printf(" %d", mixed[i]);
+    printf("\nsuffixed %d:", (int)sizeof(suffixed));
+    for (i = 0; i < sizeof(suffixed) / sizeof(suffixed[0]); i++)
+        printf(" %u", suffixed[i]);
+    printf("\nconv %d:", (int)sizeof(conv));
+    for (i = 0; i < sizeof(conv) / sizeof(conv[0]); i++)
+        fbits(conv[i]);
+    printf("\nlocal %d:", (int)sizeof(local));
+    for (i = 0; i < sizeof(local) / sizeof(local[0]); i++)
+        printf(" %d", local[i]);
+    printf("\n");
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include <stdio.h>
+
+int a[1000], b[1000], c[1000];
+unsigned char ca[1000], cb[1000], cc[1000];
+short sa[1000], sb[1000], sc[1000];
+double da[1000], db[1000], dc[1000];
+float fa[1000], fb[1000], fc[1000];
+long long la[1000], lb[1000], lc[1000];
+
+void add(int n)
+{
+    for (int i = 0; i < n; i++)
+        a[i] = b[i] + c[i];
+}
+void subfrom(int s, int n)
+{
+    for (int i = s; i < n; i++)
+        a[i] = b[i] - c[i];
+}
+void addrestrict(int* restrict x, int* restrict y, int* restrict z, int n)
+{
+    for (int i = 0; i < n; i++)
+        x[i] = y[i] + z[i];
+}
+void addoverlap(int* x, int* y, int* z, int n)
+{
+    for (int i = 0; i < n; i++)
+        x[i] = y[i] + z[i];
+}
+void inplace(int n)
+{
+    for (int i = 0; i < n; i++)
+        a[i] = a[i] ^ b[i];
+}
+void charadd(int n)
+{
+    for (int i = 0; i < n; i++)
+        ca[i] = cb[i] + cc[i];
+}
+void shortadd(int n)
+{
+    for (int i = 0; i < n; i++)
+        sa[i] = sb[i] + sc[i];
+}
+void doublemul(int n)
+{
+    for (int i = 0; i < n; i++)
+        da[i] = db[i] * dc[i];
+}
+void floatdiv(int n)
+{
+    for (int i = 0; i < n; i++)
+        fa[i] = fb[i] / fc[i];
+}
+void longsub(int n)
+{
+    for (int i = 0; i < n; i++)
+        la[i] = lb[i] - lc[i];
+}
+void copy(int n)
+{
+    for (int i = 0; i < n; i++)
+        a[i] = c[i];
+}
+void fixed(void)
+{
+    for (int i = 0; i < 103; i++)
+        a[i] = b[i] & c[i];
+}
+
+void init(void)
+{
+    for (int i = 0; i < 1000; i++)
+    {
+        a[i] = -7;
+        b[i] = i * 3 + 1;
+        c[i] = 1000 - i * 7;
+        ca[i] = 0x55;
+        cb[i] = i * 5;
+        cc[i] = 200 + i;
+        sa[i] = 9;
+        sb[i] = i * 300;
+        sc[i] = 12345 - i;
+        da[i] = -1;
+        db[i] = i * 0.5 + 1;
+        dc[i] = 3.25 - i;
+        fa[i] = -1;
+        fb[i] = i * 1.5f + 2;
+        fc[i] = 0.75f + i;
+        la[i] = 5;
+        lb[i] = (long long)i << 33;
+        lc[i] = i * 12345;
+    }
+}
+unsigned sum(void)
+{
+    unsigned rv = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        rv = rv * 31 + a[i];
+        rv = rv * 31 + ca[i];
+        rv = rv * 31 + sa[i];
+        rv = rv * 31 + (int)(da[i] * 16);
+        rv = rv * 31 + (int)(fa[i] * 1024);
+        rv = rv * 31 + (unsigned)la[i] + (unsigned)(la[i] >> 32);
+    }
+    return rv;
+}
+int main()
+{
+    static int counts[] = {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 100, 997, 1000};
+    for (int i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+        int n = counts[i];
+        init();
+        add(n);
+        printf("%d add %08x\n", n, sum());
+        init();
+        subfrom(3, n);
+        printf("%d subfrom %08x\n", n, sum());
+        init();
+        addrestrict(a + 1, b, c + 2, n > 990 ? 990 : n);
+        printf("%d addrestrict %08x\n", n, sum());
+        init();
+        addoverlap(b + 1, b, c, n == 1000 ? 999 : n);
+        printf("%d addoverlap %08x %d\n", n, sum(), b[n == 1000 ? 999 : n]);
+        init();
+        inplace(n);
+        printf("%d inplace %08x\n", n, sum());
+        init();
+        charadd(n);
+        printf("%d charadd %08x\n", n, sum());
+        init();
+        shortadd(n);
+        printf("%d shortadd %08x\n", n, sum());
+        init();
+        doublemul(n);
+        printf("%d doublemul %08x\n", n, sum());
+        init();
+        floatdiv(n);
+        printf("%d floatdiv %08x\n", n, sum());
+        init();
+        longsub(n);
+        printf("%d longsub %08x\n", n, sum());
+        init();
+        copy(n);
+        printf("%d copy %08x\n", n, sum());
+    }
+    init();
+    fixed();
+    printf("fixed %08x\n", sum());
+    return 0;
+}
@@ -0,0 +1,55 @@
+/* Generates big.c, a very large translation unit used to stress the paths between
+   occparse, occopt and the back end.   The intermediate code for the default
+   settings runs to hundreds of megabytes, well past the old fixed size of the
+   shared region.
+   
+   usage: genbig [functions [statements [padding]]] > big.c
+
+   every function runs a series of unsigned multiply/add/xor steps over its
+   argument.   The generator does the same arithmetic and writes the expected
+   result into the program, which returns 0 if the compiled code agrees.
+   'padding' is the number of bytes of comment written ahead of each function,
+   to make the source file itself large.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+static unsigned mult(unsigned f, unsigned s) { return 1103515245u + 2 * ((f * 31u + s) & 0xffff); }
+static unsigned add(unsigned f, unsigned s) { return 12345u + f * 7u + s; }
+static unsigned shift(unsigned f, unsigned s) { return 1 + (f + s) % 23; }
+
+int main(int argc, char** argv)
+{
+    unsigned functions = argc > 1 ? strtoul(argv[1], 0, 0) : 20000;
+    unsigned statements = argc > 2 ? strtoul(argv[2], 0, 0) : 200;
+    unsigned long padding = argc > 3 ? strtoul(argv[3], 0, 0) : 100000;
+    unsigned value = 1;
+    unsigned f, s;
+    unsigned long p;
+    for (f = 0; f < functions; f++)
+    {
+        printf("/*");
+        for (p = 0; p < padding; p++)
+            putchar(p % 80 == 79 ? '\n' : 'a' + p % 26);
+        printf("*/\n");
+        printf("static unsigned f%u(unsigned x)\n{\n", f);
+        for (s = 0; s < statements; s++)
+        {
+            printf("    x = x * %uu + %uu;\n", mult(f, s), add(f, s));
+            printf("    x ^= x >> %u;\n", shift(f, s));
+            value = value * mult(f, s) + add(f, s);
+            value ^= value >> shift(f, s);
+        }
+        printf("    return x;\n}\n");
+    }
+    printf("static unsigned (*table[])(unsigned) = {\n");
+    for (f = 0; f < functions; f++)
+        printf("    f%u,\n", f);
+    printf("};\n");
+    printf("int main(void)\n{\n");
+    printf("    unsigned i, x = 1;\n");
+    printf("    for (i = 0; i < sizeof(table) / sizeof(table[0]); i++)\n");
+    printf("        x = table[i](x);\n");
+    printf("    return x != %uu;\n}\n", value);
+    return 0;
+}
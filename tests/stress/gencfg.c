@@ -0,0 +1,83 @@
+/* Generates cfg.c, a program whose functions have very large flow graphs, used to
+   stress SSA construction and destruction in occopt.
+
+   usage: gencfg [diamonds [states [steps]]] > cfg.c
+
+   chain() is a run of 'diamonds' if/else statements on two variables, so both
+   need a phi at every join and the dominator tree is as deep as the function
+   is long.   machine() is a state machine with 'states' cases in a switch inside
+   a loop, which gives one block with a huge number of successors and a loop
+   header with a huge number of predecessors; it runs for 'steps' iterations.
+   The generator does the same arithmetic and writes the expected results into
+   the program, which returns 0 if the compiled code agrees.
+
+   The optimizer keeps a live set per block and a conflict matrix over all the
+   temps, so its memory goes up with the square of the function size; the
+   defaults need a bit over a gigabyte to compile.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+static unsigned mult(unsigned f, unsigned s) { return 1103515245u + 2 * ((f * 31u + s) & 0xffff); }
+static unsigned add(unsigned f, unsigned s) { return 12345u + f * 7u + s; }
+static unsigned shift(unsigned f, unsigned s) { return 1 + (f + s) % 23; }
+
+int main(int argc, char** argv)
+{
+    unsigned diamonds = argc > 1 ? strtoul(argv[1], 0, 0) : 2500;
+    unsigned states = argc > 2 ? strtoul(argv[2], 0, 0) : 2500;
+    unsigned steps = argc > 3 ? strtoul(argv[3], 0, 0) : 100000;
+    unsigned x = 1, y = 0, state = 0;
+    unsigned d, n;
+
+    printf("static unsigned chain(unsigned x)\n{\n    unsigned y = 0;\n");
+    for (d = 0; d < diamonds; d++)
+    {
+        unsigned mask = 1u << (d % 7);
+        printf("    if (x & %uu)\n    {\n        x = x * %uu + %uu;\n        y ^= x;\n    }\n", mask, mult(d, 0), add(d, 0));
+        printf("    else\n    {\n        y += x >> %u;\n        x ^= y;\n    }\n", shift(d, 0));
+        if (x & mask)
+        {
+            x = x * mult(d, 0) + add(d, 0);
+            y ^= x;
+        }
+        else
+        {
+            y += x >> shift(d, 0);
+            x ^= y;
+        }
+    }
+    printf("    return x + y;\n}\n");
+    x += y;
+
+    printf("static unsigned machine(unsigned x)\n{\n    unsigned state = 0, n;\n");
+    printf("    for (n = 0; n < %uu; n++)\n        switch (state)\n        {\n", steps);
+    for (d = 0; d < states; d++)
+    {
+        printf("            case %u:\n", d);
+        printf("                if (x & 1)\n                {\n");
+        printf("                    x = x * %uu + %uu;\n                    state = %u;\n", mult(d, 1), add(d, 1),
+               (d * 7 + 1) % states);
+        printf("                }\n                else\n                {\n");
+        printf("                    x ^= x >> %u;\n                    state = %u;\n", shift(d, 1), (d * 13 + 5) % states);
+        printf("                }\n                break;\n");
+    }
+    printf("        }\n    return x;\n}\n");
+    for (n = 0; n < steps; n++)
+    {
+        if (x & 1)
+        {
+            x = x * mult(state, 1) + add(state, 1);
+            state = (state * 7 + 1) % states;
+        }
+        else
+        {
+            x ^= x >> shift(state, 1);
+            state = (state * 13 + 5) % states;
+        }
+    }
+
+    printf("int main(void)\n{\n");
+    printf("    return machine(chain(1)) != %uu;\n}\n", x);
+    return 0;
+}